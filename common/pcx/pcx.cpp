@@ -14,8 +14,167 @@ Copyright 2010-2013 Rodrigo Hernandez Cordoba
    limitations under the License.
 ******************************************************************************/
 #include "pcx.h"
+#include "aeongui/MappedFile.h"
 #include <iostream>
 #include <fstream>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+#define PCX_SSE2
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define PCX_NEON
+#include <arm_neon.h>
+#endif
+
+// Longest run a single RLE count byte can hold.
+static const uint32_t MaxRunLength = 63;
+
+#if defined(PCX_SSE2)
+static uint32_t CountTrailingZeros ( uint32_t value )
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward ( &index, value );
+    return index;
+#else
+    return __builtin_ctz ( value );
+#endif
+}
+#endif
+
+// Length of the run of bytes equal to the first one, up to limit.
+static uint32_t RunLength ( const uint8_t* bytes, uint32_t limit )
+{
+    uint32_t length = 1;
+#if defined(PCX_SSE2)
+    const __m128i value = _mm_set1_epi8 ( static_cast<char> ( bytes[0] ) );
+    while ( length + 16 <= limit )
+    {
+        uint32_t mask = _mm_movemask_epi8 ( _mm_cmpeq_epi8 ( _mm_loadu_si128 ( reinterpret_cast<const __m128i*> ( bytes + length ) ), value ) );
+        if ( mask != 0xFFFF )
+        {
+            return length + CountTrailingZeros ( ~mask );
+        }
+        length += 16;
+    }
+#endif
+    while ( ( length < limit ) && ( bytes[length] == bytes[0] ) )
+    {
+        ++length;
+    }
+    return length;
+}
+
+// RLE encodes a scanline, when encoded is NULL only the encoded size is computed.
+static uint32_t EncodeScanline ( const uint8_t* scanline, uint32_t length, uint8_t* encoded )
+{
+    uint32_t size = 0;
+    for ( uint32_t x = 0; x < length; )
+    {
+        uint32_t remaining = length - x;
+        uint32_t count = RunLength ( scanline + x, ( remaining < MaxRunLength ) ? remaining : MaxRunLength );
+        uint8_t byte = scanline[x];
+        if ( ( count == 1 ) && ( ( byte & 0xC0 ) != 0xC0 ) )
+        {
+            // Single bytes that can't be mistaken for a count are stored as is.
+            if ( encoded != NULL )
+            {
+                encoded[size] = byte;
+            }
+            size += 1;
+        }
+        else
+        {
+            if ( encoded != NULL )
+            {
+                encoded[size] = static_cast<uint8_t> ( count | 0xC0 );
+                encoded[size + 1] = byte;
+            }
+            size += 2;
+        }
+        x += count;
+    }
+    return size;
+}
+
+// Expands one RLE scanline, returns the input position past it or NULL if the data ends early.
+static const uint8_t* DecodeScanline ( const uint8_t* byte, const uint8_t* end, uint8_t* scanline, uint32_t length )
+{
+    for ( uint32_t k = 0; k < length; )
+    {
+        if ( byte >= end )
+        {
+            return NULL;
+        }
+        if ( ( byte[0] & 0xC0 ) == 0xC0 )
+        {
+            if ( byte + 1 >= end )
+            {
+                return NULL;
+            }
+            uint32_t count = byte[0] & 0x3F;
+            // Runs may not cross the scanline end.
+            if ( count > length - k )
+            {
+                count = length - k;
+            }
+            memset ( scanline + k, byte[1], count );
+            k += count;
+            byte += 2;
+        }
+        else
+        {
+            scanline[k++] = *byte++;
+        }
+    }
+    return byte;
+}
+
+// Interleaves separate color planes into BGRA, alpha may be NULL for opaque images.
+static void PlanarToBGRA ( const uint8_t* red, const uint8_t* green, const uint8_t* blue, const uint8_t* alpha, uint8_t* bgra, uint32_t width )
+{
+    uint32_t x = 0;
+#if defined(PCX_SSE2)
+    const __m128i opaque = _mm_set1_epi8 ( static_cast<char> ( 0xFF ) );
+    for ( ; x + 16 <= width; x += 16 )
+    {
+        __m128i r = _mm_loadu_si128 ( reinterpret_cast<const __m128i*> ( red + x ) );
+        __m128i g = _mm_loadu_si128 ( reinterpret_cast<const __m128i*> ( green + x ) );
+        __m128i b = _mm_loadu_si128 ( reinterpret_cast<const __m128i*> ( blue + x ) );
+        __m128i a = ( alpha != NULL ) ? _mm_loadu_si128 ( reinterpret_cast<const __m128i*> ( alpha + x ) ) : opaque;
+        __m128i bg_low = _mm_unpacklo_epi8 ( b, g );
+        __m128i bg_high = _mm_unpackhi_epi8 ( b, g );
+        __m128i ra_low = _mm_unpacklo_epi8 ( r, a );
+        __m128i ra_high = _mm_unpackhi_epi8 ( r, a );
+        __m128i* destination = reinterpret_cast<__m128i*> ( bgra + ( x * 4 ) );
+        _mm_storeu_si128 ( destination + 0, _mm_unpacklo_epi16 ( bg_low, ra_low ) );
+        _mm_storeu_si128 ( destination + 1, _mm_unpackhi_epi16 ( bg_low, ra_low ) );
+        _mm_storeu_si128 ( destination + 2, _mm_unpacklo_epi16 ( bg_high, ra_high ) );
+        _mm_storeu_si128 ( destination + 3, _mm_unpackhi_epi16 ( bg_high, ra_high ) );
+    }
+#elif defined(PCX_NEON)
+    for ( ; x + 16 <= width; x += 16 )
+    {
+        uint8x16x4_t pixels;
+        pixels.val[0] = vld1q_u8 ( blue + x );
+        pixels.val[1] = vld1q_u8 ( green + x );
+        pixels.val[2] = vld1q_u8 ( red + x );
+        pixels.val[3] = ( alpha != NULL ) ? vld1q_u8 ( alpha + x ) : vdupq_n_u8 ( 0xFF );
+        vst4q_u8 ( bgra + ( x * 4 ), pixels );
+    }
+#endif
+    for ( ; x < width; ++x )
+    {
+        bgra[ ( x * 4 ) + 0] = blue[x];
+        bgra[ ( x * 4 ) + 1] = green[x];
+        bgra[ ( x * 4 ) + 2] = red[x];
+        bgra[ ( x * 4 ) + 3] = ( alpha != NULL ) ? alpha[x] : 0xFF;
+    }
+}
 
 Pcx::Pcx() :
     pixels ( NULL ),
@@ -52,55 +211,22 @@ bool Pcx::Encode ( uint32_t width, uint32_t height, void* buffer, uint32_t buffe
 
 uint32_t Pcx::PadPixels ( uint32_t width, uint32_t height, void* buffer, uint32_t buffer_size )
 {
-    // This function is untested
+    // Each source scanline is written once per color plane.
     uint32_t datasize = 0;
-    uint8_t counter = 0;
-    uint8_t* scanline = ( uint8_t* ) buffer;
-    uint8_t* encoded_pixel = ( uint8_t* ) pixels;
-    uint8_t* encoded_scanline = new uint8_t[width * 2]; // worst case scenario all bytes are different
-    uint32_t scanline_count = 0;
-    uint8_t byte;
-
+    const uint8_t* scanline = reinterpret_cast<const uint8_t*> ( buffer );
     for ( uint32_t y = 0; y < height; ++y )
     {
-        byte = scanline[0];
-        counter = 1;
-        scanline_count = 0;
-        for ( uint32_t x = 1; x < width; ++x )
-        {
-            if ( ( byte == scanline[x] ) && ( counter < 63 ) )
-            {
-                counter++;
-            }
-            else
-            {
-                if ( encoded_pixel != NULL )
-                {
-                    encoded_scanline[scanline_count++] = counter | 0xC0;
-                    encoded_scanline[scanline_count++] = byte;
-                }
-                datasize += 2;
-                byte = scanline[x];
-                counter = 1;
-            }
-        }
-        // we're done a scanline, write the remnant and advance to the next.
-        if ( encoded_pixel != NULL )
+        uint8_t* encoded_scanline = ( pixels != NULL ) ? pixels + datasize : NULL;
+        uint32_t scanline_size = EncodeScanline ( scanline, width, encoded_scanline );
+        if ( encoded_scanline != NULL )
         {
-            encoded_scanline[scanline_count++] = counter | 0xC0;
-            encoded_scanline[scanline_count++] = byte;
-            memcpy ( encoded_pixel, encoded_scanline, scanline_count );
-            encoded_pixel += scanline_count;
-            memcpy ( encoded_pixel, encoded_scanline, scanline_count );
-            encoded_pixel += scanline_count;
-            memcpy ( encoded_pixel, encoded_scanline, scanline_count );
-            encoded_pixel += scanline_count;
+            memcpy ( encoded_scanline + scanline_size, encoded_scanline, scanline_size );
+            memcpy ( encoded_scanline + ( scanline_size * 2 ), encoded_scanline, scanline_size );
         }
-        datasize += 2;
+        datasize += scanline_size * 3;
         scanline += width;
     }
-    delete[] encoded_scanline;
-    return datasize * 3;
+    return datasize;
 }
 
 bool Pcx::Save ( const char* filename )
@@ -198,74 +324,117 @@ uint16_t Pcx::GetPadHeight()
     return header.YPadEnd - header.YPadStart;
 }
 
-bool Pcx::Decode ( uint32_t buffer_size, void* buffer )
+bool Pcx::DecodeHeader ( uint32_t buffer_size, const void* buffer )
 {
+    if ( buffer_size < sizeof ( Header ) )
+    {
+        return false;
+    }
     memcpy ( &header, buffer, sizeof ( Header ) );
-    if ( ( header.Version != 5 ) && ( header.Encoding != 1 ) && ( header.BitsPerPixel != 8 ) )
+    // Only version 5, 8 bit RLE encoded RGB and RGBA planes are supported.
+    if ( ( header.Identifier != 0x0A ) || ( header.Version != 5 ) || ( header.Encoding != 1 ) || ( header.BitsPerPixel != 8 ) ||
+         ( ( header.NumBitPlanes != 3 ) && ( header.NumBitPlanes != 4 ) ) ||
+         ( header.XEnd < header.XStart ) || ( header.YEnd < header.YStart ) || ( header.BytesPerLine < GetWidth() ) )
+    {
+        memset ( &header, 0, sizeof ( Header ) );
+        return false;
+    }
+    /*  A run expands 2 bytes into at most 63, so the data can never decode into more than
+        32 bytes per encoded byte. Larger dimensions are rejected before anything is allocated
+        for them, a tiny file can not claim a 65536x65536 image. */
+    const uint64_t decoded_size = static_cast<uint64_t> ( header.NumBitPlanes ) * header.BytesPerLine * GetHeight();
+    if ( decoded_size > static_cast<uint64_t> ( buffer_size - sizeof ( Header ) ) * 32 ||
+         static_cast<uint64_t> ( GetWidth() ) * GetHeight() * 4 > SIZE_MAX )
+    {
+        memset ( &header, 0, sizeof ( Header ) );
+        return false;
+    }
+    return true;
+}
+
+bool Pcx::Decode ( uint32_t buffer_size, const void* buffer )
+{
+    Unload();
+    if ( !DecodeHeader ( buffer_size, buffer ) )
     {
-        // Support only file format version 5 for now.
-        Unload();
         return false;
     }
 
-    uint32_t scanline_length = header.NumBitPlanes * header.BytesPerLine;
-    uint8_t* byte = reinterpret_cast<uint8_t*> ( buffer ) + sizeof ( Header );
-    pixels = new uint8_t[ scanline_length * GetHeight() ];
+    const uint32_t width = GetWidth();
+    const uint32_t scanline_length = header.NumBitPlanes * header.BytesPerLine;
+    const uint8_t* byte = reinterpret_cast<const uint8_t*> ( buffer ) + sizeof ( Header );
+    const uint8_t* end = reinterpret_cast<const uint8_t*> ( buffer ) + buffer_size;
+    std::vector<uint8_t> scanline ( scanline_length );
+    // Rows are tightly packed, BytesPerLine may include padding.
+    pixels_size = static_cast<size_t> ( width ) * header.NumBitPlanes * GetHeight();
+    pixels = new uint8_t[ pixels_size ];
 
     for ( uint32_t i = 0; i < GetHeight(); ++i )
     {
-        for ( uint8_t j = 0; j < header.NumBitPlanes; ++j )
+        if ( ( byte = DecodeScanline ( byte, end, scanline.data(), scanline_length ) ) == NULL )
         {
-            uint8_t* pixel = pixels + ( scanline_length * i ) + j;
-            for ( uint16_t k = 0; k < header.BytesPerLine; )
+            Unload();
+            return false;
+        }
+        // Interleave planes keeping the source RGB(A) order.
+        uint8_t* pixel = pixels + ( static_cast<size_t> ( width ) * header.NumBitPlanes * i );
+        for ( uint32_t k = 0; k < width; ++k )
+        {
+            for ( uint8_t j = 0; j < header.NumBitPlanes; ++j )
             {
-                if ( ( byte[0] & 0xC0 ) == 0xC0 )
-                {
-                    uint8_t count = byte[0] & 0x3F;
-                    for ( uint8_t l = 0; l < count; ++l )
-                    {
-                        *pixel = byte[1];
-                        pixel += header.NumBitPlanes;
-                    }
-                    byte += 2;
-                    k += count;
-                }
-                else
-                {
-                    *pixel = byte[0];
-                    pixel += header.NumBitPlanes;
-                    ++byte;
-                    ++k;
-                }
+                *pixel++ = scanline[ ( j * header.BytesPerLine ) + k];
             }
         }
     }
     return true;
 }
 
-bool Pcx::Load ( const char* filename )
+bool Pcx::DecodeRows ( uint32_t buffer_size, const void* buffer, RowCallback callback, void* user_data )
 {
-    uint8_t* buffer = NULL;
-    uint32_t buffer_size = 0;
-    bool retval;
-    std::ifstream pcx;
-    pcx.open ( filename, std::ios_base::in | std::ios_base::binary );
-    if ( !pcx.is_open() )
+    if ( !DecodeHeader ( buffer_size, buffer ) )
     {
-        std::cerr << "Problem opening " << filename << " for reading." << std::endl;
         return false;
     }
 
-    pcx.seekg ( 0, std::ios_base::end );
-    buffer_size = static_cast<uint32_t> ( pcx.tellg() );
-    pcx.seekg ( 0, std::ios_base::beg );
-    buffer = new uint8_t[buffer_size];
-    pcx.read ( reinterpret_cast<char*> ( buffer ), buffer_size );
-    pcx.close();
+    const uint32_t width = GetWidth();
+    const uint32_t scanline_length = header.NumBitPlanes * header.BytesPerLine;
+    const uint8_t* byte = reinterpret_cast<const uint8_t*> ( buffer ) + sizeof ( Header );
+    const uint8_t* end = reinterpret_cast<const uint8_t*> ( buffer ) + buffer_size;
+    // A single planar scanline and a single BGRA row are reused for the whole image.
+    std::vector<uint8_t> scanline ( scanline_length );
+    std::vector<uint8_t> row ( width * 4 );
+    const uint8_t* red = scanline.data();
+    const uint8_t* green = red + header.BytesPerLine;
+    const uint8_t* blue = green + header.BytesPerLine;
+    const uint8_t* alpha = ( header.NumBitPlanes == 4 ) ? blue + header.BytesPerLine : NULL;
 
-    retval = Decode ( buffer_size, buffer );
-    delete[] buffer;
-    return retval;
+    for ( uint32_t i = 0; i < GetHeight(); ++i )
+    {
+        if ( ( byte = DecodeScanline ( byte, end, scanline.data(), scanline_length ) ) == NULL )
+        {
+            return false;
+        }
+        PlanarToBGRA ( red, green, blue, alpha, row.data(), width );
+        callback ( i, row.data(), width, user_data );
+    }
+    return true;
+}
+
+bool Pcx::Load ( const char* filename )
+{
+    // Scanlines are decoded straight from the mapping, the file is never copied into memory.
+    AeonGUI::MappedFile file;
+    if ( !file.Open ( filename ) )
+    {
+        std::cerr << "Problem opening " << filename << " for reading." << std::endl;
+        return false;
+    }
+    if ( file.GetSize() > UINT32_MAX )
+    {
+        std::cerr << filename << " is too large to be a PCX file." << std::endl;
+        return false;
+    }
+    return Decode ( static_cast<uint32_t> ( file.GetSize() ), file.GetData() );
 }
 
 void Pcx::Unload ( )
@@ -20,11 +20,18 @@ Copyright (C) 2010-2012,2019 Rodrigo Hernandez Cordoba
 class Pcx
 {
 public:
+    /** Receives one decoded scanline as interleaved BGRA bytes,
+        alpha is 255 for 3 plane images. The row buffer is reused for the next scanline. */
+    typedef void ( *RowCallback ) ( uint32_t row, const uint8_t* bgra, uint32_t width, void* user_data );
     Pcx();
     ~Pcx();
     bool Encode ( uint32_t width, uint32_t height, void* buffer, uint32_t buffer_size );
     bool Save ( const char* filename );
-    bool Decode ( uint32_t buffer_size, void* buffer );
+    bool Decode ( uint32_t buffer_size, const void* buffer );
+    /** Reads and validates the header only, so callers can size their destination before DecodeRows. */
+    bool DecodeHeader ( uint32_t buffer_size, const void* buffer );
+    /** Streams the image one scanline at a time without keeping a decoded copy. */
+    bool DecodeRows ( uint32_t buffer_size, const void* buffer, RowCallback callback, void* user_data );
     bool Load ( const char* filename );
     void Unload ( );
     uint32_t GetWidth();
@@ -76,6 +83,6 @@ private:
     };
     Header header;
     uint8_t* pixels;
-    uint32_t pixels_size;
+    size_t pixels_size;
 };
 #endif
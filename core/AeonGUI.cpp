@@ -16,28 +16,40 @@ limitations under the License.
 
 #include <memory>
 #include "aeongui/AeonGUI.h"
+#ifdef AEONGUI_USE_V8
 #include "libplatform/libplatform.h"
 #include "v8.h"
+#include "JsV8Globals.h"
+#endif
 
 namespace AeonGUI
 {
+#ifdef AEONGUI_USE_V8
     static std::unique_ptr<v8::Platform> gPlatform{};
+
+    v8::Platform* GetV8Platform()
+    {
+        return gPlatform.get();
+    }
+#endif
     bool Initialize ( int argc = 0, char *argv[] = nullptr )
     {
-        /** @todo Provide a plugin loading mechanism,
-         *  so different JavaScript engines can be used */
-        // Initialize V8.
+#ifdef AEONGUI_USE_V8
+        // Initialize V8, Duktape heaps need no global setup.
         v8::V8::InitializeICU();
         v8::V8::InitializeExternalStartupData ( argv[0] );
         gPlatform = v8::platform::NewDefaultPlatform();
         v8::V8::InitializePlatform ( gPlatform.get() );
         v8::V8::Initialize();
+#endif
         return true;
     }
     void Finalize()
     {
+#ifdef AEONGUI_USE_V8
         v8::V8::Dispose();
-        v8::V8::ShutdownPlatform();
+        v8::V8::DisposePlatform();
         gPlatform.reset();
+#endif
     }
 }
\ No newline at end of file
@@ -0,0 +1,143 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <limits>
+#include "aeongui/AtlasPacker.h"
+
+namespace AeonGUI
+{
+    AtlasPacker::AtlasPacker ( uint32_t aWidth, uint32_t aHeight, uint32_t aPadding ) :
+        mWidth{aWidth}, mHeight{aHeight}, mPadding{aPadding}
+    {
+        Reset();
+    }
+
+    void AtlasPacker::Reset()
+    {
+        mSkyline.clear();
+        // Padding only goes between rectangles, so the area is widened by one padding to let
+        // the padding of rectangles touching the right or bottom edge hang outside of it.
+        mSkyline.push_back ( {0, 0, mWidth + mPadding} );
+        mUsedArea = 0;
+    }
+
+    bool AtlasPacker::Fit ( size_t aIndex, uint32_t aWidth, uint32_t aHeight, uint32_t& aY ) const
+    {
+        if ( mSkyline[aIndex].x + aWidth > mWidth + mPadding )
+        {
+            return false;
+        }
+        // The rectangle rests on the highest segment it spans.
+        uint32_t y = 0;
+        uint32_t remaining = aWidth;
+        for ( size_t i = aIndex; remaining > 0; ++i )
+        {
+            y = std::max ( y, mSkyline[i].y );
+            if ( y + aHeight > mHeight + mPadding )
+            {
+                return false;
+            }
+            remaining -= std::min ( remaining, mSkyline[i].width );
+        }
+        aY = y;
+        return true;
+    }
+
+    bool AtlasPacker::Insert ( uint32_t aWidth, uint32_t aHeight, Rect& aRect )
+    {
+        const uint32_t width = aWidth + mPadding;
+        const uint32_t height = aHeight + mPadding;
+        size_t best_index = mSkyline.size();
+        uint32_t best_top = std::numeric_limits<uint32_t>::max();
+        uint32_t best_width = std::numeric_limits<uint32_t>::max();
+        uint32_t best_y = 0;
+        for ( size_t i = 0; i < mSkyline.size(); ++i )
+        {
+            uint32_t y;
+            if ( Fit ( i, width, height, y ) &&
+                 ( ( y + height < best_top ) || ( ( y + height == best_top ) && ( mSkyline[i].width < best_width ) ) ) )
+            {
+                best_index = i;
+                best_top = y + height;
+                best_width = mSkyline[i].width;
+                best_y = y;
+            }
+        }
+        if ( best_index == mSkyline.size() )
+        {
+            return false;
+        }
+
+        const uint32_t x = mSkyline[best_index].x;
+        mSkyline.insert ( mSkyline.begin() + best_index, {x, best_top, width} );
+
+        // Trim or drop the segments now covered by the new one.
+        for ( size_t i = best_index + 1; i < mSkyline.size(); )
+        {
+            const uint32_t end = x + width;
+            if ( mSkyline[i].x >= end )
+            {
+                break;
+            }
+            const uint32_t shrink = end - mSkyline[i].x;
+            if ( mSkyline[i].width <= shrink )
+            {
+                mSkyline.erase ( mSkyline.begin() + i );
+                continue;
+            }
+            mSkyline[i].x += shrink;
+            mSkyline[i].width -= shrink;
+            break;
+        }
+
+        // Merge neighbours at the same height.
+        for ( size_t i = 0; i + 1 < mSkyline.size(); )
+        {
+            if ( mSkyline[i].y == mSkyline[i + 1].y )
+            {
+                mSkyline[i].width += mSkyline[i + 1].width;
+                mSkyline.erase ( mSkyline.begin() + i + 1 );
+                continue;
+            }
+            ++i;
+        }
+
+        mUsedArea += static_cast<uint64_t> ( std::min ( width, mWidth - x ) ) * std::min ( height, mHeight - best_y );
+        aRect = Rect{static_cast<int32_t> ( x ), static_cast<int32_t> ( best_y ), aWidth, aHeight};
+        return true;
+    }
+
+    uint32_t AtlasPacker::GetWidth() const
+    {
+        return mWidth;
+    }
+
+    uint32_t AtlasPacker::GetHeight() const
+    {
+        return mHeight;
+    }
+
+    uint32_t AtlasPacker::GetPadding() const
+    {
+        return mPadding;
+    }
+
+    double AtlasPacker::GetOccupancy() const
+    {
+        return ( mWidth && mHeight ) ? static_cast<double> ( mUsedArea ) / ( static_cast<double> ( mWidth ) * mHeight ) : 0.0;
+    }
+}
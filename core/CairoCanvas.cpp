@@ -21,6 +21,8 @@ limitations under the License.
 #include <limits>
 #include "aeongui/CairoCanvas.h"
 #include "aeongui/CairoPath.h"
+#include "aeongui/CairoGradient.h"
+#include "aeongui/CairoGlyphRun.h"
 
 namespace AeonGUI
 {
@@ -144,10 +146,72 @@ namespace AeonGUI
         return mOpacity;
     }
 
+    /** Sets a cached gradient pattern as the current source.
+     *  Patterns in objectBoundingBox units are shared by every element
+     *  referencing the gradient, so only the pattern matrix is updated per draw.
+     *  @return false if there is nothing to paint. */
+    static bool SetGradientSource ( cairo_t* aCairoContext, const Gradient* aGradient )
+    {
+        const CairoGradient* gradient = reinterpret_cast<const CairoGradient*> ( aGradient );
+        cairo_pattern_t* pattern = gradient->GetCairoPattern();
+        if ( pattern == nullptr )
+        {
+            return false;
+        }
+        if ( gradient->GetUnits() == Gradient::OBJECT_BOUNDING_BOX )
+        {
+            double x1, y1, x2, y2;
+            cairo_path_extents ( aCairoContext, &x1, &y1, &x2, &y2 );
+            /* https://www.w3.org/TR/SVG/coords.html#ObjectBoundingBoxUnits
+               A bounding box without width or height can't be used as a coordinate system,
+               the element is not rendered with this paint server. */
+            if ( ( x2 - x1 ) <= 0.0 || ( y2 - y1 ) <= 0.0 )
+            {
+                return false;
+            }
+            cairo_matrix_t matrix;
+            cairo_matrix_init_translate ( &matrix, x1, y1 );
+            cairo_matrix_scale ( &matrix, x2 - x1, y2 - y1 );
+            cairo_matrix_invert ( &matrix );
+            cairo_pattern_set_matrix ( pattern, &matrix );
+        }
+        cairo_set_source ( aCairoContext, pattern );
+        return true;
+    }
+
     void CairoCanvas::Draw ( const Path& aPath )
     {
         const CairoPath& path = reinterpret_cast<const CairoPath&> ( aPath );
         cairo_append_path ( mCairoContext, path.GetCairoPath() );
+        FillAndStroke();
+    }
+
+    void CairoCanvas::Draw ( const GlyphRun& aGlyphRun )
+    {
+        const CairoGlyphRun& glyph_run = reinterpret_cast<const CairoGlyphRun&> ( aGlyphRun );
+        const std::vector<cairo_glyph_t>& glyphs = glyph_run.GetGlyphs();
+        if ( glyphs.empty() )
+        {
+            return;
+        }
+        cairo_set_scaled_font ( mCairoContext, glyph_run.GetScaledFont() );
+        if ( std::holds_alternative<Color> ( mFillColor ) &&
+             std::holds_alternative<none> ( mStrokeColor ) &&
+             ! ( mOpacity < 1.0 && mOpacity > 0.0 ) )
+        {
+            /* Plain filled text, cairo composites its cached glyph masks
+               directly without building outlines. */
+            Color& fill = std::get<Color> ( mFillColor );
+            cairo_set_source_rgba ( mCairoContext, fill.R(), fill.G(), fill.B(), ( mFillOpacity >= 1.0 ) ? fill.A() : mFillOpacity );
+            cairo_show_glyphs ( mCairoContext, glyphs.data(), static_cast<int> ( glyphs.size() ) );
+            return;
+        }
+        cairo_glyph_path ( mCairoContext, glyphs.data(), static_cast<int> ( glyphs.size() ) );
+        FillAndStroke();
+    }
+
+    void CairoCanvas::FillAndStroke()
+    {
         if ( mOpacity < 1.0 && mOpacity > 0.0 )
         {
             cairo_push_group ( mCairoContext );
@@ -158,6 +222,21 @@ namespace AeonGUI
             cairo_set_source_rgba ( mCairoContext, fill.R(), fill.G(), fill.B(), ( mFillOpacity >= 1.0 ) ? fill.A() : mFillOpacity );
             cairo_fill_preserve ( mCairoContext );
         }
+        else if ( std::holds_alternative<const Gradient*> ( mFillColor ) &&
+                  SetGradientSource ( mCairoContext, std::get<const Gradient*> ( mFillColor ) ) )
+        {
+            if ( mFillOpacity >= 1.0 )
+            {
+                cairo_fill_preserve ( mCairoContext );
+            }
+            else
+            {
+                cairo_save ( mCairoContext );
+                cairo_clip_preserve ( mCairoContext );
+                cairo_paint_with_alpha ( mCairoContext, mFillOpacity );
+                cairo_restore ( mCairoContext );
+            }
+        }
         if ( std::holds_alternative<Color> ( mStrokeColor ) )
         {
             Color& stroke = std::get<Color> ( mStrokeColor );
@@ -165,6 +244,22 @@ namespace AeonGUI
             cairo_set_source_rgba ( mCairoContext, stroke.R(), stroke.G(), stroke.B(), ( mStrokeOpacity >= 1.0 ) ? stroke.A() : mStrokeOpacity );
             cairo_stroke_preserve ( mCairoContext );
         }
+        else if ( std::holds_alternative<const Gradient*> ( mStrokeColor ) &&
+                  SetGradientSource ( mCairoContext, std::get<const Gradient*> ( mStrokeColor ) ) )
+        {
+            cairo_set_line_width ( mCairoContext, mStrokeWidth );
+            if ( mStrokeOpacity >= 1.0 )
+            {
+                cairo_stroke_preserve ( mCairoContext );
+            }
+            else
+            {
+                cairo_push_group ( mCairoContext );
+                cairo_stroke_preserve ( mCairoContext );
+                cairo_pop_group_to_source ( mCairoContext );
+                cairo_paint_with_alpha ( mCairoContext, mStrokeOpacity );
+            }
+        }
         if ( mOpacity < 1.0 && mOpacity > 0.0 )
         {
             cairo_pop_group_to_source ( mCairoContext );
@@ -0,0 +1,85 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <cairo.h>
+#include "aeongui/CairoGlyphRun.h"
+
+namespace AeonGUI
+{
+    CairoGlyphRun::CairoGlyphRun() = default;
+
+    CairoGlyphRun::~CairoGlyphRun()
+    {
+        Release();
+    }
+
+    void CairoGlyphRun::Release()
+    {
+        if ( mScaledFont )
+        {
+            cairo_scaled_font_destroy ( mScaledFont );
+            mScaledFont = nullptr;
+        }
+        mGlyphs.clear();
+        mAdvance = 0.0;
+    }
+
+    void CairoGlyphRun::Construct ( const std::string& aText, const std::string& aFontFamily, double aFontSize, bool aBold, double aX, double aY )
+    {
+        Release();
+        cairo_font_face_t* font_face = cairo_toy_font_face_create ( aFontFamily.c_str(), CAIRO_FONT_SLANT_NORMAL,
+                                       aBold ? CAIRO_FONT_WEIGHT_BOLD : CAIRO_FONT_WEIGHT_NORMAL );
+        cairo_matrix_t font_matrix;
+        cairo_matrix_t ctm;
+        cairo_matrix_init_scale ( &font_matrix, aFontSize, aFontSize );
+        cairo_matrix_init_identity ( &ctm );
+        cairo_font_options_t* options = cairo_font_options_create();
+        mScaledFont = cairo_scaled_font_create ( font_face, &font_matrix, &ctm, options );
+        cairo_font_options_destroy ( options );
+        cairo_font_face_destroy ( font_face );
+        if ( cairo_scaled_font_status ( mScaledFont ) != CAIRO_STATUS_SUCCESS || aText.empty() )
+        {
+            return;
+        }
+        cairo_glyph_t* glyphs{};
+        int glyph_count{};
+        if ( cairo_scaled_font_text_to_glyphs ( mScaledFont, aX, aY, aText.data(), static_cast<int> ( aText.size() ),
+                                                &glyphs, &glyph_count, nullptr, nullptr, nullptr ) != CAIRO_STATUS_SUCCESS )
+        {
+            return;
+        }
+        mGlyphs.assign ( glyphs, glyphs + glyph_count );
+        cairo_glyph_free ( glyphs );
+        cairo_text_extents_t extents;
+        cairo_scaled_font_glyph_extents ( mScaledFont, mGlyphs.data(), glyph_count, &extents );
+        mAdvance = extents.x_advance;
+    }
+
+    double CairoGlyphRun::GetAdvance() const
+    {
+        return mAdvance;
+    }
+
+    cairo_scaled_font_t* CairoGlyphRun::GetScaledFont() const
+    {
+        return mScaledFont;
+    }
+
+    const std::vector<cairo_glyph_t>& CairoGlyphRun::GetGlyphs() const
+    {
+        return mGlyphs;
+    }
+}
@@ -0,0 +1,84 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <cairo.h>
+#include "aeongui/CairoGradient.h"
+
+namespace AeonGUI
+{
+    CairoGradient::CairoGradient() = default;
+
+    CairoGradient::~CairoGradient()
+    {
+        if ( mPattern )
+        {
+            cairo_pattern_destroy ( mPattern );
+        }
+    }
+
+    void CairoGradient::ConstructLinear ( double x1, double y1, double x2, double y2, const std::vector<ColorStop>& aStops, Units aUnits, Spread aSpread )
+    {
+        if ( mPattern )
+        {
+            cairo_pattern_destroy ( mPattern );
+        }
+        mUnits = aUnits;
+        mPattern = cairo_pattern_create_linear ( x1, y1, x2, y2 );
+        SetColorStops ( aStops, aSpread );
+    }
+
+    void CairoGradient::ConstructRadial ( double cx, double cy, double r, double fx, double fy, const std::vector<ColorStop>& aStops, Units aUnits, Spread aSpread )
+    {
+        if ( mPattern )
+        {
+            cairo_pattern_destroy ( mPattern );
+        }
+        mUnits = aUnits;
+        // SVG focal points have a zero radius.
+        mPattern = cairo_pattern_create_radial ( fx, fy, 0.0, cx, cy, r );
+        SetColorStops ( aStops, aSpread );
+    }
+
+    void CairoGradient::SetColorStops ( const std::vector<ColorStop>& aStops, Spread aSpread )
+    {
+        for ( auto& i : aStops )
+        {
+            cairo_pattern_add_color_stop_rgba ( mPattern, i.offset, i.color.R(), i.color.G(), i.color.B(), i.color.A() );
+        }
+        switch ( aSpread )
+        {
+        case PAD:
+            cairo_pattern_set_extend ( mPattern, CAIRO_EXTEND_PAD );
+            break;
+        case REFLECT:
+            cairo_pattern_set_extend ( mPattern, CAIRO_EXTEND_REFLECT );
+            break;
+        case REPEAT:
+            cairo_pattern_set_extend ( mPattern, CAIRO_EXTEND_REPEAT );
+            break;
+        }
+    }
+
+    Gradient::Units CairoGradient::GetUnits() const
+    {
+        return mUnits;
+    }
+
+    cairo_pattern_t* CairoGradient::GetCairoPattern() const
+    {
+        return mPattern;
+    }
+}
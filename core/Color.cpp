@@ -15,200 +15,380 @@ Copyright (C) 2010-2012,2019,2020 Rodrigo Hernandez Cordoba
 ******************************************************************************/
 #include "aeongui/Color.h"
 #include <algorithm>
-#include <iostream>
-#include <unordered_map>
+#include <array>
+#include <string_view>
 namespace AeonGUI
 {
-    const std::regex Color::ColorRegex{"#[0-9A-Fa-f]{8}|#[0-9A-Fa-f]{6}|#[0-9A-Fa-f]{3}|aliceblue|antiquewhite|aqua|aquamarine|azure|beige|bisque|black|blanchedalmond|blue|blueviolet|brown|burlywood|cadetblue|chartreuse|chocolate|coral|cornflowerblue|cornsilk|crimson|cyan|darkblue|darkcyan|darkgoldenrod|darkgray|darkgreen|darkgrey|darkkhaki|darkmagenta|darkolivegreen|darkorange|darkorchid|darkred|darksalmon|darkseagreen|darkslateblue|darkslategray|darkslategrey|darkturquoise|darkviolet|deeppink|deepskyblue|dimgray|dimgrey|dodgerblue|firebrick|floralwhite|forestgreen|fuchsia|gainsboro|ghostwhite|gold|goldenrod|gray|grey|green|greenyellow|honeydew|hotpink|indianred|indigo|ivory|khaki|lavender|lavenderblush|lawngreen|lemonchiffon|lightblue|lightcoral|lightcyan|lightgoldenrodyellow|lightgray|lightgreen|lightgrey|lightpink|lightsalmon|lightseagreen|lightskyblue|lightslategray|lightslategrey|lightsteelblue|lightyellow|lime|limegreen|linen|magenta|maroon|mediumaquamarine|mediumblue|mediumorchid|mediumpurple|mediumseagreen|mediumslateblue|mediumspringgreen|mediumturquoise|mediumvioletred|midnightblue|mintcream|mistyrose|moccasin|navajowhite|navy|none|oldlace|olive|olivedrab|orange|orangered|orchid|palegoldenrod|palegreen|paleturquoise|palevioletred|papayawhip|peachpuff|peru|pink|plum|powderblue|purple|red|rosybrown|royalblue|saddlebrown|salmon|sandybrown|seagreen|seashell|sienna|silver|skyblue|slateblue|slategray|slategrey|snow|springgreen|steelblue|tan|teal|thistle|tomato|transparent|turquoise|violet|wheat|white|whitesmoke|yellow|yellowgreen"};
-    static const std::unordered_map<std::string, uint32_t> color_map
+    namespace
     {
-        {"aliceblue", 0xfff0f8ff},
-        {"antiquewhite", 0xfffaebd7},
-        {"aqua", 0xff00ffff},
-        {"aquamarine", 0xff7fffd4},
-        {"azure", 0xfff0ffff},
-        {"beige", 0xfff5f5dc},
-        {"bisque", 0xffffe4c4},
-        {"black", 0xff000000},
-        {"blanchedalmond", 0xffffebcd},
-        {"blue", 0xff0000ff},
-        {"blueviolet", 0xff8a2be2},
-        {"brown", 0xffa52a2a},
-        {"burlywood", 0xffdeb887},
-        {"cadetblue", 0xff5f9ea0},
-        {"chartreuse", 0xff7fff00},
-        {"chocolate", 0xffd2691e},
-        {"coral", 0xffff7f50},
-        {"cornflowerblue", 0xff6495ed},
-        {"cornsilk", 0xfffff8dc},
-        {"crimson", 0xffdc143c},
-        {"cyan", 0xff00ffff},
-        {"darkblue", 0xff00008b},
-        {"darkcyan", 0xff008b8b},
-        {"darkgoldenrod", 0xffb8860b},
-        {"darkgray", 0xffa9a9a9},
-        {"darkgreen", 0xff006400},
-        {"darkgrey", 0xffa9a9a9},
-        {"darkkhaki", 0xffbdb76b},
-        {"darkmagenta", 0xff8b008b},
-        {"darkolivegreen", 0xff556b2f},
-        {"darkorange", 0xffff8c00},
-        {"darkorchid", 0xff9932cc},
-        {"darkred", 0xff8b0000},
-        {"darksalmon", 0xffe9967a},
-        {"darkseagreen", 0xff8fbc8f},
-        {"darkslateblue", 0xff483d8b},
-        {"darkslategray", 0xff2f4f4f},
-        {"darkslategrey", 0xff2f4f4f},
-        {"darkturquoise", 0xff00ced1},
-        {"darkviolet", 0xff9400d3},
-        {"deeppink", 0xffff1493},
-        {"deepskyblue", 0xff00bfff},
-        {"dimgray", 0xff696969},
-        {"dimgrey", 0xff696969},
-        {"dodgerblue", 0xff1e90ff},
-        {"firebrick", 0xffb22222},
-        {"floralwhite", 0xfffffaf0},
-        {"forestgreen", 0xff228b22},
-        {"fuchsia", 0xffff00ff},
-        {"gainsboro", 0xffdcdcdc},
-        {"ghostwhite", 0xfff8f8ff},
-        {"gold", 0xffffd700},
-        {"goldenrod", 0xffdaa520},
-        {"gray", 0xff808080},
-        {"grey", 0xff808080},
-        {"green", 0xff008000},
-        {"greenyellow", 0xffadff2f},
-        {"honeydew", 0xfff0fff0},
-        {"hotpink", 0xffff69b4},
-        {"indianred", 0xffcd5c5c},
-        {"indigo", 0xff4b0082},
-        {"ivory", 0xfffffff0},
-        {"khaki", 0xfff0e68c},
-        {"lavender", 0xffe6e6fa},
-        {"lavenderblush", 0xfffff0f5},
-        {"lawngreen", 0xff7cfc00},
-        {"lemonchiffon", 0xfffffacd},
-        {"lightblue", 0xffadd8e6},
-        {"lightcoral", 0xfff08080},
-        {"lightcyan", 0xffe0ffff},
-        {"lightgoldenrodyellow", 0xfffafad2},
-        {"lightgray", 0xffd3d3d3},
-        {"lightgreen", 0xff90ee90},
-        {"lightgrey", 0xffd3d3d3},
-        {"lightpink", 0xffffb6c1},
-        {"lightsalmon", 0xffffa07a},
-        {"lightseagreen", 0xff20b2aa},
-        {"lightskyblue", 0xff87cefa},
-        {"lightslategray", 0xff778899},
-        {"lightslategrey", 0xff778899},
-        {"lightsteelblue", 0xffb0c4de},
-        {"lightyellow", 0xffffffe0},
-        {"lime", 0xff00ff00},
-        {"limegreen", 0xff32cd32},
-        {"linen", 0xfffaf0e6},
-        {"magenta", 0xffff00ff},
-        {"maroon", 0xff800000},
-        {"mediumaquamarine", 0xff66cdaa},
-        {"mediumblue", 0xff0000cd},
-        {"mediumorchid", 0xffba55d3},
-        {"mediumpurple", 0xff9370db},
-        {"mediumseagreen", 0xff3cb371},
-        {"mediumslateblue", 0xff7b68ee},
-        {"mediumspringgreen", 0xff00fa9a},
-        {"mediumturquoise", 0xff48d1cc},
-        {"mediumvioletred", 0xffc71585},
-        {"midnightblue", 0xff191970},
-        {"mintcream", 0xfff5fffa},
-        {"mistyrose", 0xffffe4e1},
-        {"moccasin", 0xffffe4b5},
-        {"navajowhite", 0xffffdead},
-        {"navy", 0xff000080},
-        {"oldlace", 0xfffdf5e6},
-        {"olive", 0xff808000},
-        {"olivedrab", 0xff6b8e23},
-        {"orange", 0xffffa500},
-        {"orangered", 0xffff4500},
-        {"orchid", 0xffda70d6},
-        {"palegoldenrod", 0xffeee8aa},
-        {"palegreen", 0xff98fb98},
-        {"paleturquoise", 0xffafeeee},
-        {"palevioletred", 0xffdb7093},
-        {"papayawhip", 0xffffefd5},
-        {"peachpuff", 0xffffdab9},
-        {"peru", 0xffcd853f},
-        {"pink", 0xffffc0cb},
-        {"plum", 0xffdda0dd},
-        {"powderblue", 0xffb0e0e6},
-        {"purple", 0xff800080},
-        {"red", 0xffff0000},
-        {"rosybrown", 0xffbc8f8f},
-        {"royalblue", 0xff4169e1},
-        {"saddlebrown", 0xff8b4513},
-        {"salmon", 0xfffa8072},
-        {"sandybrown", 0xfff4a460},
-        {"seagreen", 0xff2e8b57},
-        {"seashell", 0xfffff5ee},
-        {"sienna", 0xffa0522d},
-        {"silver", 0xffc0c0c0},
-        {"skyblue", 0xff87ceeb},
-        {"slateblue", 0xff6a5acd},
-        {"slategray", 0xff708090},
-        {"slategrey", 0xff708090},
-        {"snow", 0xfffffafa},
-        {"springgreen", 0xff00ff7f},
-        {"steelblue", 0xff4682b4},
-        {"tan", 0xffd2b48c},
-        {"teal", 0xff008080},
-        {"thistle", 0xffd8bfd8},
-        {"tomato", 0xffff6347},
-        {"transparent", 0x00000000}, //<-- Look at me I'm Special.
-        {"turquoise", 0xff40e0d0},
-        {"violet", 0xffee82ee},
-        {"wheat", 0xfff5deb3},
-        {"white", 0xffffffff},
-        {"whitesmoke", 0xfff5f5f5},
-        {"yellow", 0xffffff00},
-        {"yellowgreen", 0xff9acd32},
-    };
+        struct ColorKeyword
+        {
+            std::string_view name;
+            uint32_t value;
+        };
+
+        /*  CSS3 color keywords, keep in strict alphanumerical order.
+            none is not a color but a paint value, the parsers handle it themselves. */
+        constexpr std::array<ColorKeyword, 148> ColorKeywords
+        {
+            {
+                {"aliceblue", 0xfff0f8ff},
+                {"antiquewhite", 0xfffaebd7},
+                {"aqua", 0xff00ffff},
+                {"aquamarine", 0xff7fffd4},
+                {"azure", 0xfff0ffff},
+                {"beige", 0xfff5f5dc},
+                {"bisque", 0xffffe4c4},
+                {"black", 0xff000000},
+                {"blanchedalmond", 0xffffebcd},
+                {"blue", 0xff0000ff},
+                {"blueviolet", 0xff8a2be2},
+                {"brown", 0xffa52a2a},
+                {"burlywood", 0xffdeb887},
+                {"cadetblue", 0xff5f9ea0},
+                {"chartreuse", 0xff7fff00},
+                {"chocolate", 0xffd2691e},
+                {"coral", 0xffff7f50},
+                {"cornflowerblue", 0xff6495ed},
+                {"cornsilk", 0xfffff8dc},
+                {"crimson", 0xffdc143c},
+                {"cyan", 0xff00ffff},
+                {"darkblue", 0xff00008b},
+                {"darkcyan", 0xff008b8b},
+                {"darkgoldenrod", 0xffb8860b},
+                {"darkgray", 0xffa9a9a9},
+                {"darkgreen", 0xff006400},
+                {"darkgrey", 0xffa9a9a9},
+                {"darkkhaki", 0xffbdb76b},
+                {"darkmagenta", 0xff8b008b},
+                {"darkolivegreen", 0xff556b2f},
+                {"darkorange", 0xffff8c00},
+                {"darkorchid", 0xff9932cc},
+                {"darkred", 0xff8b0000},
+                {"darksalmon", 0xffe9967a},
+                {"darkseagreen", 0xff8fbc8f},
+                {"darkslateblue", 0xff483d8b},
+                {"darkslategray", 0xff2f4f4f},
+                {"darkslategrey", 0xff2f4f4f},
+                {"darkturquoise", 0xff00ced1},
+                {"darkviolet", 0xff9400d3},
+                {"deeppink", 0xffff1493},
+                {"deepskyblue", 0xff00bfff},
+                {"dimgray", 0xff696969},
+                {"dimgrey", 0xff696969},
+                {"dodgerblue", 0xff1e90ff},
+                {"firebrick", 0xffb22222},
+                {"floralwhite", 0xfffffaf0},
+                {"forestgreen", 0xff228b22},
+                {"fuchsia", 0xffff00ff},
+                {"gainsboro", 0xffdcdcdc},
+                {"ghostwhite", 0xfff8f8ff},
+                {"gold", 0xffffd700},
+                {"goldenrod", 0xffdaa520},
+                {"gray", 0xff808080},
+                {"grey", 0xff808080},
+                {"green", 0xff008000},
+                {"greenyellow", 0xffadff2f},
+                {"honeydew", 0xfff0fff0},
+                {"hotpink", 0xffff69b4},
+                {"indianred", 0xffcd5c5c},
+                {"indigo", 0xff4b0082},
+                {"ivory", 0xfffffff0},
+                {"khaki", 0xfff0e68c},
+                {"lavender", 0xffe6e6fa},
+                {"lavenderblush", 0xfffff0f5},
+                {"lawngreen", 0xff7cfc00},
+                {"lemonchiffon", 0xfffffacd},
+                {"lightblue", 0xffadd8e6},
+                {"lightcoral", 0xfff08080},
+                {"lightcyan", 0xffe0ffff},
+                {"lightgoldenrodyellow", 0xfffafad2},
+                {"lightgray", 0xffd3d3d3},
+                {"lightgreen", 0xff90ee90},
+                {"lightgrey", 0xffd3d3d3},
+                {"lightpink", 0xffffb6c1},
+                {"lightsalmon", 0xffffa07a},
+                {"lightseagreen", 0xff20b2aa},
+                {"lightskyblue", 0xff87cefa},
+                {"lightslategray", 0xff778899},
+                {"lightslategrey", 0xff778899},
+                {"lightsteelblue", 0xffb0c4de},
+                {"lightyellow", 0xffffffe0},
+                {"lime", 0xff00ff00},
+                {"limegreen", 0xff32cd32},
+                {"linen", 0xfffaf0e6},
+                {"magenta", 0xffff00ff},
+                {"maroon", 0xff800000},
+                {"mediumaquamarine", 0xff66cdaa},
+                {"mediumblue", 0xff0000cd},
+                {"mediumorchid", 0xffba55d3},
+                {"mediumpurple", 0xff9370db},
+                {"mediumseagreen", 0xff3cb371},
+                {"mediumslateblue", 0xff7b68ee},
+                {"mediumspringgreen", 0xff00fa9a},
+                {"mediumturquoise", 0xff48d1cc},
+                {"mediumvioletred", 0xffc71585},
+                {"midnightblue", 0xff191970},
+                {"mintcream", 0xfff5fffa},
+                {"mistyrose", 0xffffe4e1},
+                {"moccasin", 0xffffe4b5},
+                {"navajowhite", 0xffffdead},
+                {"navy", 0xff000080},
+                {"oldlace", 0xfffdf5e6},
+                {"olive", 0xff808000},
+                {"olivedrab", 0xff6b8e23},
+                {"orange", 0xffffa500},
+                {"orangered", 0xffff4500},
+                {"orchid", 0xffda70d6},
+                {"palegoldenrod", 0xffeee8aa},
+                {"palegreen", 0xff98fb98},
+                {"paleturquoise", 0xffafeeee},
+                {"palevioletred", 0xffdb7093},
+                {"papayawhip", 0xffffefd5},
+                {"peachpuff", 0xffffdab9},
+                {"peru", 0xffcd853f},
+                {"pink", 0xffffc0cb},
+                {"plum", 0xffdda0dd},
+                {"powderblue", 0xffb0e0e6},
+                {"purple", 0xff800080},
+                {"red", 0xffff0000},
+                {"rosybrown", 0xffbc8f8f},
+                {"royalblue", 0xff4169e1},
+                {"saddlebrown", 0xff8b4513},
+                {"salmon", 0xfffa8072},
+                {"sandybrown", 0xfff4a460},
+                {"seagreen", 0xff2e8b57},
+                {"seashell", 0xfffff5ee},
+                {"sienna", 0xffa0522d},
+                {"silver", 0xffc0c0c0},
+                {"skyblue", 0xff87ceeb},
+                {"slateblue", 0xff6a5acd},
+                {"slategray", 0xff708090},
+                {"slategrey", 0xff708090},
+                {"snow", 0xfffffafa},
+                {"springgreen", 0xff00ff7f},
+                {"steelblue", 0xff4682b4},
+                {"tan", 0xffd2b48c},
+                {"teal", 0xff008080},
+                {"thistle", 0xffd8bfd8},
+                {"tomato", 0xffff6347},
+                {"transparent", 0x00000000}, //<-- Look at me I'm Special.
+                {"turquoise", 0xff40e0d0},
+                {"violet", 0xffee82ee},
+                {"wheat", 0xfff5deb3},
+                {"white", 0xffffffff},
+                {"whitesmoke", 0xfff5f5f5},
+                {"yellow", 0xffffff00},
+                {"yellowgreen", 0xff9acd32},
+            }
+        };
 
-    static const std::regex color_regex3{"#([0-9A-Fa-f])([0-9A-Fa-f])([0-9A-Fa-f])"};
-    static const std::regex color_regex6{"#([0-9A-Fa-f]{2})([0-9A-Fa-f]{2})([0-9A-Fa-f]{2})"};
-    static const std::regex color_regex8{"#([0-9A-Fa-f]{2})([0-9A-Fa-f]{2})([0-9A-Fa-f]{2})([0-9A-Fa-f]{2})"};
+        /*  The keyword table is indexed through a hash and displace perfect hash
+            built at compile time: the key is hashed once, the low bits pick a bucket
+            and the bucket displacement scrambles the hash into a unique slot.
+            A lookup is one hash, two table reads and one string compare. */
+        constexpr size_t KeywordBucketCount = 64;
+        constexpr size_t KeywordSlotCount = 256;
+        constexpr uint8_t EmptySlot = 0xff;
+        static_assert ( ColorKeywords.size() < EmptySlot, "Keyword indices must fit in a byte." );
+
+        constexpr uint32_t HashKeyword ( std::string_view aKeyword )
+        {
+            // FNV-1a
+            uint32_t hash = 2166136261u;
+            for ( char i : aKeyword )
+            {
+                hash ^= static_cast<uint8_t> ( i );
+                hash *= 16777619u;
+            }
+            return hash;
+        }
+
+        constexpr size_t KeywordSlot ( uint32_t aHash, uint32_t aDisplacement )
+        {
+            // Murmur3 finalizer.
+            uint32_t hash = aHash ^ ( aDisplacement * 0x9e3779b9u );
+            hash ^= hash >> 16;
+            hash *= 0x85ebca6bu;
+            hash ^= hash >> 13;
+            hash *= 0xc2b2ae35u;
+            hash ^= hash >> 16;
+            return hash & ( KeywordSlotCount - 1 );
+        }
+
+        struct KeywordHashTable
+        {
+            std::array<uint16_t, KeywordBucketCount> displacements{};
+            std::array<uint8_t, KeywordSlotCount> slots{};
+        };
+
+        constexpr KeywordHashTable BuildKeywordHashTable()
+        {
+            KeywordHashTable table{};
+            for ( auto& i : table.slots )
+            {
+                i = EmptySlot;
+            }
+            std::array<uint32_t, ColorKeywords.size()> hashes{};
+            std::array<size_t, KeywordBucketCount> bucket_sizes{};
+            for ( size_t i = 0; i < ColorKeywords.size(); ++i )
+            {
+                hashes[i] = HashKeyword ( ColorKeywords[i].name );
+                ++bucket_sizes[hashes[i] & ( KeywordBucketCount - 1 )];
+            }
+            // Place the most crowded buckets first while the table is still sparse.
+            std::array<bool, KeywordBucketCount> placed{};
+            for ( size_t pass = 0; pass < KeywordBucketCount; ++pass )
+            {
+                size_t bucket = 0;
+                size_t largest = 0;
+                for ( size_t i = 0; i < KeywordBucketCount; ++i )
+                {
+                    if ( !placed[i] && bucket_sizes[i] >= largest )
+                    {
+                        bucket = i;
+                        largest = bucket_sizes[i];
+                    }
+                }
+                placed[bucket] = true;
+                if ( largest == 0 )
+                {
+                    continue;
+                }
+                for ( uint32_t displacement = 0;; ++displacement )
+                {
+                    if ( displacement > 0xffff )
+                    {
+                        throw "No perfect hash displacement found for the color keywords.";
+                    }
+                    std::array<uint8_t, KeywordSlotCount> slots = table.slots;
+                    bool fits = true;
+                    for ( size_t i = 0; fits && i < ColorKeywords.size(); ++i )
+                    {
+                        if ( ( hashes[i] & ( KeywordBucketCount - 1 ) ) == bucket )
+                        {
+                            size_t slot = KeywordSlot ( hashes[i], displacement );
+                            fits = ( slots[slot] == EmptySlot );
+                            slots[slot] = static_cast<uint8_t> ( i );
+                        }
+                    }
+                    if ( fits )
+                    {
+                        table.slots = slots;
+                        table.displacements[bucket] = static_cast<uint16_t> ( displacement );
+                        break;
+                    }
+                }
+            }
+            return table;
+        }
+
+        constexpr KeywordHashTable KeywordTable = BuildKeywordHashTable();
+
+        constexpr const ColorKeyword* FindColorKeyword ( std::string_view aKeyword )
+        {
+            uint32_t hash = HashKeyword ( aKeyword );
+            uint8_t index = KeywordTable.slots[KeywordSlot ( hash, KeywordTable.displacements[hash & ( KeywordBucketCount - 1 )] )];
+            if ( index != EmptySlot && ColorKeywords[index].name == aKeyword )
+            {
+                return &ColorKeywords[index];
+            }
+            return nullptr;
+        }
+
+        constexpr int HexDigit ( char aDigit )
+        {
+            if ( aDigit >= '0' && aDigit <= '9' )
+            {
+                return aDigit - '0';
+            }
+            if ( aDigit >= 'a' && aDigit <= 'f' )
+            {
+                return aDigit - 'a' + 10;
+            }
+            if ( aDigit >= 'A' && aDigit <= 'F' )
+            {
+                return aDigit - 'A' + 10;
+            }
+            return -1;
+        }
+
+        /*  Parses the digits after the '#', 3 digits expand each nibble,
+            6 digits are RRGGBB and 8 digits are AARRGGBB. */
+        constexpr bool ParseHexColor ( std::string_view aDigits, uint32_t& aValue )
+        {
+            if ( aDigits.size() != 3 && aDigits.size() != 6 && aDigits.size() != 8 )
+            {
+                return false;
+            }
+            uint32_t value = 0;
+            for ( char i : aDigits )
+            {
+                int digit = HexDigit ( i );
+                if ( digit < 0 )
+                {
+                    return false;
+                }
+                value = ( value << 4 ) | static_cast<uint32_t> ( digit );
+                if ( aDigits.size() == 3 )
+                {
+                    value = ( value << 4 ) | static_cast<uint32_t> ( digit );
+                }
+            }
+            aValue = ( aDigits.size() == 8 ) ? value : ( value | 0xff000000u );
+            return true;
+        }
+
+        static_assert ( FindColorKeyword ( "aliceblue" )->value == aliceblue, "Color keyword table is broken." );
+        static_assert ( FindColorKeyword ( "yellowgreen" )->value == yellowgreen, "Color keyword table is broken." );
+        static_assert ( FindColorKeyword ( "none" ) == nullptr, "none is not a color." );
+    }
 
     Color::Color() : bgra ( 0 ) {}
     Color::Color ( uint32_t value ) : bgra ( value ) {}
     Color::Color ( uint8_t A, uint8_t R, uint8_t G, uint8_t B )
         : b ( B ), g ( G ), r ( R ), a ( A ) {}
 
-    Color::Color ( const std::string& value )
+    Color::Color ( const std::string& value ) : bgra ( 0 )
     {
-        std::smatch color_match;
-        std::unordered_map<std::string, uint32_t>::const_iterator color_iterator;
-        if ( std::regex_search ( value, color_match, color_regex8 ) )
+        std::string_view view{value};
+        size_t first = view.find_first_not_of ( " \t\r\n" );
+        if ( first == std::string_view::npos )
         {
-            a = static_cast<uint8_t> ( std::stoul ( color_match[1].str(), nullptr, 16 ) );
-            r = static_cast<uint8_t> ( std::stoul ( color_match[2].str(), nullptr, 16 ) );
-            g = static_cast<uint8_t> ( std::stoul ( color_match[3].str(), nullptr, 16 ) );
-            b = static_cast<uint8_t> ( std::stoul ( color_match[4].str(), nullptr, 16 ) );
+            return;
         }
-        else if ( std::regex_search ( value, color_match, color_regex6 ) )
+        view = view.substr ( first, view.find_last_not_of ( " \t\r\n" ) - first + 1 );
+        Parse ( view, *this );
+    }
+
+    bool Color::Parse ( std::string_view aValue, Color& aColor )
+    {
+        if ( !aValue.empty() && aValue[0] == '#' )
         {
-            a = 255;
-            r = static_cast<uint8_t> ( std::stoul ( color_match[1].str(), nullptr, 16 ) );
-            g = static_cast<uint8_t> ( std::stoul ( color_match[2].str(), nullptr, 16 ) );
-            b = static_cast<uint8_t> ( std::stoul ( color_match[3].str(), nullptr, 16 ) );
+            uint32_t value;
+            if ( ParseHexColor ( aValue.substr ( 1 ), value ) )
+            {
+                aColor.bgra = value;
+                return true;
+            }
+            return false;
         }
-        else if ( std::regex_search ( value, color_match, color_regex3 ) )
+        if ( const ColorKeyword* keyword = FindColorKeyword ( aValue ) )
         {
-            a = 255;
-            r = static_cast<uint8_t> ( std::stoul ( color_match[1].str() + color_match[1].str(), nullptr, 16 ) );
-            g = static_cast<uint8_t> ( std::stoul ( color_match[2].str() + color_match[2].str(), nullptr, 16 ) );
-            b = static_cast<uint8_t> ( std::stoul ( color_match[3].str() + color_match[3].str(), nullptr, 16 ) );
+            aColor.bgra = keyword->value;
+            return true;
         }
-        else if ( ( color_iterator = color_map.find ( value ) ) != color_map.end() )
+        return false;
+    }
+
+    void Color::EnumerateKeywords ( const std::function<bool ( std::string_view ) >& aEnumerator )
+    {
+        for ( auto& i : ColorKeywords )
         {
-            bgra = color_iterator->second;
+            if ( !aEnumerator ( i.name ) )
+            {
+                return;
+            }
         }
     }
 
@@ -0,0 +1,332 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <array>
+#include "aeongui/CpuFeatures.h"
+#include "aeongui/Compositing.h"
+#if defined(AEONGUI_X86)
+#include <immintrin.h>
+#elif defined(AEONGUI_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace AeonGUI
+{
+    using BlendRowKernel = void ( * ) ( const Color*, Color*, size_t, uint8_t );
+
+    /*  Every kernel divides by 255 as (x + 128 + ((x + 128) >> 8)) >> 8,
+        which is exact rounding for x up to 255 * 255 and fits 16 bit lanes. */
+    static inline uint32_t Div255 ( uint32_t x )
+    {
+        x += 128;
+        return ( x + ( x >> 8 ) ) >> 8;
+    }
+
+    /*  Ported from the CUDA blend kernel, with integer math and a proper
+        source-over alpha instead of the saturating accumulation used there. */
+    static void BlendRowStraight ( const Color* aSource, Color* aDestination, size_t aCount, uint8_t aOpacity )
+    {
+        for ( size_t i = 0; i < aCount; ++i )
+        {
+            const Color source = aSource[i];
+            Color& destination = aDestination[i];
+            const uint32_t alpha = ( aOpacity == 255 ) ? source.a : Div255 ( source.a * aOpacity );
+            const uint32_t inverse = 255 - alpha;
+            destination.b = static_cast<uint8_t> ( Div255 ( source.b * alpha + destination.b * inverse ) );
+            destination.g = static_cast<uint8_t> ( Div255 ( source.g * alpha + destination.g * inverse ) );
+            destination.r = static_cast<uint8_t> ( Div255 ( source.r * alpha + destination.r * inverse ) );
+            destination.a = static_cast<uint8_t> ( Div255 ( 255 * alpha + destination.a * inverse ) );
+        }
+    }
+
+    static void BlendRowPremultiplied ( const Color* aSource, Color* aDestination, size_t aCount, uint8_t aOpacity )
+    {
+        for ( size_t i = 0; i < aCount; ++i )
+        {
+            Color source = aSource[i];
+            Color& destination = aDestination[i];
+            if ( aOpacity != 255 )
+            {
+                source.b = static_cast<uint8_t> ( Div255 ( source.b * aOpacity ) );
+                source.g = static_cast<uint8_t> ( Div255 ( source.g * aOpacity ) );
+                source.r = static_cast<uint8_t> ( Div255 ( source.r * aOpacity ) );
+                source.a = static_cast<uint8_t> ( Div255 ( source.a * aOpacity ) );
+            }
+            const uint32_t inverse = 255 - source.a;
+            destination.b = static_cast<uint8_t> ( std::min<uint32_t> ( 255, source.b + Div255 ( destination.b * inverse ) ) );
+            destination.g = static_cast<uint8_t> ( std::min<uint32_t> ( 255, source.g + Div255 ( destination.g * inverse ) ) );
+            destination.r = static_cast<uint8_t> ( std::min<uint32_t> ( 255, source.r + Div255 ( destination.r * inverse ) ) );
+            destination.a = static_cast<uint8_t> ( std::min<uint32_t> ( 255, source.a + Div255 ( destination.a * inverse ) ) );
+        }
+    }
+
+#if defined(AEONGUI_X86)
+    AEONGUI_TARGET ( "sse2" ) static inline __m128i Div255SSE2 ( __m128i x )
+    {
+        x = _mm_add_epi16 ( x, _mm_set1_epi16 ( 128 ) );
+        return _mm_srli_epi16 ( _mm_add_epi16 ( x, _mm_srli_epi16 ( x, 8 ) ), 8 );
+    }
+
+    // Copies the alpha of each pixel into all four of its 16 bit lanes.
+    AEONGUI_TARGET ( "sse2" ) static inline __m128i BroadcastAlphaSSE2 ( __m128i x )
+    {
+        return _mm_shufflehi_epi16 ( _mm_shufflelo_epi16 ( x, _MM_SHUFFLE ( 3, 3, 3, 3 ) ), _MM_SHUFFLE ( 3, 3, 3, 3 ) );
+    }
+
+    // Blends two pixels unpacked to 16 bit lanes.
+    template<bool Premultiplied>
+    AEONGUI_TARGET ( "sse2" ) static inline __m128i BlendPairSSE2 ( __m128i aSource, __m128i aDestination, __m128i aOpacity )
+    {
+        const __m128i full = _mm_set1_epi16 ( 255 );
+        if ( Premultiplied )
+        {
+            aSource = Div255SSE2 ( _mm_mullo_epi16 ( aSource, aOpacity ) );
+            const __m128i inverse = _mm_sub_epi16 ( full, BroadcastAlphaSSE2 ( aSource ) );
+            return _mm_add_epi16 ( aSource, Div255SSE2 ( _mm_mullo_epi16 ( aDestination, inverse ) ) );
+        }
+        const __m128i alpha_lanes = _mm_set_epi16 ( -1, 0, 0, 0, -1, 0, 0, 0 );
+        const __m128i alpha = Div255SSE2 ( _mm_mullo_epi16 ( BroadcastAlphaSSE2 ( aSource ), aOpacity ) );
+        // The alpha component itself blends as if the source stored 255.
+        aSource = _mm_or_si128 ( _mm_andnot_si128 ( alpha_lanes, aSource ), _mm_and_si128 ( alpha_lanes, full ) );
+        return Div255SSE2 ( _mm_add_epi16 ( _mm_mullo_epi16 ( aSource, alpha ), _mm_mullo_epi16 ( aDestination, _mm_sub_epi16 ( full, alpha ) ) ) );
+    }
+
+    template<bool Premultiplied>
+    AEONGUI_TARGET ( "sse2" ) static void BlendRowSSE2 ( const Color* aSource, Color* aDestination, size_t aCount, uint8_t aOpacity )
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i alpha_mask = _mm_set1_epi32 ( static_cast<int> ( 0xff000000 ) );
+        const __m128i opacity = _mm_set1_epi16 ( aOpacity );
+        size_t i = 0;
+        for ( ; i + 4 <= aCount; i += 4 )
+        {
+            const __m128i source = _mm_loadu_si128 ( reinterpret_cast<const __m128i*> ( aSource + i ) );
+            // Fully transparent and, at full opacity, fully opaque groups need no math.
+            const __m128i alpha = _mm_and_si128 ( source, alpha_mask );
+            if ( _mm_movemask_epi8 ( _mm_cmpeq_epi32 ( Premultiplied ? source : alpha, zero ) ) == 0xFFFF )
+            {
+                continue;
+            }
+            if ( aOpacity == 255 && _mm_movemask_epi8 ( _mm_cmpeq_epi32 ( alpha, alpha_mask ) ) == 0xFFFF )
+            {
+                _mm_storeu_si128 ( reinterpret_cast<__m128i*> ( aDestination + i ), source );
+                continue;
+            }
+            const __m128i destination = _mm_loadu_si128 ( reinterpret_cast<const __m128i*> ( aDestination + i ) );
+            const __m128i low = BlendPairSSE2<Premultiplied> ( _mm_unpacklo_epi8 ( source, zero ), _mm_unpacklo_epi8 ( destination, zero ), opacity );
+            const __m128i high = BlendPairSSE2<Premultiplied> ( _mm_unpackhi_epi8 ( source, zero ), _mm_unpackhi_epi8 ( destination, zero ), opacity );
+            _mm_storeu_si128 ( reinterpret_cast<__m128i*> ( aDestination + i ), _mm_packus_epi16 ( low, high ) );
+        }
+        if ( Premultiplied )
+        {
+            BlendRowPremultiplied ( aSource + i, aDestination + i, aCount - i, aOpacity );
+        }
+        else
+        {
+            BlendRowStraight ( aSource + i, aDestination + i, aCount - i, aOpacity );
+        }
+    }
+
+    AEONGUI_TARGET ( "avx2" ) static inline __m256i Div255AVX2 ( __m256i x )
+    {
+        x = _mm256_add_epi16 ( x, _mm256_set1_epi16 ( 128 ) );
+        return _mm256_srli_epi16 ( _mm256_add_epi16 ( x, _mm256_srli_epi16 ( x, 8 ) ), 8 );
+    }
+
+    AEONGUI_TARGET ( "avx2" ) static inline __m256i BroadcastAlphaAVX2 ( __m256i x )
+    {
+        return _mm256_shufflehi_epi16 ( _mm256_shufflelo_epi16 ( x, _MM_SHUFFLE ( 3, 3, 3, 3 ) ), _MM_SHUFFLE ( 3, 3, 3, 3 ) );
+    }
+
+    template<bool Premultiplied>
+    AEONGUI_TARGET ( "avx2" ) static inline __m256i BlendPairAVX2 ( __m256i aSource, __m256i aDestination, __m256i aOpacity )
+    {
+        const __m256i full = _mm256_set1_epi16 ( 255 );
+        if ( Premultiplied )
+        {
+            aSource = Div255AVX2 ( _mm256_mullo_epi16 ( aSource, aOpacity ) );
+            const __m256i inverse = _mm256_sub_epi16 ( full, BroadcastAlphaAVX2 ( aSource ) );
+            return _mm256_add_epi16 ( aSource, Div255AVX2 ( _mm256_mullo_epi16 ( aDestination, inverse ) ) );
+        }
+        const __m256i alpha_lanes = _mm256_set_epi16 ( -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0 );
+        const __m256i alpha = Div255AVX2 ( _mm256_mullo_epi16 ( BroadcastAlphaAVX2 ( aSource ), aOpacity ) );
+        aSource = _mm256_or_si256 ( _mm256_andnot_si256 ( alpha_lanes, aSource ), _mm256_and_si256 ( alpha_lanes, full ) );
+        return Div255AVX2 ( _mm256_add_epi16 ( _mm256_mullo_epi16 ( aSource, alpha ), _mm256_mullo_epi16 ( aDestination, _mm256_sub_epi16 ( full, alpha ) ) ) );
+    }
+
+    // Unpack and pack both work within 128 bit lanes, so pixel order is preserved.
+    template<bool Premultiplied>
+    AEONGUI_TARGET ( "avx2" ) static void BlendRowAVX2 ( const Color* aSource, Color* aDestination, size_t aCount, uint8_t aOpacity )
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i alpha_mask = _mm256_set1_epi32 ( static_cast<int> ( 0xff000000 ) );
+        const __m256i opacity = _mm256_set1_epi16 ( aOpacity );
+        size_t i = 0;
+        for ( ; i + 8 <= aCount; i += 8 )
+        {
+            const __m256i source = _mm256_loadu_si256 ( reinterpret_cast<const __m256i*> ( aSource + i ) );
+            const __m256i alpha = _mm256_and_si256 ( source, alpha_mask );
+            if ( _mm256_movemask_epi8 ( _mm256_cmpeq_epi32 ( Premultiplied ? source : alpha, zero ) ) == -1 )
+            {
+                continue;
+            }
+            if ( aOpacity == 255 && _mm256_movemask_epi8 ( _mm256_cmpeq_epi32 ( alpha, alpha_mask ) ) == -1 )
+            {
+                _mm256_storeu_si256 ( reinterpret_cast<__m256i*> ( aDestination + i ), source );
+                continue;
+            }
+            const __m256i destination = _mm256_loadu_si256 ( reinterpret_cast<const __m256i*> ( aDestination + i ) );
+            const __m256i low = BlendPairAVX2<Premultiplied> ( _mm256_unpacklo_epi8 ( source, zero ), _mm256_unpacklo_epi8 ( destination, zero ), opacity );
+            const __m256i high = BlendPairAVX2<Premultiplied> ( _mm256_unpackhi_epi8 ( source, zero ), _mm256_unpackhi_epi8 ( destination, zero ), opacity );
+            _mm256_storeu_si256 ( reinterpret_cast<__m256i*> ( aDestination + i ), _mm256_packus_epi16 ( low, high ) );
+        }
+        BlendRowSSE2<Premultiplied> ( aSource + i, aDestination + i, aCount - i, aOpacity );
+    }
+#elif defined(AEONGUI_NEON)
+    static inline uint8x8_t Div255NEON ( uint16x8_t x )
+    {
+        x = vaddq_u16 ( x, vdupq_n_u16 ( 128 ) );
+        return vshrn_n_u16 ( vaddq_u16 ( x, vshrq_n_u16 ( x, 8 ) ), 8 );
+    }
+
+    // Structured loads split 8 pixels into one register per component.
+    template<bool Premultiplied>
+    static void BlendRowNEON ( const Color* aSource, Color* aDestination, size_t aCount, uint8_t aOpacity )
+    {
+        const uint8x8_t full = vdup_n_u8 ( 255 );
+        const uint8x8_t opacity = vdup_n_u8 ( aOpacity );
+        size_t i = 0;
+        for ( ; i + 8 <= aCount; i += 8 )
+        {
+            uint8x8x4_t source = vld4_u8 ( reinterpret_cast<const uint8_t*> ( aSource + i ) );
+            uint8x8x4_t destination = vld4_u8 ( reinterpret_cast<const uint8_t*> ( aDestination + i ) );
+            if ( Premultiplied )
+            {
+                for ( int c = 0; c < 4; ++c )
+                {
+                    source.val[c] = Div255NEON ( vmull_u8 ( source.val[c], opacity ) );
+                }
+                const uint8x8_t inverse = vsub_u8 ( full, source.val[3] );
+                for ( int c = 0; c < 4; ++c )
+                {
+                    destination.val[c] = vqadd_u8 ( source.val[c], Div255NEON ( vmull_u8 ( destination.val[c], inverse ) ) );
+                }
+            }
+            else
+            {
+                const uint8x8_t alpha = Div255NEON ( vmull_u8 ( source.val[3], opacity ) );
+                const uint8x8_t inverse = vsub_u8 ( full, alpha );
+                source.val[3] = full;
+                for ( int c = 0; c < 4; ++c )
+                {
+                    destination.val[c] = Div255NEON ( vmlal_u8 ( vmull_u8 ( source.val[c], alpha ), destination.val[c], inverse ) );
+                }
+            }
+            vst4_u8 ( reinterpret_cast<uint8_t*> ( aDestination + i ), destination );
+        }
+        if ( Premultiplied )
+        {
+            BlendRowPremultiplied ( aSource + i, aDestination + i, aCount - i, aOpacity );
+        }
+        else
+        {
+            BlendRowStraight ( aSource + i, aDestination + i, aCount - i, aOpacity );
+        }
+    }
+#endif
+
+    // Indexed by AlphaMode.
+    static std::array<BlendRowKernel, 2> SelectBlendRowKernels()
+    {
+#if defined(AEONGUI_X86)
+        if ( HasCpuFeature ( CPU_AVX2 ) )
+        {
+            return {BlendRowAVX2<false>, BlendRowAVX2<true>};
+        }
+        if ( HasCpuFeature ( CPU_SSE2 ) )
+        {
+            return {BlendRowSSE2<false>, BlendRowSSE2<true>};
+        }
+#elif defined(AEONGUI_NEON)
+        if ( HasCpuFeature ( CPU_NEON ) )
+        {
+            return {BlendRowNEON<false>, BlendRowNEON<true>};
+        }
+#endif
+        return {BlendRowStraight, BlendRowPremultiplied};
+    }
+
+    static BlendRowKernel GetBlendRowKernel ( AlphaMode aMode )
+    {
+        static const std::array<BlendRowKernel, 2> kernels{SelectBlendRowKernels() };
+        return kernels[static_cast<size_t> ( aMode )];
+    }
+
+    void BlendRow ( const Color* aSource, Color* aDestination, size_t aCount, AlphaMode aMode, uint8_t aOpacity )
+    {
+        if ( aOpacity == 0 )
+        {
+            return;
+        }
+        GetBlendRowKernel ( aMode ) ( aSource, aDestination, aCount, aOpacity );
+    }
+
+    void Blend ( const Color* aSource, size_t aSourcePitch, Color* aDestination, size_t aDestinationPitch,
+                 uint32_t aWidth, uint32_t aHeight, AlphaMode aMode, uint8_t aOpacity )
+    {
+        if ( aOpacity == 0 )
+        {
+            return;
+        }
+        BlendRowKernel blend = GetBlendRowKernel ( aMode );
+        for ( uint32_t y = 0; y < aHeight; ++y )
+        {
+            blend ( reinterpret_cast<const Color*> ( reinterpret_cast<const uint8_t*> ( aSource ) + ( y * aSourcePitch ) ),
+                    reinterpret_cast<Color*> ( reinterpret_cast<uint8_t*> ( aDestination ) + ( y * aDestinationPitch ) ),
+                    aWidth, aOpacity );
+        }
+    }
+
+    void Fill ( Color aColor, Color* aDestination, size_t aDestinationPitch, uint32_t aWidth, uint32_t aHeight, AlphaMode aMode )
+    {
+        if ( aColor.a == 0 && ( aMode == AlphaMode::STRAIGHT || aColor.bgra == 0 ) )
+        {
+            return;
+        }
+        if ( aColor.a == 255 )
+        {
+            for ( uint32_t y = 0; y < aHeight; ++y )
+            {
+                Color* row = reinterpret_cast<Color*> ( reinterpret_cast<uint8_t*> ( aDestination ) + ( y * aDestinationPitch ) );
+                std::fill_n ( row, aWidth, aColor );
+            }
+            return;
+        }
+        // Blend from a short row of the color so the row kernels can be reused.
+        std::array<Color, 64> source;
+        source.fill ( aColor );
+        BlendRowKernel blend = GetBlendRowKernel ( aMode );
+        for ( uint32_t y = 0; y < aHeight; ++y )
+        {
+            Color* row = reinterpret_cast<Color*> ( reinterpret_cast<uint8_t*> ( aDestination ) + ( y * aDestinationPitch ) );
+            for ( uint32_t x = 0; x < aWidth; x += static_cast<uint32_t> ( source.size() ) )
+            {
+                blend ( source.data(), row + x, std::min<size_t> ( source.size(), aWidth - x ), 255 );
+            }
+        }
+    }
+}
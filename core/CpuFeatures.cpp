@@ -0,0 +1,86 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "aeongui/CpuFeatures.h"
+#if defined(AEONGUI_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace AeonGUI
+{
+    static uint32_t DetectCpuFeatures()
+    {
+        uint32_t features{};
+#if defined(AEONGUI_X86)
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid ( info, 0 );
+        const int max_leaf = info[0];
+        __cpuid ( info, 1 );
+        if ( info[3] & ( 1 << 26 ) )
+        {
+            features |= CPU_SSE2;
+        }
+        if ( info[2] & ( 1 << 9 ) )
+        {
+            features |= CPU_SSSE3;
+        }
+        if ( info[2] & ( 1 << 19 ) )
+        {
+            features |= CPU_SSE41;
+        }
+        // AVX2 also requires the OS to save YMM registers on context switches.
+        const bool os_avx = ( info[2] & ( 1 << 27 ) ) && ( ( _xgetbv ( 0 ) & 6 ) == 6 );
+        if ( os_avx && max_leaf >= 7 )
+        {
+            __cpuidex ( info, 7, 0 );
+            if ( info[1] & ( 1 << 5 ) )
+            {
+                features |= CPU_AVX2;
+            }
+        }
+#else
+        __builtin_cpu_init();
+        if ( __builtin_cpu_supports ( "sse2" ) )
+        {
+            features |= CPU_SSE2;
+        }
+        if ( __builtin_cpu_supports ( "ssse3" ) )
+        {
+            features |= CPU_SSSE3;
+        }
+        if ( __builtin_cpu_supports ( "sse4.1" ) )
+        {
+            features |= CPU_SSE41;
+        }
+        if ( __builtin_cpu_supports ( "avx2" ) )
+        {
+            features |= CPU_AVX2;
+        }
+#endif
+#elif defined(AEONGUI_NEON)
+        // NEON is mandatory on AArch64 and assumed when the compiler targets it.
+        features |= CPU_NEON;
+#endif
+        return features;
+    }
+
+    uint32_t GetCpuFeatures()
+    {
+        static const uint32_t features{DetectCpuFeatures() };
+        return features;
+    }
+}
@@ -0,0 +1,164 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <future>
+#include <cstdio>
+#include "DOMBridge.h"
+#include "aeongui/Document.h"
+#include "dom/Element.h"
+
+namespace AeonGUI
+{
+    std::string ColorToString ( const Color& aColor )
+    {
+        char buffer[10];
+        if ( aColor.a == 0xff )
+        {
+            std::snprintf ( buffer, sizeof ( buffer ), "#%02x%02x%02x", aColor.r, aColor.g, aColor.b );
+        }
+        else
+        {
+            std::snprintf ( buffer, sizeof ( buffer ), "#%02x%02x%02x%02x", aColor.a, aColor.r, aColor.g, aColor.b );
+        }
+        return buffer;
+    }
+
+    DOMBridge::~DOMBridge() = default;
+
+    DirectDOMBridge::DirectDOMBridge ( Document* aDocument ) : mDocument{aDocument} {}
+
+    Element* DirectDOMBridge::GetElementById ( const std::string& aId )
+    {
+        return mDocument->getElementById ( aId );
+    }
+
+    Element* DirectDOMBridge::CreateElementNS ( const std::string& aNamespace, const std::string& aQualifiedName )
+    {
+        return mDocument->createElementNS ( aNamespace, aQualifiedName );
+    }
+
+    /*  Writes to elements in a document are queued and applied before the next draw,
+        detached elements are not drawn so they are written right away. */
+    void DirectDOMBridge::SetAttribute ( Element* aElement, const std::string& aName, const std::string& aValue )
+    {
+        if ( Document* document = aElement->ownerDocument() )
+        {
+            document->QueueAttribute ( aElement, aName, aValue );
+        }
+        else
+        {
+            aElement->SetAttribute ( aName.c_str(), aValue );
+            aElement->OnAttributesChanged();
+        }
+    }
+
+    AttributeType DirectDOMBridge::GetAttribute ( Element* aElement, const std::string& aName )
+    {
+        if ( Document* document = aElement->ownerDocument() )
+        {
+            if ( const std::string* value = document->GetPendingAttribute ( aElement, aName ) )
+            {
+                return *value;
+            }
+        }
+        return aElement->GetAttribute ( aName.c_str() );
+    }
+
+    void DirectDOMBridge::AppendChild ( Element* aParent, Element* aChild )
+    {
+        // Appending an element to itself or to one of its descendants would make a cycle.
+        for ( const Node* ancestor = aParent; ancestor != nullptr; ancestor = ancestor->parentNode() )
+        {
+            if ( ancestor == aChild )
+            {
+                return;
+            }
+        }
+        if ( Node* parent = aChild->parentNode() )
+        {
+            parent->RemoveNode ( aChild );
+        }
+        aParent->AddNode ( aChild );
+    }
+
+    QueuedDOMBridge::QueuedDOMBridge ( Document* aDocument ) : mTarget{aDocument} {}
+
+    /*  The caller blocks until the document thread has run the call,
+        so capturing its locals by reference is safe. */
+    template<class R, class F> R QueuedDOMBridge::Call ( F&& aFunction )
+    {
+        std::promise<R> promise;
+        std::future<R> future = promise.get_future();
+        mCommands.Push ( [&promise, &aFunction]()
+        {
+            promise.set_value ( aFunction() );
+        } );
+        return future.get();
+    }
+
+    Element* QueuedDOMBridge::GetElementById ( const std::string& aId )
+    {
+        return Call<Element*> ( [this, &aId]()
+        {
+            return mTarget.GetElementById ( aId );
+        } );
+    }
+
+    Element* QueuedDOMBridge::CreateElementNS ( const std::string& aNamespace, const std::string& aQualifiedName )
+    {
+        return Call<Element*> ( [this, &aNamespace, &aQualifiedName]()
+        {
+            return mTarget.CreateElementNS ( aNamespace, aQualifiedName );
+        } );
+    }
+
+    void QueuedDOMBridge::SetAttribute ( Element* aElement, const std::string& aName, const std::string& aValue )
+    {
+        mCommands.Push ( [this, aElement, aName, aValue]()
+        {
+            mTarget.SetAttribute ( aElement, aName, aValue );
+        } );
+    }
+
+    AttributeType QueuedDOMBridge::GetAttribute ( Element* aElement, const std::string& aName )
+    {
+        return Call<AttributeType> ( [this, aElement, &aName]()
+        {
+            return mTarget.GetAttribute ( aElement, aName );
+        } );
+    }
+
+    void QueuedDOMBridge::AppendChild ( Element* aParent, Element* aChild )
+    {
+        mCommands.Push ( [this, aParent, aChild]()
+        {
+            mTarget.AppendChild ( aParent, aChild );
+        } );
+    }
+
+    void QueuedDOMBridge::ProcessCommands()
+    {
+        while ( std::optional<std::function<void() >> command = mCommands.Pop() )
+        {
+            ( *command ) ();
+        }
+    }
+
+    bool QueuedDOMBridge::HasPendingCommands() const
+    {
+        return !mCommands.Empty();
+    }
+}
@@ -0,0 +1,87 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGUI_DOMBRIDGE_H
+#define AEONGUI_DOMBRIDGE_H
+#include <string>
+#include <functional>
+#include "aeongui/AttributeMap.h"
+#include "aeongui/CommandQueue.h"
+
+namespace AeonGUI
+{
+    class Document;
+    class Element;
+    union Color;
+
+    /** Formats a color the way getAttribute returns it, #rrggbb or #aarrggbb when not opaque. */
+    std::string ColorToString ( const Color& aColor );
+
+    /** The document operations exposed to scripts.
+     *  Script engines bind to a bridge rather than to the Document
+     *  so scripts can run on a thread other than the one that owns the document. */
+    class DOMBridge
+    {
+    public:
+        virtual Element* GetElementById ( const std::string& aId ) = 0;
+        virtual Element* CreateElementNS ( const std::string& aNamespace, const std::string& aQualifiedName ) = 0;
+        virtual void SetAttribute ( Element* aElement, const std::string& aName, const std::string& aValue ) = 0;
+        /** @return The attribute value, a pending write is returned as its unparsed string. */
+        virtual AttributeType GetAttribute ( Element* aElement, const std::string& aName ) = 0;
+        /** Appends aChild to aParent, moving it out of its current parent if it has one.
+         *  Nothing changes if aChild is aParent or one of its ancestors. */
+        virtual void AppendChild ( Element* aParent, Element* aChild ) = 0;
+        virtual ~DOMBridge();
+    };
+
+    /** Works on the document directly, for scripts running on the document thread. */
+    class DirectDOMBridge : public DOMBridge
+    {
+    public:
+        DirectDOMBridge ( Document* aDocument );
+        Element* GetElementById ( const std::string& aId ) final;
+        Element* CreateElementNS ( const std::string& aNamespace, const std::string& aQualifiedName ) final;
+        void SetAttribute ( Element* aElement, const std::string& aName, const std::string& aValue ) final;
+        AttributeType GetAttribute ( Element* aElement, const std::string& aName ) final;
+        void AppendChild ( Element* aParent, Element* aChild ) final;
+    private:
+        Document* mDocument{};
+    };
+
+    /** Sends calls from a script thread to the document thread.
+     *
+     *  Writes are queued and return at once, reads wait until the document thread
+     *  runs the queue with ProcessCommands, so a script sees its own earlier writes.
+     *  Element pointers are only handles on the script thread, they are never dereferenced there. */
+    class QueuedDOMBridge : public DOMBridge
+    {
+    public:
+        QueuedDOMBridge ( Document* aDocument );
+        Element* GetElementById ( const std::string& aId ) final;
+        Element* CreateElementNS ( const std::string& aNamespace, const std::string& aQualifiedName ) final;
+        void SetAttribute ( Element* aElement, const std::string& aName, const std::string& aValue ) final;
+        AttributeType GetAttribute ( Element* aElement, const std::string& aName ) final;
+        void AppendChild ( Element* aParent, Element* aChild ) final;
+        /** Runs the queued calls, document thread only. */
+        void ProcessCommands();
+        /** @return true if calls are waiting, document thread only. */
+        bool HasPendingCommands() const;
+    private:
+        template<class R, class F> R Call ( F&& aFunction );
+        DirectDOMBridge mTarget;
+        CommandQueue<std::function<void() >> mCommands{};
+    };
+}
+#endif
@@ -0,0 +1,351 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "aeongui/CpuFeatures.h"
+#include "aeongui/Compositing.h"
+#include "aeongui/DistanceField.h"
+#if defined(AEONGUI_X86)
+#include <emmintrin.h>
+#elif defined(AEONGUI_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace AeonGUI
+{
+    static constexpr float Far = 1e20f;
+
+    /*  Felzenszwalb and Huttenlocher squared distance transform of a sampled function,
+        the lower envelope of the parabolas rooted at each sample is built in linear time. */
+    static void DistanceTransform ( const float* aFunction, size_t aStride, size_t aCount, float* aResult, int32_t* aVertices, float* aBounds )
+    {
+        size_t k = 0;
+        aVertices[0] = 0;
+        aBounds[0] = -Far;
+        aBounds[1] = Far;
+        for ( size_t q = 1; q < aCount; ++q )
+        {
+            const float fq = aFunction[q * aStride] + static_cast<float> ( q * q );
+            const int32_t position = static_cast<int32_t> ( q );
+            auto intersection = [&] ( int32_t v )
+            {
+                return ( fq - ( aFunction[v * aStride] + static_cast<float> ( v * v ) ) ) / static_cast<float> ( 2 * ( position - v ) );
+            };
+            // Bounds[0] is far below any intersection, so k never underflows.
+            float s = intersection ( aVertices[k] );
+            while ( s <= aBounds[k] )
+            {
+                --k;
+                s = intersection ( aVertices[k] );
+            }
+            ++k;
+            aVertices[k] = position;
+            aBounds[k] = s;
+            aBounds[k + 1] = Far;
+        }
+        k = 0;
+        for ( size_t q = 0; q < aCount; ++q )
+        {
+            while ( aBounds[k + 1] < static_cast<float> ( q ) )
+            {
+                ++k;
+            }
+            const float distance = static_cast<float> ( q ) - static_cast<float> ( aVertices[k] );
+            aResult[q] = ( distance * distance ) + aFunction[aVertices[k] * aStride];
+        }
+    }
+
+    // In place squared distance from every texel to the nearest zero texel, columns then rows.
+    static void DistanceTransform2D ( std::vector<float>& aGrid, size_t aWidth, size_t aHeight )
+    {
+        const size_t count = std::max ( aWidth, aHeight );
+        std::vector<float> result ( count );
+        std::vector<int32_t> vertices ( count );
+        std::vector<float> bounds ( count + 1 );
+        for ( size_t x = 0; x < aWidth; ++x )
+        {
+            DistanceTransform ( aGrid.data() + x, aWidth, aHeight, result.data(), vertices.data(), bounds.data() );
+            for ( size_t y = 0; y < aHeight; ++y )
+            {
+                aGrid[ ( y * aWidth ) + x] = result[y];
+            }
+        }
+        for ( size_t y = 0; y < aHeight; ++y )
+        {
+            DistanceTransform ( aGrid.data() + ( y * aWidth ), 1, aWidth, result.data(), vertices.data(), bounds.data() );
+            std::copy ( result.begin(), result.begin() + aWidth, aGrid.begin() + ( y * aWidth ) );
+        }
+    }
+
+    void GenerateDistanceField ( const uint8_t* aCoverage, size_t aCoveragePitch,
+                                 uint8_t* aField, size_t aFieldPitch, uint32_t aFieldWidth, uint32_t aFieldHeight,
+                                 uint32_t aOversample, float aSpread )
+    {
+        const size_t width = static_cast<size_t> ( aFieldWidth ) * aOversample;
+        const size_t height = static_cast<size_t> ( aFieldHeight ) * aOversample;
+        std::vector<float> outside ( width * height );
+        std::vector<float> inside ( width * height );
+        for ( size_t y = 0; y < height; ++y )
+        {
+            for ( size_t x = 0; x < width; ++x )
+            {
+                const bool covered = aCoverage[ ( y * aCoveragePitch ) + x] >= 128;
+                outside[ ( y * width ) + x] = covered ? 0.0f : Far;
+                inside[ ( y * width ) + x] = covered ? Far : 0.0f;
+            }
+        }
+        DistanceTransform2D ( outside, width, height );
+        DistanceTransform2D ( inside, width, height );
+        // The outline lies half a texel from the centers of the texels on either side of it.
+        auto signed_distance = [&] ( size_t x, size_t y )
+        {
+            const size_t i = ( y * width ) + x;
+            return ( inside[i] > 0.0f ) ? ( std::sqrt ( inside[i] ) - 0.5f ) : -( std::sqrt ( outside[i] ) - 0.5f );
+        };
+        const float scale = 127.0f / ( aSpread * static_cast<float> ( aOversample ) );
+        // Even oversampling puts the block center between four texels, average them.
+        const size_t low = ( aOversample - 1 ) / 2;
+        const size_t high = aOversample / 2;
+        for ( uint32_t y = 0; y < aFieldHeight; ++y )
+        {
+            for ( uint32_t x = 0; x < aFieldWidth; ++x )
+            {
+                const size_t cx = static_cast<size_t> ( x ) * aOversample;
+                const size_t cy = static_cast<size_t> ( y ) * aOversample;
+                const float distance = 0.25f * ( signed_distance ( cx + low, cy + low ) + signed_distance ( cx + high, cy + low ) +
+                                                 signed_distance ( cx + low, cy + high ) + signed_distance ( cx + high, cy + high ) );
+                aField[ ( y * aFieldPitch ) + x] = static_cast<uint8_t> ( std::clamp ( 128.0f + ( distance * scale ), 0.0f, 255.0f ) + 0.5f );
+            }
+        }
+    }
+
+    DistanceFieldAtlas::DistanceFieldAtlas ( uint32_t aWidth, uint32_t aHeight, uint32_t aBaseSize, uint32_t aSpread ) :
+        mPacker{aWidth, aHeight, 1},
+        mBaseSize{aBaseSize},
+        mSpread{aSpread},
+        mBitmap ( static_cast<size_t> ( aWidth ) * aHeight, 0 )
+    {
+    }
+
+    bool DistanceFieldAtlas::Add ( uint32_t aCodepoint, const uint8_t* aCoverage, size_t aPitch, uint32_t aWidth, uint32_t aHeight,
+                                   int32_t aLeft, int32_t aTop, float aAdvance, uint32_t aOversample )
+    {
+        aOversample = std::max ( aOversample, 1u );
+        const float oversample = static_cast<float> ( aOversample );
+        Glyph glyph;
+        glyph.left = ( static_cast<float> ( aLeft ) / oversample ) - static_cast<float> ( mSpread );
+        glyph.top = ( static_cast<float> ( aTop ) / oversample ) + static_cast<float> ( mSpread );
+        glyph.advance = aAdvance / oversample;
+        if ( aWidth == 0 || aHeight == 0 )
+        {
+            mGlyphs[aCodepoint] = glyph;
+            return true;
+        }
+        const uint32_t field_width = ( ( aWidth + aOversample - 1 ) / aOversample ) + ( 2 * mSpread );
+        const uint32_t field_height = ( ( aHeight + aOversample - 1 ) / aOversample ) + ( 2 * mSpread );
+        if ( !mPacker.Insert ( field_width, field_height, glyph.region ) )
+        {
+            return false;
+        }
+        // Pad the coverage with the spread border so the field falls off all around the glyph.
+        const size_t padded_width = static_cast<size_t> ( field_width ) * aOversample;
+        const size_t padded_height = static_cast<size_t> ( field_height ) * aOversample;
+        const size_t border = static_cast<size_t> ( mSpread ) * aOversample;
+        std::vector<uint8_t> padded ( padded_width * padded_height, 0 );
+        for ( uint32_t y = 0; y < aHeight; ++y )
+        {
+            memcpy ( padded.data() + ( ( border + y ) * padded_width ) + border, aCoverage + ( y * aPitch ), aWidth );
+        }
+        GenerateDistanceField ( padded.data(), padded_width,
+                                mBitmap.data() + ( static_cast<size_t> ( glyph.region.GetY() ) * GetWidth() ) + glyph.region.GetX(), GetWidth(),
+                                field_width, field_height, aOversample, static_cast<float> ( mSpread ) );
+        mGlyphs[aCodepoint] = glyph;
+        return true;
+    }
+
+    const DistanceFieldAtlas::Glyph* DistanceFieldAtlas::GetGlyph ( uint32_t aCodepoint ) const
+    {
+        auto i = mGlyphs.find ( aCodepoint );
+        return ( i != mGlyphs.end() ) ? &i->second : nullptr;
+    }
+
+    // Vertical interpolation between two field rows into floats.
+    static void LerpRows ( const uint8_t* aTop, const uint8_t* aBottom, float aFraction, float* aResult, uint32_t aCount )
+    {
+        uint32_t x = 0;
+#if defined(AEONGUI_X86)
+        const __m128i zero = _mm_setzero_si128();
+        const __m128 fraction = _mm_set1_ps ( aFraction );
+        for ( ; x + 4 <= aCount; x += 4 )
+        {
+            int32_t top_bytes, bottom_bytes;
+            memcpy ( &top_bytes, aTop + x, 4 );
+            memcpy ( &bottom_bytes, aBottom + x, 4 );
+            const __m128 top = _mm_cvtepi32_ps ( _mm_unpacklo_epi16 ( _mm_unpacklo_epi8 ( _mm_cvtsi32_si128 ( top_bytes ), zero ), zero ) );
+            const __m128 bottom = _mm_cvtepi32_ps ( _mm_unpacklo_epi16 ( _mm_unpacklo_epi8 ( _mm_cvtsi32_si128 ( bottom_bytes ), zero ), zero ) );
+            _mm_storeu_ps ( aResult + x, _mm_add_ps ( top, _mm_mul_ps ( _mm_sub_ps ( bottom, top ), fraction ) ) );
+        }
+#elif defined(AEONGUI_NEON)
+        for ( ; x + 8 <= aCount; x += 8 )
+        {
+            const uint16x8_t top = vmovl_u8 ( vld1_u8 ( aTop + x ) );
+            const uint16x8_t bottom = vmovl_u8 ( vld1_u8 ( aBottom + x ) );
+            for ( int i = 0; i < 2; ++i )
+            {
+                const float32x4_t t = vcvtq_f32_u32 ( vmovl_u16 ( i ? vget_high_u16 ( top ) : vget_low_u16 ( top ) ) );
+                const float32x4_t b = vcvtq_f32_u32 ( vmovl_u16 ( i ? vget_high_u16 ( bottom ) : vget_low_u16 ( bottom ) ) );
+                vst1q_f32 ( aResult + x + ( i * 4 ), vaddq_f32 ( t, vmulq_n_f32 ( vsubq_f32 ( b, t ), aFraction ) ) );
+            }
+        }
+#endif
+        for ( ; x < aCount; ++x )
+        {
+            const float top = aTop[x];
+            aResult[x] = top + ( ( static_cast<float> ( aBottom[x] ) - top ) * aFraction );
+        }
+    }
+
+    /*  Field values to source pixels, coverage is the screen space distance to the outline
+        plus one half, clamped to [0,1], which gives a one pixel wide antialiasing ramp. */
+    static void CoverageRow ( const float* aValues, uint32_t aCount, float aDistanceScale, Color aColor, Color* aResult )
+    {
+        const float alpha = aColor.a;
+        const uint32_t rgb = aColor.bgra & 0x00ffffff;
+        uint32_t x = 0;
+#if defined(AEONGUI_X86)
+        const __m128 edge = _mm_set1_ps ( 128.0f );
+        const __m128 scale = _mm_set1_ps ( aDistanceScale );
+        const __m128 half = _mm_set1_ps ( 0.5f );
+        const __m128 one = _mm_set1_ps ( 1.0f );
+        const __m128 maximum = _mm_set1_ps ( alpha );
+        const __m128i color = _mm_set1_epi32 ( static_cast<int32_t> ( rgb ) );
+        for ( ; x + 4 <= aCount; x += 4 )
+        {
+            __m128 coverage = _mm_add_ps ( _mm_mul_ps ( _mm_sub_ps ( _mm_loadu_ps ( aValues + x ), edge ), scale ), half );
+            coverage = _mm_min_ps ( _mm_max_ps ( coverage, _mm_setzero_ps() ), one );
+            const __m128i a = _mm_cvttps_epi32 ( _mm_add_ps ( _mm_mul_ps ( coverage, maximum ), half ) );
+            _mm_storeu_si128 ( reinterpret_cast<__m128i*> ( aResult + x ), _mm_or_si128 ( color, _mm_slli_epi32 ( a, 24 ) ) );
+        }
+#elif defined(AEONGUI_NEON)
+        const uint32x4_t color = vdupq_n_u32 ( rgb );
+        for ( ; x + 4 <= aCount; x += 4 )
+        {
+            float32x4_t coverage = vaddq_f32 ( vmulq_n_f32 ( vsubq_f32 ( vld1q_f32 ( aValues + x ), vdupq_n_f32 ( 128.0f ) ), aDistanceScale ), vdupq_n_f32 ( 0.5f ) );
+            coverage = vminq_f32 ( vmaxq_f32 ( coverage, vdupq_n_f32 ( 0.0f ) ), vdupq_n_f32 ( 1.0f ) );
+            const uint32x4_t a = vcvtq_u32_f32 ( vaddq_f32 ( vmulq_n_f32 ( coverage, alpha ), vdupq_n_f32 ( 0.5f ) ) );
+            vst1q_u32 ( reinterpret_cast<uint32_t*> ( aResult + x ), vorrq_u32 ( color, vshlq_n_u32 ( a, 24 ) ) );
+        }
+#endif
+        for ( ; x < aCount; ++x )
+        {
+            const float coverage = std::min ( std::max ( ( ( aValues[x] - 128.0f ) * aDistanceScale ) + 0.5f, 0.0f ), 1.0f );
+            aResult[x].bgra = rgb | ( static_cast<uint32_t> ( ( coverage * alpha ) + 0.5f ) << 24 );
+        }
+    }
+
+    void DistanceFieldAtlas::DrawGlyph ( const Glyph& aGlyph, float aX, float aY, float aScale, Color aColor,
+                                         Color* aDestination, size_t aDestinationPitch, uint32_t aDestinationWidth, uint32_t aDestinationHeight ) const
+    {
+        const uint32_t field_width = aGlyph.region.GetWidth();
+        const uint32_t field_height = aGlyph.region.GetHeight();
+        const float left = aX + ( aGlyph.left * aScale );
+        const float top = aY - ( aGlyph.top * aScale );
+        const int32_t x_begin = std::max ( static_cast<int32_t> ( std::floor ( left ) ), 0 );
+        const int32_t y_begin = std::max ( static_cast<int32_t> ( std::floor ( top ) ), 0 );
+        const int32_t x_end = std::min ( static_cast<int32_t> ( std::ceil ( left + ( field_width * aScale ) ) ), static_cast<int32_t> ( aDestinationWidth ) );
+        const int32_t y_end = std::min ( static_cast<int32_t> ( std::ceil ( top + ( field_height * aScale ) ) ), static_cast<int32_t> ( aDestinationHeight ) );
+        if ( x_begin >= x_end || y_begin >= y_end )
+        {
+            return;
+        }
+        const uint32_t count = static_cast<uint32_t> ( x_end - x_begin );
+        // Horizontal sample positions are the same for every row.
+        std::vector<uint32_t> columns ( count * 2 );
+        std::vector<float> fractions ( count );
+        for ( uint32_t i = 0; i < count; ++i )
+        {
+            const float u = std::clamp ( ( ( static_cast<float> ( x_begin + static_cast<int32_t> ( i ) ) + 0.5f - left ) / aScale ) - 0.5f, 0.0f, static_cast<float> ( field_width - 1 ) );
+            columns[i * 2] = static_cast<uint32_t> ( u );
+            columns[ ( i * 2 ) + 1] = std::min ( columns[i * 2] + 1, field_width - 1 );
+            fractions[i] = u - static_cast<float> ( columns[i * 2] );
+        }
+        std::vector<float> rows ( field_width );
+        std::vector<float> values ( count );
+        std::vector<Color> source ( count );
+        const float distance_scale = ( static_cast<float> ( mSpread ) * aScale ) / 127.0f;
+        const uint8_t* field = mBitmap.data() + ( static_cast<size_t> ( aGlyph.region.GetY() ) * GetWidth() ) + aGlyph.region.GetX();
+        for ( int32_t y = y_begin; y < y_end; ++y )
+        {
+            const float v = std::clamp ( ( ( static_cast<float> ( y ) + 0.5f - top ) / aScale ) - 0.5f, 0.0f, static_cast<float> ( field_height - 1 ) );
+            const uint32_t row = static_cast<uint32_t> ( v );
+            LerpRows ( field + ( row * GetWidth() ), field + ( std::min ( row + 1, field_height - 1 ) * GetWidth() ), v - static_cast<float> ( row ), rows.data(), field_width );
+            for ( uint32_t i = 0; i < count; ++i )
+            {
+                const float first = rows[columns[i * 2]];
+                values[i] = first + ( ( rows[columns[ ( i * 2 ) + 1]] - first ) * fractions[i] );
+            }
+            CoverageRow ( values.data(), count, distance_scale, aColor, source.data() );
+            BlendRow ( source.data(), reinterpret_cast<Color*> ( reinterpret_cast<uint8_t*> ( aDestination ) + ( y * aDestinationPitch ) ) + x_begin, count, AlphaMode::STRAIGHT );
+        }
+    }
+
+    float DistanceFieldAtlas::DrawText ( std::u32string_view aText, float aX, float aY, float aSize, Color aColor,
+                                         Color* aDestination, size_t aDestinationPitch, uint32_t aDestinationWidth, uint32_t aDestinationHeight ) const
+    {
+        const float scale = aSize / static_cast<float> ( mBaseSize );
+        for ( char32_t i : aText )
+        {
+            const Glyph* glyph = GetGlyph ( static_cast<uint32_t> ( i ) );
+            if ( glyph == nullptr )
+            {
+                continue;
+            }
+            if ( glyph->region.GetWidth() != 0 )
+            {
+                DrawGlyph ( *glyph, aX, aY, scale, aColor, aDestination, aDestinationPitch, aDestinationWidth, aDestinationHeight );
+            }
+            aX += glyph->advance * scale;
+        }
+        return aX;
+    }
+
+    const uint8_t* DistanceFieldAtlas::GetBitmap() const
+    {
+        return mBitmap.data();
+    }
+
+    uint32_t DistanceFieldAtlas::GetWidth() const
+    {
+        return mPacker.GetWidth();
+    }
+
+    uint32_t DistanceFieldAtlas::GetHeight() const
+    {
+        return mPacker.GetHeight();
+    }
+
+    uint32_t DistanceFieldAtlas::GetBaseSize() const
+    {
+        return mBaseSize;
+    }
+
+    uint32_t DistanceFieldAtlas::GetSpread() const
+    {
+        return mSpread;
+    }
+}
@@ -25,26 +25,15 @@ limitations under the License.
 
 namespace AeonGUI
 {
-    static const std::regex number{"-?([0-9]+|[0-9]*\\.[0-9]+([eE][-+]?[0-9]+)?)"};
     static AttributeMap ExtractElementAttributes ( xmlElementPtr aXmlElementPtr )
     {
         AttributeMap attribute_map{};
         for ( xmlNodePtr attribute = reinterpret_cast<xmlNodePtr> ( aXmlElementPtr->attributes ); attribute; attribute = attribute->next )
         {
-            std::cmatch match;
-            const char* value = reinterpret_cast<const char*> ( xmlGetProp ( reinterpret_cast<xmlNodePtr> ( aXmlElementPtr ), attribute->name ) );
-            if ( std::regex_match ( value, match, number ) )
-            {
-                attribute_map[reinterpret_cast<const char*> ( attribute->name )] = std::stod ( match[0].str() );
-            }
-            else if ( std::regex_match ( value, match, Color::ColorRegex ) )
-            {
-                attribute_map[reinterpret_cast<const char*> ( attribute->name )] = Color{match[0].str() };
-            }
-            else
-            {
-                attribute_map[reinterpret_cast<const char*> ( attribute->name )] = value;
-            }
+            const char* name = reinterpret_cast<const char*> ( attribute->name );
+            xmlChar* value = xmlGetProp ( reinterpret_cast<xmlNodePtr> ( aXmlElementPtr ), attribute->name );
+            attribute_map[name] = ParseAttributeValue ( name, reinterpret_cast<const char*> ( value ) );
+            xmlFree ( value );
         }
         return attribute_map;
     }
@@ -76,6 +65,7 @@ namespace AeonGUI
         ///@todo use document->children instead?
         xmlElementPtr root_element = reinterpret_cast<xmlElementPtr> ( xmlDocGetRootElement ( document ) );
         mDocumentElement = Construct ( reinterpret_cast<const char*> ( root_element->name ), ExtractElementAttributes ( root_element ) );
+        mDocumentElement->SetOwnerDocument ( this );
         AddNodes ( mDocumentElement, root_element->children );
         xmlFreeDoc ( document );
         /**@todo Emit onload event.*/
@@ -99,7 +89,42 @@ namespace AeonGUI
         } );
     }
 
-    Document::~Document() = default;
+    /*  Children are deleted before their parents,
+        collecting them first keeps the traversal off deleted nodes. */
+    static void DestroyTree ( Node* aRoot )
+    {
+        std::vector<Node*> nodes;
+        aRoot->TraverseDepthFirstPostOrder ( [&nodes] ( Node * aNode )
+        {
+            nodes.emplace_back ( aNode );
+        } );
+        for ( auto& i : nodes )
+        {
+            delete i;
+        }
+    }
+
+    Document::~Document()
+    {
+        // Created elements added to other created elements go with the root of their subtree.
+        std::vector<Node*> detached;
+        for ( auto& i : mCreatedElements )
+        {
+            if ( i->parentNode() == nullptr )
+            {
+                detached.emplace_back ( i );
+            }
+        }
+        for ( auto& i : detached )
+        {
+            DestroyTree ( i );
+        }
+        if ( mDocumentElement )
+        {
+            DestroyTree ( mDocumentElement );
+        }
+    }
+
     Node* Document::documentElement()
     {
         return mDocumentElement;
@@ -121,4 +146,129 @@ namespace AeonGUI
             return aNode->IsDrawEnabled();
         } );
     }
+
+    Element* Document::getElementById ( const std::string& aElementId ) const
+    {
+        auto i = mIdIndex.find ( aElementId );
+        return ( i != mIdIndex.end() ) ? i->second.front() : nullptr;
+    }
+
+    Element* Document::createElementNS ( const std::string& aNamespace, const std::string& aQualifiedName )
+    {
+        if ( aNamespace != "http://www.w3.org/2000/svg" )
+        {
+            return nullptr;
+        }
+        Node* node = Construct ( aQualifiedName.c_str(), AttributeMap{} );
+        if ( node->nodeType() != Node::ELEMENT_NODE )
+        {
+            delete node;
+            return nullptr;
+        }
+        Element* element = static_cast<Element*> ( node );
+        mCreatedElements.emplace ( element );
+        return element;
+    }
+
+    void Document::ForgetCreatedElement ( Element* aElement )
+    {
+        mCreatedElements.erase ( aElement );
+    }
+
+    /*  Ids should be unique but documents are not validated,
+        elements sharing an id are kept in insertion order so the first one wins
+        and removing it exposes the next one. */
+    void Document::AddToIndex ( Element* aElement )
+    {
+        AttributeType id = aElement->GetAttribute ( "id" );
+        if ( std::holds_alternative<std::string> ( id ) )
+        {
+            mIdIndex[std::get<std::string> ( id )].emplace_back ( aElement );
+        }
+    }
+
+    void Document::RemoveFromIndex ( Element* aElement )
+    {
+        AttributeType id = aElement->GetAttribute ( "id" );
+        if ( std::holds_alternative<std::string> ( id ) )
+        {
+            auto i = mIdIndex.find ( std::get<std::string> ( id ) );
+            if ( i != mIdIndex.end() )
+            {
+                i->second.erase ( std::remove ( i->second.begin(), i->second.end(), aElement ), i->second.end() );
+                if ( i->second.empty() )
+                {
+                    mIdIndex.erase ( i );
+                }
+            }
+        }
+    }
+
+    /*  Only the last write to an attribute matters,
+        a later write replaces the value of an earlier one instead of queuing another. */
+    void Document::QueueAttribute ( Element* aElement, const std::string& aName, const std::string& aValue )
+    {
+        auto i = mPendingIndex.try_emplace ( PendingKey{aElement, aName}, mPendingAttributes.size() );
+        if ( i.second )
+        {
+            mPendingAttributes.emplace_back ( PendingAttribute{aElement, aName, aValue} );
+        }
+        else
+        {
+            mPendingAttributes[i.first->second].value = aValue;
+        }
+    }
+
+    const std::string* Document::GetPendingAttribute ( const Element* aElement, const std::string& aName ) const
+    {
+        auto i = mPendingIndex.find ( PendingKey{aElement, aName} );
+        return ( i != mPendingIndex.end() ) ? &mPendingAttributes[i->second].value : nullptr;
+    }
+
+    void Document::DropPendingAttributes ( const Element* aElement )
+    {
+        auto end = std::remove_if ( mPendingAttributes.begin(), mPendingAttributes.end(),
+                                    [aElement] ( const PendingAttribute & aPendingAttribute )
+        {
+            return aPendingAttribute.element == aElement;
+        } );
+        if ( end == mPendingAttributes.end() )
+        {
+            return;
+        }
+        mPendingAttributes.erase ( end, mPendingAttributes.end() );
+        mPendingIndex.clear();
+        for ( size_t i = 0; i < mPendingAttributes.size(); ++i )
+        {
+            mPendingIndex.emplace ( PendingKey{mPendingAttributes[i].element, mPendingAttributes[i].name}, i );
+        }
+    }
+
+    bool Document::HasPendingAttributes() const
+    {
+        return !mPendingAttributes.empty();
+    }
+
+    void Document::ApplyPendingAttributes()
+    {
+        if ( mPendingAttributes.empty() )
+        {
+            return;
+        }
+        std::vector<Element*> changed;
+        changed.reserve ( mPendingAttributes.size() );
+        for ( auto& i : mPendingAttributes )
+        {
+            i.element->SetAttribute ( i.name.c_str(), i.value );
+            changed.emplace_back ( i.element );
+        }
+        mPendingAttributes.clear();
+        mPendingIndex.clear();
+        std::sort ( changed.begin(), changed.end() );
+        changed.erase ( std::unique ( changed.begin(), changed.end() ), changed.end() );
+        for ( auto& i : changed )
+        {
+            i->OnAttributesChanged();
+        }
+    }
 }
@@ -27,6 +27,7 @@ limitations under the License.
 #include "dom/SVGSVGElement.h"
 #include "dom/SVGGElement.h"
 #include "dom/SVGLinearGradientElement.h"
+#include "dom/SVGRadialGradientElement.h"
 #include "dom/SVGStopElement.h"
 #include "dom/SVGDefsElement.h"
 #include "dom/SVGUseElement.h"
@@ -37,6 +38,8 @@ limitations under the License.
 #include "dom/SVGPolygonElement.h"
 #include "dom/SVGCircleElement.h"
 #include "dom/SVGEllipseElement.h"
+#include "dom/SVGTextElement.h"
+#include "dom/SVGTSpanElement.h"
 #include "dom/Script.h"
 
 namespace AeonGUI
@@ -70,7 +73,10 @@ namespace AeonGUI
         MakeConstructor<DOM::SVGDefsElement> ( "defs" ),
         MakeConstructor<DOM::SVGUseElement> ( "use" ),
         MakeConstructor<DOM::SVGLinearGradientElement> ( "linearGradient" ),
+        MakeConstructor<DOM::SVGRadialGradientElement> ( "radialGradient" ),
         MakeConstructor<DOM::SVGStopElement> ( "stop" ),
+        MakeConstructor<DOM::SVGTextElement> ( "text" ),
+        MakeConstructor<DOM::SVGTSpanElement> ( "tspan" ),
     };
 
     Node* Construct ( const char* aIdentifier, const AttributeMap& aAttributeMap )
@@ -14,6 +14,7 @@ Copyright 2010-2012 Rodrigo Hernandez Cordoba
    limitations under the License.
 ******************************************************************************/
 #include "Font.h"
+#include <algorithm>
 #include <string>
 #include <iostream>
 #include <fstream>
@@ -21,6 +22,7 @@ Copyright 2010-2012 Rodrigo Hernandez Cordoba
 #include <cstdlib>
 #include <cwchar>
 #include "fontstructs.h"
+#include "aeongui/DistanceField.h"
 
 static int glyphcompar ( const void *key, const void *element )
 {
@@ -186,6 +188,22 @@ namespace AeonGUI
         return max_advance;
     }
 
+    bool Font::AddToDistanceField ( DistanceFieldAtlas& atlas ) const
+    {
+        const uint32_t oversample = std::max<uint32_t> ( height / std::max ( atlas.GetBaseSize(), 1u ), 1 );
+        for ( uint32_t i = 0; i < glyphcount; ++i )
+        {
+            const Glyph& glyph = glyphdata[i];
+            if ( !atlas.Add ( glyph.charcode, glyphmap + ( glyph.min[1] * map_width ) + glyph.min[0], map_width,
+                              glyph.max[0] - glyph.min[0], glyph.max[1] - glyph.min[1],
+                              glyph.left, glyph.top, glyph.advance[0], oversample ) )
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
     const uint8_t* Font::GetGlyphMap()
     {
         return glyphmap;
@@ -0,0 +1,217 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include "aeongui/GlyphCache.h"
+
+namespace AeonGUI
+{
+    size_t GlyphCache::KeyHash::operator() ( const Key& aKey ) const
+    {
+        size_t hash = std::hash<const void*> {} ( aKey.face );
+        hash ^= ( static_cast<size_t> ( aKey.index ) * 0x9e3779b97f4a7c15ull ) + ( hash << 6 ) + ( hash >> 2 );
+        hash ^= ( ( static_cast<size_t> ( aKey.size ) << 8 ) | aKey.subpixel ) + 0x9e3779b9 + ( hash << 6 ) + ( hash >> 2 );
+        return hash;
+    }
+
+    GlyphCache::GlyphCache ( uint32_t aWidth, uint32_t aHeight, uint32_t aSubpixelSteps ) :
+        mBitmap ( static_cast<size_t> ( aWidth ) * aHeight, 0 ),
+        mPacker{aWidth, aHeight, 1},
+        mSubpixelSteps{std::max ( aSubpixelSteps, 1u ) }
+    {
+    }
+
+    GlyphCache::~GlyphCache() = default;
+
+    const GlyphCache::Glyph* GlyphCache::Get ( FT_Face aFace, uint32_t aPixelSize, uint32_t aGlyphIndex, float aSubpixelOffset )
+    {
+        const float fraction = aSubpixelOffset - std::floor ( aSubpixelOffset );
+        const Key key{aFace, aPixelSize, aGlyphIndex, static_cast<uint32_t> ( fraction * mSubpixelSteps ) % mSubpixelSteps};
+        auto found = mIndex.find ( key );
+        if ( found != mIndex.end() )
+        {
+            ++mHits;
+            mEntries.splice ( mEntries.begin(), mEntries, found->second );
+            found->second->frame = mFrame;
+            return &found->second->glyph;
+        }
+        ++mMisses;
+        Glyph glyph;
+        if ( !Rasterize ( key, glyph ) )
+        {
+            return nullptr;
+        }
+        mEntries.push_front ( {key, glyph, mFrame} );
+        mIndex.emplace ( key, mEntries.begin() );
+        return &mEntries.front().glyph;
+    }
+
+    uint32_t GlyphCache::GetGlyphIndex ( FT_Face aFace, char32_t aCodePoint )
+    {
+        CharMap& charmap = mCharMaps[aFace];
+        if ( aCodePoint < 0x10000 )
+        {
+            std::unique_ptr<uint32_t[]>& page = charmap.pages[aCodePoint >> 8];
+            if ( !page )
+            {
+                // Text tends to stay within a script, so the whole page is resolved at once.
+                page = std::make_unique<uint32_t[]> ( 256 );
+                const char32_t first = aCodePoint & ~char32_t{0xff};
+                for ( uint32_t i = 0; i < 256; ++i )
+                {
+                    page[i] = FT_Get_Char_Index ( aFace, first + i );
+                }
+            }
+            return page[aCodePoint & 0xff];
+        }
+        auto found = charmap.astral.find ( aCodePoint );
+        if ( found == charmap.astral.end() )
+        {
+            found = charmap.astral.emplace ( aCodePoint, FT_Get_Char_Index ( aFace, aCodePoint ) ).first;
+        }
+        return found->second;
+    }
+
+    bool GlyphCache::Rasterize ( const Key& aKey, Glyph& aGlyph )
+    {
+        if ( FT_Set_Pixel_Sizes ( aKey.face, 0, aKey.size ) != 0 )
+        {
+            return false;
+        }
+        // The subpixel offset is applied as a 26.6 translation of the outline.
+        FT_Vector delta{static_cast<FT_Pos> ( ( aKey.subpixel * 64 ) / mSubpixelSteps ), 0};
+        FT_Set_Transform ( aKey.face, nullptr, &delta );
+        const FT_Error error = FT_Load_Glyph ( aKey.face, aKey.index, FT_LOAD_RENDER );
+        FT_Set_Transform ( aKey.face, nullptr, nullptr );
+        if ( error != 0 )
+        {
+            return false;
+        }
+        const FT_GlyphSlot slot = aKey.face->glyph;
+        const FT_Bitmap& bitmap = slot->bitmap;
+        if ( bitmap.pixel_mode != FT_PIXEL_MODE_GRAY && bitmap.pixel_mode != FT_PIXEL_MODE_MONO )
+        {
+            return false;
+        }
+        aGlyph.left = slot->bitmap_left;
+        aGlyph.top = slot->bitmap_top;
+        aGlyph.advance = static_cast<float> ( slot->advance.x ) / 64.0f;
+        if ( bitmap.width == 0 || bitmap.rows == 0 )
+        {
+            return true;
+        }
+        Rect region;
+        while ( !mPacker.Insert ( bitmap.width, bitmap.rows, region ) )
+        {
+            // Everything left was used this frame, evicting it would invalidate pointers the caller holds.
+            if ( mEntries.empty() || mEntries.back().frame == mFrame )
+            {
+                return false;
+            }
+            Evict();
+        }
+        aGlyph.region = region;
+        const uint32_t atlas_width = mPacker.GetWidth();
+        // Clear the padding too, it may hold coverage from an evicted glyph.
+        const uint32_t clear_width = std::min ( region.GetWidth() + mPacker.GetPadding(), atlas_width - region.GetX() );
+        const uint32_t clear_height = std::min ( region.GetHeight() + mPacker.GetPadding(), mPacker.GetHeight() - region.GetY() );
+        for ( uint32_t y = 0; y < clear_height; ++y )
+        {
+            memset ( mBitmap.data() + ( ( region.GetY() + y ) * atlas_width ) + region.GetX(), 0, clear_width );
+        }
+        for ( uint32_t y = 0; y < bitmap.rows; ++y )
+        {
+            const uint8_t* source = bitmap.buffer + ( static_cast<ptrdiff_t> ( y ) * bitmap.pitch );
+            uint8_t* destination = mBitmap.data() + ( ( region.GetY() + y ) * atlas_width ) + region.GetX();
+            if ( bitmap.pixel_mode == FT_PIXEL_MODE_GRAY )
+            {
+                memcpy ( destination, source, bitmap.width );
+            }
+            else
+            {
+                for ( uint32_t x = 0; x < bitmap.width; ++x )
+                {
+                    destination[x] = ( source[x >> 3] & ( 0x80 >> ( x & 7 ) ) ) ? 255 : 0;
+                }
+            }
+        }
+        return true;
+    }
+
+    void GlyphCache::Evict()
+    {
+        const Entry& entry = mEntries.back();
+        if ( entry.glyph.region.GetWidth() != 0 )
+        {
+            mPacker.Remove ( entry.glyph.region );
+        }
+        mIndex.erase ( entry.key );
+        mEntries.pop_back();
+        ++mEvictions;
+    }
+
+    void GlyphCache::BeginFrame()
+    {
+        ++mFrame;
+    }
+
+    void GlyphCache::Clear()
+    {
+        mEntries.clear();
+        mIndex.clear();
+        mCharMaps.clear();
+        mPacker.Reset();
+    }
+
+    const uint8_t* GlyphCache::GetBitmap() const
+    {
+        return mBitmap.data();
+    }
+
+    uint32_t GlyphCache::GetWidth() const
+    {
+        return mPacker.GetWidth();
+    }
+
+    uint32_t GlyphCache::GetHeight() const
+    {
+        return mPacker.GetHeight();
+    }
+
+    size_t GlyphCache::GetGlyphCount() const
+    {
+        return mEntries.size();
+    }
+
+    size_t GlyphCache::GetHits() const
+    {
+        return mHits;
+    }
+
+    size_t GlyphCache::GetMisses() const
+    {
+        return mMisses;
+    }
+
+    size_t GlyphCache::GetEvictions() const
+    {
+        return mEvictions;
+    }
+}
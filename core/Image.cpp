@@ -14,12 +14,14 @@ Copyright 2010-2012,2015 Rodrigo Hernandez Cordoba
    limitations under the License.
 ******************************************************************************/
 #include "Image.h"
-#include <fstream>
 #include "pcx.h"
+#include "aeongui/MappedFile.h"
+#include "aeongui/PixelConversion.h"
+#include "aeongui/Resampler.h"
+#include <algorithm>
 
 #ifdef USE_PNG
 #include "png.h"
-#include <algorithm>
 #endif
 
 namespace AeonGUI
@@ -27,8 +29,8 @@ namespace AeonGUI
 #ifdef USE_PNG
     struct png_read_memory_struct
     {
-        uint8_t* buffer;
-        uint8_t* pointer;
+        const uint8_t* buffer;
+        const uint8_t* pointer;
         png_size_t size;
     };
     static void png_read_memory_data ( png_structp png_ptr, png_bytep data, png_size_t length )
@@ -57,6 +59,15 @@ namespace AeonGUI
         read_struct->pointer += real_length;
     }
 #endif
+    static_assert ( static_cast<int> ( PixelFormat::RGB ) == Image::RGB && static_cast<int> ( PixelFormat::BGRA ) == Image::BGRA,
+                    "Image::Format and PixelFormat must share values." );
+
+    static uint64_t NextGeneration()
+    {
+        static std::atomic<uint64_t> counter{0};
+        return ++counter;
+    }
+
     Image::Image () :
         width ( 0 ),
         height ( 0 ),
@@ -68,26 +79,27 @@ namespace AeonGUI
         stretchyend ( 0 ),
         padystart ( 0 ),
         padyend ( 0 ),
-        bitmap ( NULL )
+        bitmap ( NULL ),
+        mipmaps ( NULL ),
+        generation ( NextGeneration() )
     {
     }
 
 
-    static bool GetPatch9DimensionsFromFrame ( const uint8_t* buffer, uint32_t length, uint32_t pitch, Image::Format format, uint32_t& start, uint32_t& end )
+    static bool GetPatch9DimensionsFromFrame ( const uint8_t* buffer, uint32_t length, uint32_t pitch, uint32_t bpp, bool alpha, uint32_t& start, uint32_t& end )
     {
-        const uint32_t bpp = ( format == Image::RGB || format == Image::BGR ) ? 3 : 4;
         const uint8_t* bytes = buffer;
 
         start = 0;
         end = 0;
 
         // First and Last Pixel MUST be white with 0 alpha
-        if ( ! ( ( bytes[0] == bytes[1] ) && ( bytes[1] == bytes[2] ) &&  ( bytes[2] == 255 ) && ( ( bpp == 4 ) ? bytes[3] == 0 : true ) ) )
+        if ( ! ( ( bytes[0] == bytes[1] ) && ( bytes[1] == bytes[2] ) &&  ( bytes[2] == 255 ) && ( alpha ? bytes[3] == 0 : true ) ) )
         {
             return false;
         }
         bytes = ( buffer ) + ( ( length - 1 ) * pitch * bpp );
-        if ( ! ( ( bytes[0] == bytes[1] ) && ( bytes[1] == bytes[2] ) &&  ( bytes[2] == 255 ) && ( ( bpp == 4 ) ? bytes[3] == 0 : true ) ) )
+        if ( ! ( ( bytes[0] == bytes[1] ) && ( bytes[1] == bytes[2] ) &&  ( bytes[2] == 255 ) && ( alpha ? bytes[3] == 0 : true ) ) )
         {
             return false;
         }
@@ -96,7 +108,7 @@ namespace AeonGUI
         {
             bytes = ( buffer ) + ( i * pitch * bpp );
 
-            if ( ( ( bytes[0] == bytes[1] ) && ( bytes[1] == bytes[2] ) && ( bytes[2] == 0 ) && ( ( bpp == 4 ) ? bytes[3] == 255 : true ) ) )
+            if ( ( ( bytes[0] == bytes[1] ) && ( bytes[1] == bytes[2] ) && ( bytes[2] == 0 ) && ( alpha ? bytes[3] == 255 : true ) ) )
             {
                 // IF pixel is black with 255 alpha
                 if ( start == 0 )
@@ -111,7 +123,7 @@ namespace AeonGUI
                     return false;
                 }
             }
-            else if ( ( ( bytes[0] == bytes[1] ) && ( bytes[1] == bytes[2] ) && ( bytes[2] == 255 ) && ( ( bpp == 4 ) ? bytes[3] == 0 : true ) ) )
+            else if ( ( ( bytes[0] == bytes[1] ) && ( bytes[1] == bytes[2] ) && ( bytes[2] == 255 ) && ( alpha ? bytes[3] == 0 : true ) ) )
             {
                 // IF pixel is white with 0 alpha
                 if ( ( start > 0 ) && ( end == 0 ) )
@@ -135,30 +147,24 @@ namespace AeonGUI
         return true;
     }
 
-    bool Image::Load ( uint32_t image_width, uint32_t image_height, Image::Format format, Image::Type type, const void* data )
+    bool Image::FindPatch9Frame ( uint32_t image_width, uint32_t image_height, uint32_t bpp, bool alpha, const uint8_t* data )
     {
-        assert ( data != NULL );
-        if ( bitmap != NULL )
-        {
-            Unload();
-        }
         // Determine patch9 stretch and pad if any
         bool haspatch9frame = true;
 
         if ( ( stretchxstart == 0 ) && ( stretchystart == 0 ) && ( stretchxend == 0 ) && ( stretchyend == 0 ) && ( padxstart == 0 ) && ( padystart == 0 ) && ( padxend == 0 ) && ( padyend == 0 ) )
         {
             // Stretch values are mandatory
-            haspatch9frame = GetPatch9DimensionsFromFrame ( reinterpret_cast<const uint8_t*> ( data ), image_width, 1, format, stretchxstart, stretchxend );
+            haspatch9frame = GetPatch9DimensionsFromFrame ( data, image_width, 1, bpp, alpha, stretchxstart, stretchxend );
             if ( haspatch9frame )
             {
-                haspatch9frame = GetPatch9DimensionsFromFrame ( reinterpret_cast<const uint8_t*> ( data ), image_height, image_width, format, stretchystart, stretchyend );
+                haspatch9frame = GetPatch9DimensionsFromFrame ( data, image_height, image_width, bpp, alpha, stretchystart, stretchyend );
             }
             if ( haspatch9frame )
             {
                 // Pad values are optional (but the frame must still exist)
-                uint32_t bpp = ( format == RGB || format == BGR ) ? 3 : 4;
-                GetPatch9DimensionsFromFrame ( reinterpret_cast<const uint8_t*> ( data ) + ( ( image_width * ( image_height - 1 ) ) *bpp ), image_width, 1, format, padxstart, padxend );
-                GetPatch9DimensionsFromFrame ( reinterpret_cast<const uint8_t*> ( data ) + ( ( image_width - 1 ) *bpp ), image_height, image_width, format, padystart, padyend );
+                GetPatch9DimensionsFromFrame ( data + ( ( image_width * ( image_height - 1 ) ) *bpp ), image_width, 1, bpp, alpha, padxstart, padxend );
+                GetPatch9DimensionsFromFrame ( data + ( ( image_width - 1 ) *bpp ), image_height, image_width, bpp, alpha, padystart, padyend );
             }
         }
 
@@ -173,63 +179,41 @@ namespace AeonGUI
             padxend = ( padxend == 0 ) ? 0 : padxend - 1;
             padystart = ( padystart == 0 ) ? 0 : padystart - 1;
             padyend = ( padyend == 0 ) ? 0 : padyend - 1;
+        }
+        return haspatch9frame;
+    }
 
+    void Image::CropPatch9Frame()
+    {
+        // Rows only ever move towards the start of the buffer, so this can be done in place.
+        const uint32_t image_width = width;
+        width -= 2;
+        height -= 2;
+        for ( uint32_t y = 0; y < height; ++y )
+        {
+            memmove ( bitmap + ( width * y ), bitmap + ( image_width * ( y + 1 ) ) + 1, sizeof ( Color ) * width );
+        }
+    }
+
+    bool Image::Load ( uint32_t image_width, uint32_t image_height, Image::Format format, Image::Type type, const void* data )
+    {
+        assert ( data != NULL );
+        if ( bitmap != NULL )
+        {
+            Unload();
+        }
+        const uint32_t bpp = ( format == RGB || format == BGR ) ? 3 : 4;
+        if ( FindPatch9Frame ( image_width, image_height, bpp, bpp == 4, reinterpret_cast<const uint8_t*> ( data ) ) )
+        {
             // Adjust dimensions
             width = image_width - 2;
             height = image_height - 2;
 
             bitmap = new Color[width * height];
-            switch ( format )
-            {
-            case RGB:
-                for ( uint32_t sy = 1, dy = 0; sy <= height; ++sy, ++dy )
-                {
-                    for ( uint32_t sx = 1, dx = 0; sx <= width; ++sx, ++dx )
-                    {
-                        bitmap[ ( dy * width ) + ( dx )].r = reinterpret_cast<const uint8_t*> ( data ) [ ( ( sy * image_width * 3 ) + ( sx * 3 ) ) + 0];
-                        bitmap[ ( dy * width ) + ( dx )].g = reinterpret_cast<const uint8_t*> ( data ) [ ( ( sy * image_width * 3 ) + ( sx * 3 ) ) + 1];
-                        bitmap[ ( dy * width ) + ( dx )].b = reinterpret_cast<const uint8_t*> ( data ) [ ( ( sy * image_width * 3 ) + ( sx * 3 ) ) + 2];
-                        bitmap[ ( dy * width ) + ( dx )].a = 255;
-                    }
-                }
-                break;
-            case BGR:
-                for ( uint32_t sy = 1, dy = 0; sy <= height; ++sy, ++dy )
-                {
-                    for ( uint32_t sx = 1, dx = 0; sx <= width; ++sx, ++dx )
-                    {
-                        bitmap[ ( dy * width ) + ( dx )].b = reinterpret_cast<const uint8_t*> ( data ) [ ( ( sy * image_width * 3 ) + ( sx * 3 ) ) + 0];
-                        bitmap[ ( dy * width ) + ( dx )].g = reinterpret_cast<const uint8_t*> ( data ) [ ( ( sy * image_width * 3 ) + ( sx * 3 ) ) + 1];
-                        bitmap[ ( dy * width ) + ( dx )].r = reinterpret_cast<const uint8_t*> ( data ) [ ( ( sy * image_width * 3 ) + ( sx * 3 ) ) + 2];
-                        bitmap[ ( dy * width ) + ( dx )].a = 255;
-                    }
-                }
-                break;
-            case RGBA:
-                for ( uint32_t sy = 1, dy = 0; sy <= height; ++sy, ++dy )
-                {
-                    for ( uint32_t sx = 1, dx = 0; sx <= width; ++sx, ++dx )
-                    {
-                        bitmap[ ( dy * width ) + ( dx )].r = reinterpret_cast<const uint8_t*> ( data ) [ ( ( sy * image_width * 4 ) + ( sx * 4 ) ) + 0];
-                        bitmap[ ( dy * width ) + ( dx )].g = reinterpret_cast<const uint8_t*> ( data ) [ ( ( sy * image_width * 4 ) + ( sx * 4 ) ) + 1];
-                        bitmap[ ( dy * width ) + ( dx )].b = reinterpret_cast<const uint8_t*> ( data ) [ ( ( sy * image_width * 4 ) + ( sx * 4 ) ) + 2];
-                        bitmap[ ( dy * width ) + ( dx )].a = reinterpret_cast<const uint8_t*> ( data ) [ ( ( sy * image_width * 4 ) + ( sx * 4 ) ) + 3];
-                    }
-                }
-                break;
-            case BGRA:
-                for ( uint32_t sy = 1, dy = 0; sy <= height; ++sy, ++dy )
-                {
-                    for ( uint32_t sx = 1, dx = 0; sx <= width; ++sx, ++dx )
-                    {
-                        bitmap[ ( dy * width ) + ( dx )].b = reinterpret_cast<const uint8_t*> ( data ) [ ( ( sy * image_width * 4 ) + ( sx * 4 ) ) + 0];
-                        bitmap[ ( dy * width ) + ( dx )].g = reinterpret_cast<const uint8_t*> ( data ) [ ( ( sy * image_width * 4 ) + ( sx * 4 ) ) + 1];
-                        bitmap[ ( dy * width ) + ( dx )].r = reinterpret_cast<const uint8_t*> ( data ) [ ( ( sy * image_width * 4 ) + ( sx * 4 ) ) + 2];
-                        bitmap[ ( dy * width ) + ( dx )].a = reinterpret_cast<const uint8_t*> ( data ) [ ( ( sy * image_width * 4 ) + ( sx * 4 ) ) + 3];
-                    }
-                }
-                break;
-            }
+            // Skip the guide frame: start at (1,1) and keep the source pitch.
+            ConvertPixels ( static_cast<PixelFormat> ( format ),
+                            reinterpret_cast<const uint8_t*> ( data ) + ( ( image_width + 1 ) * bpp ), image_width * bpp,
+                            bitmap, width * sizeof ( Color ), width, height );
         }
         else
         {
@@ -238,54 +222,30 @@ namespace AeonGUI
 
             bitmap = new Color[width * height];
 
-            switch ( format )
-            {
-            case RGB:
-                for ( uint32_t i = 0; i < ( width * height ); ++i )
-                {
-                    bitmap[i].r = reinterpret_cast<const uint8_t*> ( data ) [ ( i * 3 ) + 0];
-                    bitmap[i].g = reinterpret_cast<const uint8_t*> ( data ) [ ( i * 3 ) + 1];
-                    bitmap[i].b = reinterpret_cast<const uint8_t*> ( data ) [ ( i * 3 ) + 2];
-                    bitmap[i].a = 255;
-                }
-                break;
-            case BGR:
-                for ( uint32_t i = 0; i < ( width * height ); ++i )
-                {
-                    bitmap[i].b = reinterpret_cast<const uint8_t*> ( data ) [ ( i * 3 ) + 0];
-                    bitmap[i].g = reinterpret_cast<const uint8_t*> ( data ) [ ( i * 3 ) + 1];
-                    bitmap[i].r = reinterpret_cast<const uint8_t*> ( data ) [ ( i * 3 ) + 2];
-                    bitmap[i].a = 255;
-                }
-                break;
-            case RGBA:
-                for ( uint32_t i = 0; i < ( width * height ); ++i )
-                {
-                    bitmap[i].r = reinterpret_cast<const uint8_t*> ( data ) [ ( i * 4 ) + 0];
-                    bitmap[i].g = reinterpret_cast<const uint8_t*> ( data ) [ ( i * 4 ) + 1];
-                    bitmap[i].b = reinterpret_cast<const uint8_t*> ( data ) [ ( i * 4 ) + 2];
-                    bitmap[i].a = reinterpret_cast<const uint8_t*> ( data ) [ ( i * 4 ) + 3];
-                }
-                break;
-            case BGRA:
-                memcpy ( bitmap, data, sizeof ( Color ) * width * height );
-                break;
-            }
+            ConvertPixelRow ( static_cast<PixelFormat> ( format ), reinterpret_cast<const uint8_t*> ( data ), bitmap, width * height );
         }
+        generation = NextGeneration();
         return true;
     }
 
     void Image::Unload()
     {
+        generation = NextGeneration();
+        delete [] mipmaps.exchange ( NULL );
         if ( bitmap != NULL )
         {
             delete [] bitmap;
             width = 0;
             height = 0;
+            // All guides must be cleared so the next load looks for a 9-patch frame again.
             stretchxstart = 0;
+            stretchxend = 0;
             padxstart = 0;
+            padxend = 0;
             stretchystart = 0;
+            stretchyend = 0;
             padystart = 0;
+            padyend = 0;
             bitmap = NULL;
         }
     }
@@ -310,6 +270,89 @@ namespace AeonGUI
         return bitmap;
     }
 
+    uint64_t Image::GetGeneration() const
+    {
+        return generation;
+    }
+
+    uint32_t Image::GetMipLevelCount() const
+    {
+        if ( bitmap == NULL )
+        {
+            return 0;
+        }
+        uint32_t count = 1;
+        for ( uint32_t size = std::max ( width, height ); size > 1; size >>= 1 )
+        {
+            ++count;
+        }
+        return count;
+    }
+
+    uint32_t Image::GetMipLevelForScale ( float scale ) const
+    {
+        uint32_t level = 0;
+        const uint32_t last = GetMipLevelCount();
+        while ( ( level + 1 < last ) && ( scale <= 0.5f ) )
+        {
+            scale *= 2.0f;
+            ++level;
+        }
+        return level;
+    }
+
+    const Color* Image::GetMipLevel ( uint32_t level, uint32_t& level_width, uint32_t& level_height ) const
+    {
+        level_width = width;
+        level_height = height;
+        if ( ( bitmap == NULL ) || ( level == 0 ) )
+        {
+            return bitmap;
+        }
+        const uint32_t count = GetMipLevelCount();
+        Color* chain = mipmaps.load ( std::memory_order_acquire );
+        if ( chain == NULL )
+        {
+            size_t size = 0;
+            for ( uint32_t i = 1, w = width, h = height; i < count; ++i )
+            {
+                w = std::max ( w >> 1, 1u );
+                h = std::max ( h >> 1, 1u );
+                size += static_cast<size_t> ( w ) * h;
+            }
+            Color* built = new Color[size];
+            const Color* source = bitmap;
+            Color* destination = built;
+            for ( uint32_t i = 1, w = width, h = height; i < count; ++i )
+            {
+                HalveBitmap ( source, w * sizeof ( Color ), w, h, destination, std::max ( w >> 1, 1u ) * sizeof ( Color ) );
+                w = std::max ( w >> 1, 1u );
+                h = std::max ( h >> 1, 1u );
+                source = destination;
+                destination += static_cast<size_t> ( w ) * h;
+            }
+            // Concurrent readers may race to build the chain, the first one to publish wins.
+            if ( mipmaps.compare_exchange_strong ( chain, built, std::memory_order_acq_rel ) )
+            {
+                chain = built;
+            }
+            else
+            {
+                delete [] built;
+            }
+        }
+        level = std::min ( level, count - 1 );
+        for ( uint32_t i = 1; i < level; ++i )
+        {
+            chain += static_cast<size_t> ( std::max ( level_width >> 1, 1u ) ) * std::max ( level_height >> 1, 1u );
+            level_width = std::max ( level_width >> 1, 1u );
+            level_height = std::max ( level_height >> 1, 1u );
+        }
+        level_width = std::max ( level_width >> 1, 1u );
+        level_height = std::max ( level_height >> 1, 1u );
+        return chain;
+    }
+
     uint32_t Image::GetStretchXStart() const
     {
         return stretchxstart;
@@ -480,58 +523,66 @@ namespace AeonGUI
 
     bool Image::LoadFromFile ( const char* filename )
     {
-        uint8_t* buffer = NULL;
-        uint32_t buffer_size = 0;
-        bool retval;
-        std::ifstream file;
-
-        file.open ( filename, std::ios_base::in | std::ios_base::binary );
-        if ( !file.is_open() )
+        // Decoders read straight from the mapping, no file sized buffer is allocated.
+        MappedFile file;
+        if ( !file.Open ( filename ) )
         {
             printf ( "Problem opening %s for reading.\n", filename );
             return false;
         }
+        if ( file.GetSize() > UINT32_MAX )
+        {
+            printf ( "%s is too large to load.\n", filename );
+            return false;
+        }
+        return LoadFromMemory ( static_cast<uint32_t> ( file.GetSize() ), file.GetData() );
+    }
 
-        file.seekg ( 0, std::ios_base::end );
-        buffer_size = static_cast<uint32_t> ( file.tellg() );
-        file.seekg ( 0, std::ios_base::beg );
-        buffer = new uint8_t[buffer_size];
-        file.read ( reinterpret_cast<char*> ( buffer ), buffer_size );
-        file.close();
-
-        retval = LoadFromMemory ( buffer_size, buffer );
-        delete[] buffer;
-        return retval;
+    static void CopyPcxRow ( uint32_t row, const uint8_t* bgra, uint32_t row_width, void* user_data )
+    {
+        memcpy ( static_cast<Color*> ( user_data ) + ( static_cast<size_t> ( row ) * row_width ), bgra, sizeof ( Color ) * row_width );
     }
 
-    bool Image::LoadFromMemory ( uint32_t buffer_size, void* buffer )
+    bool Image::LoadFromMemory ( uint32_t buffer_size, const void* buffer )
     {
-        if ( reinterpret_cast<uint8_t*> ( buffer ) [0] == 0x0A )
+        if ( reinterpret_cast<const uint8_t*> ( buffer ) [0] == 0x0A )
         {
             // Posible PCX file
             Pcx pcx;
-            if ( !pcx.Decode ( buffer_size, buffer ) )
+            if ( !pcx.DecodeHeader ( buffer_size, buffer ) )
             {
                 return false;
             }
+            if ( bitmap != NULL )
+            {
+                Unload();
+            }
+            width = pcx.GetWidth();
+            height = pcx.GetHeight();
+            bitmap = new Color[static_cast<size_t> ( width ) * height];
+            // Scanlines are streamed straight into the bitmap.
+            if ( !pcx.DecodeRows ( buffer_size, buffer, CopyPcxRow, bitmap ) )
+            {
+                Unload();
+                return false;
+            }
 
             // If the patch9 values are embeded into the image, get them.
             stretchxstart = static_cast<int32_t> ( pcx.GetXStretchStart() );
+            stretchxend = static_cast<int32_t> ( pcx.GetXStretchEnd() );
             padxstart = static_cast<int32_t> ( pcx.GetXPadStart() );
             padxend = static_cast<int32_t> ( pcx.GetXPadEnd() );
             stretchystart = static_cast<int32_t> ( pcx.GetYStretchStart() );
+            stretchyend = static_cast<int32_t> ( pcx.GetYStretchEnd() );
             padystart = static_cast<int32_t> ( pcx.GetYPadStart() );
             padyend = static_cast<int32_t> ( pcx.GetYPadEnd() );
 
-            if ( pcx.GetNumBitPlanes() == 3 )
-            {
-                return Load ( pcx.GetWidth(), pcx.GetHeight(), RGB, BYTE, pcx.GetPixels() );
-            }
-            else if ( pcx.GetNumBitPlanes() == 4 )
+            if ( FindPatch9Frame ( width, height, 4, pcx.GetNumBitPlanes() == 4, reinterpret_cast<const uint8_t*> ( bitmap ) ) )
             {
-                return Load ( pcx.GetWidth(), pcx.GetHeight(), RGBA, BYTE, pcx.GetPixels() );
+                CropPatch9Frame();
             }
-            // Let the Pcx destructor release its pixel buffer.
+            generation = NextGeneration();
+            return true;
         }
 #if USE_PNG
         else if ( png_sig_cmp ( reinterpret_cast<png_const_bytep> ( buffer ), 0, 8 ) == 0 )
@@ -553,9 +604,8 @@ namespace AeonGUI
                 printf ( "Error during init_io\n" );
                 return false;
             }
-            png_read_memory_struct read_memory_struct = {reinterpret_cast<uint8_t*> ( buffer ), reinterpret_cast<uint8_t*> ( buffer ) + 8, buffer_size};
+            png_read_memory_struct read_memory_struct = {reinterpret_cast<const uint8_t*> ( buffer ), reinterpret_cast<const uint8_t*> ( buffer ) + 8, buffer_size};
             png_set_read_fn ( png_ptr, &read_memory_struct, png_read_memory_data );
-            //png_init_io ( png_ptr, fp );
             png_set_sig_bytes ( png_ptr, 8 );
 
             png_read_info ( png_ptr, info_ptr );
@@ -563,36 +613,53 @@ namespace AeonGUI
             png_uint_32 image_width = png_get_image_width ( png_ptr, info_ptr );
             png_uint_32 image_height = png_get_image_height ( png_ptr, info_ptr );
             png_byte color_type = png_get_color_type ( png_ptr, info_ptr );
-            //png_byte bit_depth = png_get_bit_depth ( png_ptr, info_ptr );
 
             if ( ( color_type == PNG_COLOR_TYPE_RGB ) || ( color_type == PNG_COLOR_TYPE_RGBA ) )
             {
-                /*int number_of_passes =*/ png_set_interlace_handling ( png_ptr );
+                if ( bitmap != NULL )
+                {
+                    Unload();
+                }
+                /*  Let libpng produce BGRA rows so each row is decoded
+                    directly into the final bitmap, without an intermediate image. */
+                png_set_interlace_handling ( png_ptr );
+                png_set_strip_16 ( png_ptr );
+                png_set_bgr ( png_ptr );
+                if ( color_type == PNG_COLOR_TYPE_RGB )
+                {
+                    png_set_filler ( png_ptr, 0xff, PNG_FILLER_AFTER );
+                }
                 png_read_update_info ( png_ptr, info_ptr );
 
+                width = image_width;
+                height = image_height;
+                bitmap = new Color[width * height];
+                png_bytep* row_pointers = new png_bytep[height];
+                for ( png_uint_32 y = 0; y < height; ++y )
+                {
+                    row_pointers[y] = reinterpret_cast<png_bytep> ( bitmap + ( width * y ) );
+                }
 
                 /* read file */
                 if ( setjmp ( png_jmpbuf ( png_ptr ) ) )
                 {
                     printf ( "Error during read_image\n" );
+                    delete[] row_pointers;
+                    png_destroy_read_struct ( &png_ptr, &info_ptr, ( png_infopp ) 0 );
+                    Unload();
                     return false;
                 }
-
-                png_size_t rowbytes = png_get_rowbytes ( png_ptr, info_ptr );
-                png_bytep* row_pointers = ( png_bytep* ) malloc ( static_cast<uint32_t> ( sizeof ( png_bytep ) * image_height ) );
-                png_bytep image_buffer = ( png_bytep ) malloc ( static_cast<uint32_t> ( rowbytes * image_height ) );
-                for ( png_uint_32 y = 0; y < image_height; ++y )
-                {
-                    row_pointers[y] = image_buffer + ( rowbytes * y );
-                }
                 png_read_image ( png_ptr, row_pointers );
 
-                bool retval = Load ( image_width, image_height, ( color_type == PNG_COLOR_TYPE_RGB ) ? RGB : RGBA, BYTE, image_buffer );
-
-                free ( image_buffer );
-                free ( row_pointers );
+                delete[] row_pointers;
                 png_destroy_read_struct ( &png_ptr, &info_ptr, ( png_infopp ) 0 );
-                return retval;
+
+                if ( FindPatch9Frame ( image_width, image_height, 4, color_type == PNG_COLOR_TYPE_RGBA, reinterpret_cast<const uint8_t*> ( bitmap ) ) )
+                {
+                    CropPatch9Frame();
+                }
+                generation = NextGeneration();
+                return true;
             }
             else
             {
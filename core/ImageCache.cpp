@@ -0,0 +1,185 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#include "ImageCache.h"
+#include <mutex>
+#include <list>
+#include <unordered_map>
+
+namespace AeonGUI
+{
+    struct ImageCache::State : std::enable_shared_from_this<State>
+    {
+        struct Entry
+        {
+            std::shared_ptr<Image> image;
+            size_t bytes;
+            /// Handles currently out for this entry, only entries at zero may be evicted.
+            size_t handles;
+            std::list<std::string>::iterator lru;
+        };
+        /// Handle deleter, it also holds the image so handles may outlive the cache.
+        struct Releaser
+        {
+            std::weak_ptr<State> state;
+            std::string key;
+            std::shared_ptr<Image> image;
+            void operator() ( const Image* ) const
+            {
+                if ( std::shared_ptr<State> owner = state.lock() )
+                {
+                    owner->Release ( key );
+                }
+            }
+        };
+        Handle Acquire ( const std::string& aKey, Entry& aEntry );
+        void Release ( const std::string& aKey );
+        Handle Find ( const std::string& aKey );
+        Handle Insert ( const std::string& aKey, std::unique_ptr<Image> aImage );
+        void Evict ( size_t aBudget );
+        std::mutex mutex{};
+        std::unordered_map<std::string, Entry> entries{};
+        /// Keys in use order, most recently used first.
+        std::list<std::string> lru{};
+        size_t budget{};
+        Statistics statistics{};
+    };
+
+    ImageCache::Handle ImageCache::State::Acquire ( const std::string& aKey, Entry& aEntry )
+    {
+        ++aEntry.handles;
+        // Each handle gets its own deleter so the cache learns when the last one goes away.
+        return Handle{aEntry.image.get(), Releaser{weak_from_this(), aKey, aEntry.image}};
+    }
+
+    void ImageCache::State::Release ( const std::string& aKey )
+    {
+        std::lock_guard<std::mutex> lock ( mutex );
+        auto i = entries.find ( aKey );
+        if ( i != entries.end() && i->second.handles > 0 )
+        {
+            --i->second.handles;
+            Evict ( budget );
+        }
+    }
+
+    ImageCache::Handle ImageCache::State::Find ( const std::string& aKey )
+    {
+        auto i = entries.find ( aKey );
+        if ( i == entries.end() )
+        {
+            ++statistics.misses;
+            return Handle{};
+        }
+        ++statistics.hits;
+        lru.splice ( lru.begin(), lru, i->second.lru );
+        return Acquire ( aKey, i->second );
+    }
+
+    ImageCache::Handle ImageCache::State::Insert ( const std::string& aKey, std::unique_ptr<Image> aImage )
+    {
+        const size_t bytes = static_cast<size_t> ( aImage->GetWidth() ) * aImage->GetHeight() * sizeof ( Color );
+        lru.push_front ( aKey );
+        Entry& entry = entries.emplace ( aKey, Entry{std::move ( aImage ), bytes, 0, lru.begin() } ).first->second;
+        statistics.bytes += bytes;
+        statistics.entries = entries.size();
+        Handle image = Acquire ( aKey, entry );
+        Evict ( budget );
+        return image;
+    }
+
+    void ImageCache::State::Evict ( size_t aBudget )
+    {
+        // Walk from the least recently used end, images with outstanding handles stay.
+        for ( auto i = lru.end(); i != lru.begin() && statistics.bytes > aBudget; )
+        {
+            --i;
+            auto entry = entries.find ( *i );
+            if ( entry->second.handles > 0 )
+            {
+                continue;
+            }
+            statistics.bytes -= entry->second.bytes;
+            ++statistics.evictions;
+            entries.erase ( entry );
+            i = lru.erase ( i );
+        }
+        statistics.entries = entries.size();
+    }
+
+    ImageCache::ImageCache ( size_t aBudget ) : mState{std::make_shared<State>() }
+    {
+        mState->budget = aBudget;
+    }
+
+    ImageCache::~ImageCache() = default;
+
+    ImageCache::Handle ImageCache::GetFromFile ( const std::string& aPath )
+    {
+        std::lock_guard<std::mutex> lock ( mState->mutex );
+        const std::string key{"file:" + aPath};
+        if ( Handle image = mState->Find ( key ) )
+        {
+            return image;
+        }
+        std::unique_ptr<Image> image = std::make_unique<Image>();
+        if ( !image->LoadFromFile ( aPath.c_str() ) )
+        {
+            return Handle{};
+        }
+        return mState->Insert ( key, std::move ( image ) );
+    }
+
+    ImageCache::Handle ImageCache::GetFromResource ( const std::string& aName, uint32_t aWidth, uint32_t aHeight, Image::Format aFormat, const void* aData )
+    {
+        std::lock_guard<std::mutex> lock ( mState->mutex );
+        const std::string key{"resource:" + aName};
+        if ( Handle image = mState->Find ( key ) )
+        {
+            return image;
+        }
+        std::unique_ptr<Image> image = std::make_unique<Image>();
+        if ( !image->Load ( aWidth, aHeight, aFormat, Image::BYTE, aData ) )
+        {
+            return Handle{};
+        }
+        return mState->Insert ( key, std::move ( image ) );
+    }
+
+    void ImageCache::SetBudget ( size_t aBudget )
+    {
+        std::lock_guard<std::mutex> lock ( mState->mutex );
+        mState->budget = aBudget;
+        mState->Evict ( aBudget );
+    }
+
+    size_t ImageCache::GetBudget() const
+    {
+        std::lock_guard<std::mutex> lock ( mState->mutex );
+        return mState->budget;
+    }
+
+    void ImageCache::Purge()
+    {
+        std::lock_guard<std::mutex> lock ( mState->mutex );
+        mState->Evict ( 0 );
+    }
+
+    ImageCache::Statistics ImageCache::GetStatistics() const
+    {
+        std::lock_guard<std::mutex> lock ( mState->mutex );
+        return mState->statistics;
+    }
+}
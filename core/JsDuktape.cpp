@@ -0,0 +1,435 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <cstdlib>
+#include <algorithm>
+#include <cstddef>
+#include "aeongui/JsDuktape.h"
+#include "DOMBridge.h"
+#include "dom/Element.h"
+
+namespace AeonGUI
+{
+    /*  Heap stash properties, the stash is only reachable from native code. */
+    static constexpr char ElementPrototype[] = "elementPrototype";
+    static constexpr char ElementWrappers[] = "elementWrappers";
+    static constexpr char AnimationFrames[] = "animationFrames";
+    /*  Hidden symbols are invisible to scripts, even through reflection. */
+    static constexpr char ElementPointer[] = DUK_HIDDEN_SYMBOL ( "element" );
+
+    /// Keeps blocks past the size header aligned for any type.
+    static constexpr size_t AllocationHeaderSize{alignof ( std::max_align_t ) };
+
+    static void OnFatalError ( void* aUserData, const char* aMessage )
+    {
+        // Duktape can't unwind through C++ frames, so there is nothing to do but stop.
+        std::cerr << "Duktape fatal error: " << ( aMessage ? aMessage : "no message" ) << std::endl;
+        std::abort();
+    }
+
+    /*  The engine pointer is the heap user data. */
+    static JsDuktape* GetEngine ( duk_context* aContext )
+    {
+        duk_memory_functions memory_functions;
+        duk_get_memory_functions ( aContext, &memory_functions );
+        return static_cast<JsDuktape*> ( memory_functions.udata );
+    }
+
+    static Element* GetThisElement ( duk_context* aContext )
+    {
+        duk_push_this ( aContext );
+        duk_get_prop_string ( aContext, -1, ElementPointer );
+        Element* element = static_cast<Element*> ( duk_get_pointer ( aContext, -1 ) );
+        duk_pop_2 ( aContext );
+        return element;
+    }
+
+    static void PushElement ( duk_context* aContext, Element* aElement )
+    {
+        if ( aElement == nullptr )
+        {
+            duk_push_null ( aContext );
+            return;
+        }
+        GetEngine ( aContext )->PushObject ( aElement );
+    }
+
+    static duk_ret_t log ( duk_context* aContext )
+    {
+        duk_idx_t count = duk_get_top ( aContext );
+        for ( duk_idx_t i = 0; i < count; ++i )
+        {
+            if ( i > 0 )
+            {
+                std::cout << " ";
+            }
+            std::cout << duk_safe_to_string ( aContext, i );
+        }
+        std::cout << std::endl;
+        return 0;
+    }
+
+    static duk_ret_t createElementNS ( duk_context* aContext )
+    {
+        std::string name_space{duk_safe_to_string ( aContext, 0 ) };
+        std::string qualified_name{duk_safe_to_string ( aContext, 1 ) };
+        PushElement ( aContext, GetEngine ( aContext )->GetDOMBridge()->CreateElementNS ( name_space, qualified_name ) );
+        return 1;
+    }
+
+    static duk_ret_t getElementById ( duk_context* aContext )
+    {
+        PushElement ( aContext, GetEngine ( aContext )->GetDOMBridge()->GetElementById ( duk_safe_to_string ( aContext, 0 ) ) );
+        return 1;
+    }
+
+    static duk_ret_t setAttribute ( duk_context* aContext )
+    {
+        Element* element = GetThisElement ( aContext );
+        if ( element == nullptr )
+        {
+            return DUK_RET_TYPE_ERROR;
+        }
+        std::string name{duk_safe_to_string ( aContext, 0 ) };
+        std::string value{duk_safe_to_string ( aContext, 1 ) };
+        GetEngine ( aContext )->GetDOMBridge()->SetAttribute ( element, name, value );
+        return 0;
+    }
+
+    static duk_ret_t getAttribute ( duk_context* aContext )
+    {
+        Element* element = GetThisElement ( aContext );
+        if ( element == nullptr )
+        {
+            return DUK_RET_TYPE_ERROR;
+        }
+        AttributeType attribute = GetEngine ( aContext )->GetDOMBridge()->GetAttribute ( element, duk_safe_to_string ( aContext, 0 ) );
+        if ( std::holds_alternative<double> ( attribute ) )
+        {
+            duk_push_number ( aContext, std::get<double> ( attribute ) );
+        }
+        else if ( std::holds_alternative<std::string> ( attribute ) )
+        {
+            duk_push_string ( aContext, std::get<std::string> ( attribute ).c_str() );
+        }
+        else if ( std::holds_alternative<ColorAttr> ( attribute ) && std::holds_alternative<none> ( std::get<ColorAttr> ( attribute ) ) )
+        {
+            duk_push_string ( aContext, "none" );
+        }
+        else if ( std::holds_alternative<ColorAttr> ( attribute ) && std::holds_alternative<Color> ( std::get<ColorAttr> ( attribute ) ) )
+        {
+            duk_push_string ( aContext, ColorToString ( std::get<Color> ( std::get<ColorAttr> ( attribute ) ) ).c_str() );
+        }
+        else
+        {
+            duk_push_null ( aContext );
+        }
+        return 1;
+    }
+
+    static duk_ret_t appendChild ( duk_context* aContext )
+    {
+        Element* element = GetThisElement ( aContext );
+        if ( element == nullptr || !duk_is_object ( aContext, 0 ) )
+        {
+            return DUK_RET_TYPE_ERROR;
+        }
+        duk_get_prop_string ( aContext, 0, ElementPointer );
+        Element* child = static_cast<Element*> ( duk_get_pointer ( aContext, -1 ) );
+        duk_pop ( aContext );
+        if ( child == nullptr )
+        {
+            return DUK_RET_TYPE_ERROR;
+        }
+        GetEngine ( aContext )->GetDOMBridge()->AppendChild ( element, child );
+        duk_dup ( aContext, 0 );
+        return 1;
+    }
+
+    static duk_ret_t requestAnimationFrame ( duk_context* aContext )
+    {
+        if ( !duk_is_function ( aContext, 0 ) )
+        {
+            return DUK_RET_TYPE_ERROR;
+        }
+        duk_dup ( aContext, 0 );
+        duk_push_uint ( aContext, GetEngine ( aContext )->RequestAnimationFrame() );
+        return 1;
+    }
+
+    static duk_ret_t cancelAnimationFrame ( duk_context* aContext )
+    {
+        if ( duk_is_number ( aContext, 0 ) )
+        {
+            GetEngine ( aContext )->CancelAnimationFrame ( duk_get_uint ( aContext, 0 ) );
+        }
+        return 0;
+    }
+
+    static void PutFunction ( duk_context* aContext, const char* aName, duk_c_function aFunction, duk_idx_t aArgumentCount )
+    {
+        duk_push_c_function ( aContext, aFunction, aArgumentCount );
+        duk_put_prop_string ( aContext, -2, aName );
+    }
+
+    JsDuktape::JsDuktape ( Window* aWindow, Document* aDocument ) :
+        mDOMBridge{std::make_unique<DirectDOMBridge> ( aDocument ) },
+        mContext{duk_create_heap ( Allocate, Reallocate, Free, this, OnFatalError ) }
+    {
+        if ( mContext == nullptr )
+        {
+            throw std::runtime_error ( "Failed to create Duktape heap" );
+        }
+
+        duk_push_heap_stash ( mContext );
+        duk_push_object ( mContext );
+        PutFunction ( mContext, "appendChild", appendChild, 1 );
+        PutFunction ( mContext, "setAttribute", setAttribute, 2 );
+        PutFunction ( mContext, "getAttribute", getAttribute, 1 );
+        duk_put_prop_string ( mContext, -2, ElementPrototype );
+        duk_push_object ( mContext );
+        duk_put_prop_string ( mContext, -2, ElementWrappers );
+        duk_push_object ( mContext );
+        duk_put_prop_string ( mContext, -2, AnimationFrames );
+        duk_pop ( mContext );
+
+        duk_push_global_object ( mContext );
+        // Proxy the global object thru the window property
+        duk_dup ( mContext, -1 );
+        duk_put_prop_string ( mContext, -2, "window" );
+        PutFunction ( mContext, "requestAnimationFrame", requestAnimationFrame, 1 );
+        PutFunction ( mContext, "cancelAnimationFrame", cancelAnimationFrame, 1 );
+
+        duk_push_object ( mContext );
+        PutFunction ( mContext, "log", log, DUK_VARARGS );
+        PutFunction ( mContext, "warn", log, DUK_VARARGS );
+        PutFunction ( mContext, "info", log, DUK_VARARGS );
+        PutFunction ( mContext, "error", log, DUK_VARARGS );
+        duk_put_prop_string ( mContext, -2, "console" );
+
+        duk_push_object ( mContext );
+        PutFunction ( mContext, "createElementNS", createElementNS, 2 );
+        PutFunction ( mContext, "getElementById", getElementById, 1 );
+        duk_put_prop_string ( mContext, -2, "document" );
+        duk_pop ( mContext );
+    }
+
+    JsDuktape::~JsDuktape()
+    {
+        duk_destroy_heap ( mContext );
+    }
+
+    DOMBridge* JsDuktape::GetDOMBridge() const
+    {
+        return mDOMBridge.get();
+    }
+
+    void* JsDuktape::Allocate ( void* aUserData, duk_size_t aSize )
+    {
+        char* block = static_cast<char*> ( std::malloc ( AllocationHeaderSize + aSize ) );
+        if ( block == nullptr )
+        {
+            return nullptr;
+        }
+        *reinterpret_cast<size_t*> ( block ) = aSize;
+        static_cast<JsDuktape*> ( aUserData )->mStatistics.heap_used += aSize;
+        return block + AllocationHeaderSize;
+    }
+
+    void* JsDuktape::Reallocate ( void* aUserData, void* aPointer, duk_size_t aSize )
+    {
+        if ( aPointer == nullptr )
+        {
+            return Allocate ( aUserData, aSize );
+        }
+        if ( aSize == 0 )
+        {
+            Free ( aUserData, aPointer );
+            return nullptr;
+        }
+        char* block = static_cast<char*> ( aPointer ) - AllocationHeaderSize;
+        const size_t previous_size = *reinterpret_cast<size_t*> ( block );
+        block = static_cast<char*> ( std::realloc ( block, AllocationHeaderSize + aSize ) );
+        if ( block == nullptr )
+        {
+            // The old block is untouched and still counted.
+            return nullptr;
+        }
+        *reinterpret_cast<size_t*> ( block ) = aSize;
+        ScriptStatistics& statistics = static_cast<JsDuktape*> ( aUserData )->mStatistics;
+        statistics.heap_used = statistics.heap_used - previous_size + aSize;
+        return block + AllocationHeaderSize;
+    }
+
+    void JsDuktape::Free ( void* aUserData, void* aPointer )
+    {
+        if ( aPointer == nullptr )
+        {
+            return;
+        }
+        char* block = static_cast<char*> ( aPointer ) - AllocationHeaderSize;
+        static_cast<JsDuktape*> ( aUserData )->mStatistics.heap_used -= *reinterpret_cast<size_t*> ( block );
+        std::free ( block );
+    }
+
+    void JsDuktape::Eval ( const std::string& aString )
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        if ( duk_pcompile_lstring ( mContext, 0, aString.data(), aString.size() ) != DUK_EXEC_SUCCESS )
+        {
+            mStatistics.compile_time += std::chrono::steady_clock::now() - start;
+            std::cerr << duk_safe_to_string ( mContext, -1 ) << std::endl;
+            duk_pop ( mContext );
+            return;
+        }
+        const std::chrono::steady_clock::time_point compiled = std::chrono::steady_clock::now();
+        mStatistics.compile_time += compiled - start;
+        if ( duk_pcall ( mContext, 0 ) != DUK_EXEC_SUCCESS )
+        {
+            std::cerr << duk_safe_to_string ( mContext, -1 ) << std::endl;
+        }
+        duk_pop ( mContext );
+        mStatistics.execute_time += std::chrono::steady_clock::now() - compiled;
+    }
+
+    ScriptStatistics JsDuktape::GetStatistics() const
+    {
+        return mStatistics;
+    }
+
+    bool JsDuktape::CollectGarbage ( std::chrono::steady_clock::time_point aDeadline )
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        if ( start >= aDeadline )
+        {
+            return false;
+        }
+        duk_gc ( mContext, 0 );
+        const std::chrono::nanoseconds pause = std::chrono::steady_clock::now() - start;
+        ++mStatistics.gc_count;
+        mStatistics.gc_pause_time += pause;
+        mStatistics.gc_longest_pause = std::max ( mStatistics.gc_longest_pause, pause );
+        return true;
+    }
+
+    /*  Wrappers are keyed by element address in the stash so every lookup of an element
+        yields the same object, the stash keeps them alive until the heap goes away.
+        A weak map would need finalizers that can tell a wrapper is unreachable while the
+        stash still references it, which Duktape has no way to express. */
+    void JsDuktape::PushObject ( Element* aElement )
+    {
+        const std::string key{std::to_string ( reinterpret_cast<uintptr_t> ( aElement ) ) };
+        duk_push_heap_stash ( mContext );
+        duk_get_prop_string ( mContext, -1, ElementWrappers );
+        if ( !duk_get_prop_string ( mContext, -1, key.c_str() ) )
+        {
+            duk_pop ( mContext );
+            duk_push_object ( mContext );
+            duk_push_pointer ( mContext, aElement );
+            duk_put_prop_string ( mContext, -2, ElementPointer );
+            duk_get_prop_string ( mContext, -3, ElementPrototype );
+            duk_set_prototype ( mContext, -2 );
+            duk_dup ( mContext, -1 );
+            duk_put_prop_string ( mContext, -3, key.c_str() );
+        }
+        // Leave only the wrapper on the stack.
+        duk_remove ( mContext, -2 );
+        duk_remove ( mContext, -2 );
+    }
+
+    uint32_t JsDuktape::RequestAnimationFrame()
+    {
+        uint32_t handle = mNextAnimationFrameHandle++;
+        if ( mNextAnimationFrameHandle == 0 )
+        {
+            mNextAnimationFrameHandle = 1;
+        }
+        duk_push_heap_stash ( mContext );
+        duk_get_prop_string ( mContext, -1, AnimationFrames );
+        duk_dup ( mContext, -3 );
+        duk_put_prop_string ( mContext, -2, std::to_string ( handle ).c_str() );
+        duk_pop_n ( mContext, 3 );
+        mAnimationFrameHandles.push_back ( handle );
+        return handle;
+    }
+
+    void JsDuktape::CancelAnimationFrame ( uint32_t aHandle )
+    {
+        // Callbacks due later in the running frame are skipped once their function is gone.
+        duk_push_heap_stash ( mContext );
+        duk_get_prop_string ( mContext, -1, AnimationFrames );
+        duk_del_prop_string ( mContext, -1, std::to_string ( aHandle ).c_str() );
+        duk_pop_2 ( mContext );
+        mAnimationFrameHandles.erase ( std::remove ( mAnimationFrameHandles.begin(), mAnimationFrameHandles.end(), aHandle ), mAnimationFrameHandles.end() );
+    }
+
+    bool JsDuktape::HasAnimationFrameCallbacks() const
+    {
+        return !mAnimationFrameHandles.empty();
+    }
+
+    bool JsDuktape::RunAnimationFrameCallbacks ( double aTimestamp, std::chrono::steady_clock::time_point aDeadline )
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        std::vector<uint32_t> running;
+        running.swap ( mAnimationFrameHandles );
+        size_t next{0};
+        bool completed{true};
+        duk_push_heap_stash ( mContext );
+        duk_get_prop_string ( mContext, -1, AnimationFrames );
+        for ( ; next < running.size(); ++next )
+        {
+            // At least one callback runs each frame so a tight budget still makes progress.
+            if ( next > 0 && std::chrono::steady_clock::now() >= aDeadline )
+            {
+                completed = false;
+                break;
+            }
+            const std::string key{std::to_string ( running[next] ) };
+            if ( !duk_get_prop_string ( mContext, -1, key.c_str() ) )
+            {
+                duk_pop ( mContext );
+                continue;
+            }
+            duk_del_prop_string ( mContext, -2, key.c_str() );
+            duk_push_number ( mContext, aTimestamp );
+            // One failing callback must not starve the rest of the frame.
+            if ( duk_pcall ( mContext, 1 ) != DUK_EXEC_SUCCESS )
+            {
+                std::cerr << "requestAnimationFrame callback threw: " << duk_safe_to_string ( mContext, -1 ) << std::endl;
+            }
+            duk_pop ( mContext );
+        }
+        // Callbacks the deadline cut off go first next frame, ahead of the ones registered meanwhile.
+        std::vector<uint32_t> deferred;
+        for ( ; next < running.size(); ++next )
+        {
+            // Skip the ones a callback cancelled.
+            if ( duk_get_prop_string ( mContext, -1, std::to_string ( running[next] ).c_str() ) )
+            {
+                deferred.push_back ( running[next] );
+            }
+            duk_pop ( mContext );
+        }
+        duk_pop_2 ( mContext );
+        mAnimationFrameHandles.insert ( mAnimationFrameHandles.begin(), deferred.begin(), deferred.end() );
+        mStatistics.execute_time += std::chrono::steady_clock::now() - start;
+        return completed;
+    }
+}
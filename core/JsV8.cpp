@@ -18,101 +18,278 @@ limitations under the License.
 #include <iostream>
 #include <iomanip>
 #include <sstream>
+#include <fstream>
+#include <filesystem>
+#include <atomic>
+#include <cstdlib>
+#include <algorithm>
+#include <iterator>
 #include "aeongui/JsV8.h"
+#include "aeongui/MappedFile.h"
 #include "aeongui/Window.h"
 #include "aeongui/Document.h"
+#include "JsV8Globals.h"
+#include "DOMBridge.h"
 
 namespace AeonGUI
 {
-    static void log ( const v8::FunctionCallbackInfo<v8::Value>& info )
+    // Generated at build time by aeongui-v8-snapshot, or empty from JsV8NoSnapshot.cpp.
+    extern const char V8StartupSnapshotData[];
+    extern const int V8StartupSnapshotSize;
+
+    /// Scripts shorter than this compile faster than their cache loads.
+    static constexpr size_t MinCodeCacheScriptSize{1024};
+    static std::atomic<size_t> gCodeCacheHits{};
+    static std::atomic<size_t> gCodeCacheMisses{};
+    static std::atomic<size_t> gCodeCacheRejections{};
+    static std::atomic<size_t> gWrappersLive{};
+    static std::atomic<size_t> gWrappersCreated{};
+    static std::atomic<size_t> gWrappersCollected{};
+    /// Isolate data slot for the collector counters, slot 0 holds the binding state.
+    static constexpr uint32_t GCStatisticsSlot{1};
+
+    /*  Collector activity of one isolate, updated by its GC callbacks.
+        With incremental and concurrent marking the callbacks bracket the part of
+        a collection that stops scripts, which is what shows up as a long frame. */
+    struct V8GCStatistics
+    {
+        size_t count{};
+        std::chrono::nanoseconds pause_time{};
+        std::chrono::nanoseconds longest_pause{};
+        std::chrono::steady_clock::time_point start{};
+    };
+
+    static void OnGCPrologue ( v8::Isolate* aIsolate, v8::GCType aType, v8::GCCallbackFlags aFlags, void* aData )
+    {
+        static_cast<V8GCStatistics*> ( aData )->start = std::chrono::steady_clock::now();
+    }
+
+    static void OnGCEpilogue ( v8::Isolate* aIsolate, v8::GCType aType, v8::GCCallbackFlags aFlags, void* aData )
+    {
+        V8GCStatistics* statistics = static_cast<V8GCStatistics*> ( aData );
+        const std::chrono::nanoseconds pause = std::chrono::steady_clock::now() - statistics->start;
+        ++statistics->count;
+        statistics->pause_time += pause;
+        statistics->longest_pause = std::max ( statistics->longest_pause, pause );
+    }
+
+    static std::filesystem::path GetCodeCacheDirectory()
     {
-        v8::Isolate* isolate = info.GetIsolate();
-        v8::HandleScope scope ( isolate );
-        for ( int i = 0; i < info.Length(); ++i )
+        if ( const char* directory = std::getenv ( "AEONGUI_CACHE_DIR" ) )
         {
-            if ( i > 0 )
-            {
-                std::cout << " ";
-            }
-            v8::String::Utf8Value utf8 ( isolate, info[i] );
-            std::cout << *utf8;
+            return directory;
+        }
+#ifdef _WIN32
+        if ( const char* directory = std::getenv ( "LOCALAPPDATA" ) )
+        {
+            return std::filesystem::path{directory} / "AeonGUI";
+        }
+#else
+        if ( const char* directory = std::getenv ( "XDG_CACHE_HOME" ) )
+        {
+            return std::filesystem::path{directory} / "aeongui";
         }
-        std::cout << std::endl;
-        info.GetReturnValue().Set ( info.Holder() );
+        if ( const char* directory = std::getenv ( "HOME" ) )
+        {
+            return std::filesystem::path{directory} / ".cache" / "aeongui";
+        }
+#endif
+        std::error_code error;
+        return std::filesystem::temp_directory_path ( error ) / "aeongui";
     }
 
-    static void createElementNS ( const v8::FunctionCallbackInfo<v8::Value>& info )
+    /*  Cache files are named after a FNV-1a hash of the source and V8's cached data version tag,
+        which changes with the V8 version and the flags that affect code generation.
+        V8 also checks both on its own and rejects blobs that do not match. */
+    static std::filesystem::path GetCodeCachePath ( const std::string& aSource )
     {
-        v8::Isolate* isolate = info.GetIsolate();
-        v8::HandleScope scope ( isolate );
-        info.GetReturnValue().Set ( info.Holder() );
+        uint64_t hash{0xcbf29ce484222325ULL};
+        for ( unsigned char c : aSource )
+        {
+            hash = ( hash ^ c ) * 0x100000001b3ULL;
+        }
+        std::ostringstream filename;
+        filename << std::hex << std::setfill ( '0' ) << std::setw ( 16 ) << hash << '-'
+                 << std::setw ( 8 ) << v8::ScriptCompiler::CachedDataVersionTag() << ".jsc";
+        return GetCodeCacheDirectory() / "v8" / filename.str();
     }
 
-    static void getElementById ( const v8::FunctionCallbackInfo<v8::Value>& info )
+    /*  Written to a temporary file and renamed into place,
+        so other sessions never map a partially written blob.
+        A blob damaged by two sessions writing at once fails V8's checksum
+        and is rejected and replaced like any stale one. */
+    static void WriteCodeCache ( const std::filesystem::path& aPath, const uint8_t* aData, int aLength )
     {
-        v8::Isolate* isolate = info.GetIsolate();
-        v8::HandleScope scope ( isolate );
-        info.GetReturnValue().Set ( info.Holder() );
+        std::error_code error;
+        std::filesystem::create_directories ( aPath.parent_path(), error );
+        std::filesystem::path temporary{aPath};
+        temporary += ".tmp";
+        {
+            std::ofstream file ( temporary, std::ios::binary | std::ios::trunc );
+            if ( !file.write ( reinterpret_cast<const char*> ( aData ), aLength ) )
+            {
+                return;
+            }
+        }
+        std::filesystem::rename ( temporary, aPath, error );
+        if ( error )
+        {
+            std::filesystem::remove ( temporary, error );
+        }
     }
 
-    V8::V8 ( Window* aWindow, Document* aDocument )
+    V8CodeCacheStatistics V8::GetCodeCacheStatistics()
     {
-        // Create a new Isolate and make it the current one.
+        return V8CodeCacheStatistics{gCodeCacheHits.load(), gCodeCacheMisses.load(), gCodeCacheRejections.load() };
+    }
+
+    /*  Isolates are not shared across threads, a window's scripts run on the thread
+        that created it and sharing one isolate between threads would need v8::Locker
+        on every call. */
+    static IsolatePtr AcquireIsolate()
+    {
+        thread_local std::weak_ptr<v8::Isolate> shared_isolate{};
+        if ( IsolatePtr isolate = shared_isolate.lock() )
+        {
+            return isolate;
+        }
         v8::Isolate::CreateParams create_params;
         create_params.array_buffer_allocator = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
-        mIsolate = IsolatePtr{v8::Isolate::New ( create_params ) };
+        create_params.external_references = V8ExternalReferences;
+        if ( V8StartupSnapshotSize != 0 )
+        {
+            static v8::StartupData snapshot{V8StartupSnapshotData, V8StartupSnapshotSize};
+            create_params.snapshot_blob = &snapshot;
+        }
+        v8::ArrayBuffer::Allocator* allocator = create_params.array_buffer_allocator;
+        V8GCStatistics* gc_statistics = new V8GCStatistics{};
+        IsolatePtr isolate
         {
-            v8::Isolate::Scope isolate_scope ( mIsolate.get() );
-            v8::HandleScope handle_scope ( mIsolate.get() );
+            v8::Isolate::New ( create_params ), [allocator, gc_statistics] ( v8::Isolate * aIsolate )
+            {
+                ReleaseV8IsolateData ( aIsolate );
+                aIsolate->Dispose();
+                delete gc_statistics;
+                delete allocator;
+            }
+        };
+        isolate->SetData ( GCStatisticsSlot, gc_statistics );
+        isolate->AddGCPrologueCallback ( OnGCPrologue, gc_statistics );
+        isolate->AddGCEpilogueCallback ( OnGCEpilogue, gc_statistics );
+        shared_isolate = isolate;
+        return isolate;
+    }
 
-            // Create Global Object Template
-            v8::Handle<v8::ObjectTemplate> global = v8::ObjectTemplate::New ( mIsolate.get() );
-            global->SetInternalFieldCount ( 1 );
+    V8::V8 ( Window* aWindow, Document* aDocument ) :
+        mOwnedDOMBridge{std::make_unique<DirectDOMBridge> ( aDocument ) },
+        mDOMBridge{mOwnedDOMBridge.get() },
+        mIsolate{AcquireIsolate() }
+    {
+        CreateContext ( aWindow );
+    }
 
-            // Create Console Object Template
-            v8::Handle<v8::ObjectTemplate> console = v8::ObjectTemplate::New ( mIsolate.get() );
-            console->Set ( v8::String::NewFromUtf8Literal ( mIsolate.get(), "log" ), v8::FunctionTemplate::New ( mIsolate.get(), log ) );
-            console->Set ( v8::String::NewFromUtf8Literal ( mIsolate.get(), "warn" ), v8::FunctionTemplate::New ( mIsolate.get(), log ) );
-            console->Set ( v8::String::NewFromUtf8Literal ( mIsolate.get(), "info" ), v8::FunctionTemplate::New ( mIsolate.get(), log ) );
-            console->Set ( v8::String::NewFromUtf8Literal ( mIsolate.get(), "error" ), v8::FunctionTemplate::New ( mIsolate.get(), log ) );
+    V8::V8 ( Window* aWindow, DOMBridge& aDOMBridge ) :
+        mDOMBridge{&aDOMBridge},
+        mIsolate{AcquireIsolate() }
+    {
+        CreateContext ( aWindow );
+    }
 
-            // Create Document Object Template
-            v8::Handle<v8::ObjectTemplate> document = v8::ObjectTemplate::New ( mIsolate.get() );
-            document->Set ( v8::String::NewFromUtf8Literal ( mIsolate.get(), "createElementNS" ), v8::FunctionTemplate::New ( mIsolate.get(), createElementNS ) );
-            document->Set ( v8::String::NewFromUtf8Literal ( mIsolate.get(), "getElementById" ), v8::FunctionTemplate::New ( mIsolate.get(), getElementById ) );
+    void V8::CreateContext ( Window* aWindow )
+    {
+        v8::Isolate::Scope isolate_scope ( mIsolate.get() );
+        v8::HandleScope handle_scope ( mIsolate.get() );
 
-            // Create Context
-            v8::Local<v8::Context> context = v8::Context::New ( mIsolate.get(), nullptr, global );
-            mGlobalContext.Reset ( mIsolate.get(), context );
-            v8::Context::Scope context_scope ( context );
+        // With a snapshot the window, console and document objects are deserialized along with the context.
+        v8::Local<v8::Context> context = ( V8StartupSnapshotSize != 0 ) ?
+                                         v8::Context::FromSnapshot ( mIsolate.get(), V8SnapshotContextIndex ).ToLocalChecked() :
+                                         v8::Context::New ( mIsolate.get(), nullptr, CreateV8GlobalTemplate ( mIsolate.get() ) );
+        mGlobalContext.Reset ( mIsolate.get(), context );
+        v8::Context::Scope context_scope ( context );
+        if ( V8StartupSnapshotSize == 0 )
+        {
+            InstallV8Globals ( mIsolate.get(), context );
+        }
 
-            // Store the Window pointer at the global object
-            context->Global()->SetInternalField ( 0, v8::External::New ( mIsolate.get(), aWindow ) );
+        // Store the Window and engine pointers at the global object
+        context->Global()->SetInternalField ( 0, v8::External::New ( mIsolate.get(), aWindow ) );
+        context->Global()->SetInternalField ( 1, v8::External::New ( mIsolate.get(), this ) );
+    }
 
-            // Proxy the global object thru the window property
-            context->Global()->Set ( context,
-                                     v8::String::NewFromUtf8Literal ( mIsolate.get(), "window" ),
-                                     context->Global() ).Check();
+    DOMBridge* V8::GetDOMBridge() const
+    {
+        return mDOMBridge;
+    }
+
+    v8::Isolate* V8::GetIsolate() const
+    {
+        return mIsolate.get();
+    }
+
+    /*  Scripts come from documents, a syntax error or an uncaught exception
+        is written out the same way Duktape does instead of taking the process down. */
+    static void ReportException ( v8::Isolate* aIsolate, const v8::TryCatch& aTryCatch )
+    {
+        if ( aTryCatch.HasTerminated() )
+        {
+            std::cerr << "Script terminated." << std::endl;
+            return;
+        }
+        v8::String::Utf8Value exception ( aIsolate, aTryCatch.Exception() );
+        v8::Local<v8::Message> message = aTryCatch.Message();
+        if ( !message.IsEmpty() )
+        {
+            std::cerr << "Script error at line " << message->GetLineNumber ( aIsolate->GetCurrentContext() ).FromMaybe ( 0 ) << ": " << *exception << std::endl;
+        }
+        else
+        {
+            std::cerr << "Script error: " << *exception << std::endl;
+        }
+    }
 
-            // Add the console object to the global object
-            context->Global()->Set ( context,
-                                     v8::String::NewFromUtf8Literal ( mIsolate.get(), "console" ),
-                                     console->NewInstance ( context ).ToLocalChecked() ).Check();
+    V8WrapperStatistics V8::GetWrapperStatistics()
+    {
+        return V8WrapperStatistics{gWrappersLive.load(), gWrappersCreated.load(), gWrappersCollected.load() };
+    }
 
-            // Add the document object to the global object
-            context->Global()->Set ( context,
-                                     v8::String::NewFromUtf8Literal ( mIsolate.get(), "document" ),
-                                     document->NewInstance ( context ).ToLocalChecked() ).Check();
+    v8::Local<v8::Object> V8::CreateObject ( Element* aElement )
+    {
+        auto cached = mWrappers.find ( aElement );
+        if ( cached != mWrappers.end() )
+        {
+            return cached->second->object.Get ( mIsolate.get() );
         }
+        v8::Local<v8::Object> object = GetV8IsolateData ( mIsolate.get() ).element_template.Get ( mIsolate.get() )->InstanceTemplate()->NewInstance ( mIsolate->GetCurrentContext() ).ToLocalChecked();
+        object->SetInternalField ( 0, v8::External::New ( mIsolate.get(), aElement ) );
+        std::unique_ptr<Wrapper> wrapper{new Wrapper{this, aElement, v8::Global<v8::Object>{mIsolate.get(), object}}};
+        wrapper->object.SetWeak ( wrapper.get(), OnWrapperCollected, v8::WeakCallbackType::kParameter );
+        mWrappers.emplace ( aElement, std::move ( wrapper ) );
+        ++gWrappersCreated;
+        ++gWrappersLive;
+        return object;
     }
 
-    void V8::CreateObject ( Node* aNode )
+    void V8::OnWrapperCollected ( const v8::WeakCallbackInfo<Wrapper>& aInfo )
     {
+        Wrapper* wrapper = aInfo.GetParameter();
+        // V8 requires weak handles to be reset from their first pass callback.
+        wrapper->object.Reset();
+        ++gWrappersCollected;
+        --gWrappersLive;
+        wrapper->engine->mWrappers.erase ( wrapper->element );
     }
 
     V8::~V8()
     {
+        // The shared isolate may be entered by another window or by none at all.
+        v8::Isolate::Scope isolate_scope ( mIsolate.get() );
+        mAnimationFrameCallbacks.clear();
+        mRunningAnimationFrameCallbacks.clear();
+        gWrappersLive -= mWrappers.size();
+        mWrappers.clear();
         mGlobalContext.Reset();
+        // Let the shared isolate know a whole context worth of objects just became garbage.
+        mIsolate->ContextDisposedNotification();
     }
 
     void V8::Eval ( const std::string& aString )
@@ -122,20 +299,222 @@ namespace AeonGUI
         v8::Local<v8::Context> context =
             v8::Local<v8::Context>::New ( mIsolate.get(), mGlobalContext );
         v8::Context::Scope context_scope ( context );
+        v8::TryCatch try_catch ( mIsolate.get() );
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
         v8::Local<v8::String> source =
             v8::String::NewFromUtf8 ( mIsolate.get(), aString.data(),
                                       v8::NewStringType::kNormal )
             .ToLocalChecked();
-        v8::Local<v8::Script> script =
-            v8::Script::Compile ( context, source ).ToLocalChecked();
-#if 0
-        v8::Local<v8::Value> result = script->Run ( context ).ToLocalChecked();
-        v8::String::Utf8Value utf8 ( mIsolate.get(), result );
-        std::cout << *utf8 << std::endl;
-#else
+        v8::Local<v8::Script> script;
+        const bool compiled_script = v8::Script::Compile ( context, source ).ToLocal ( &script );
+        const std::chrono::steady_clock::time_point compiled = std::chrono::steady_clock::now();
+        mCompileTime += compiled - start;
+        if ( !compiled_script )
+        {
+            ReportException ( mIsolate.get(), try_catch );
+            return;
+        }
         /**@todo Eval should return a value,
          * but it must an engine independent wrapper.*/
-        script->Run ( context ).ToLocalChecked();
-#endif
+        if ( script->Run ( context ).IsEmpty() )
+        {
+            ReportException ( mIsolate.get(), try_catch );
+        }
+        mExecuteTime += std::chrono::steady_clock::now() - compiled;
+    }
+
+    void V8::EvalScript ( const std::string& aString )
+    {
+        if ( aString.size() < MinCodeCacheScriptSize )
+        {
+            Eval ( aString );
+            return;
+        }
+        v8::Isolate::Scope isolate_scope ( mIsolate.get() );
+        v8::HandleScope handle_scope ( mIsolate.get() );
+        v8::Local<v8::Context> context =
+            v8::Local<v8::Context>::New ( mIsolate.get(), mGlobalContext );
+        v8::Context::Scope context_scope ( context );
+        v8::TryCatch try_catch ( mIsolate.get() );
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        v8::Local<v8::String> source =
+            v8::String::NewFromUtf8 ( mIsolate.get(), aString.data(),
+                                      v8::NewStringType::kNormal, static_cast<int> ( aString.size() ) )
+            .ToLocalChecked();
+
+        std::filesystem::path cache_path = GetCodeCachePath ( aString );
+        MappedFile cache;
+        bool produce_cache{true};
+        v8::Local<v8::Script> script;
+        if ( cache.Open ( cache_path.string().c_str() ) )
+        {
+            // The source owns the CachedData object, the mapped buffer is only borrowed.
+            v8::ScriptCompiler::Source script_source ( source,
+                    new v8::ScriptCompiler::CachedData ( cache.GetData(), static_cast<int> ( cache.GetSize() ),
+                            v8::ScriptCompiler::CachedData::BufferNotOwned ) );
+            v8::ScriptCompiler::Compile ( context, &script_source, v8::ScriptCompiler::kConsumeCodeCache ).ToLocal ( &script );
+            if ( script_source.GetCachedData()->rejected )
+            {
+                // V8 already fell back to compiling the source, replace the stale blob.
+                ++gCodeCacheRejections;
+            }
+            else
+            {
+                ++gCodeCacheHits;
+                produce_cache = false;
+            }
+        }
+        else
+        {
+            ++gCodeCacheMisses;
+            v8::ScriptCompiler::Source script_source ( source );
+            v8::ScriptCompiler::Compile ( context, &script_source ).ToLocal ( &script );
+        }
+        cache.Close();
+
+        const std::chrono::steady_clock::time_point compiled = std::chrono::steady_clock::now();
+        mCompileTime += compiled - start;
+        if ( script.IsEmpty() )
+        {
+            ReportException ( mIsolate.get(), try_catch );
+            return;
+        }
+        const bool ran = !script->Run ( context ).IsEmpty();
+        const std::chrono::steady_clock::time_point executed = std::chrono::steady_clock::now();
+        mExecuteTime += executed - compiled;
+        if ( !ran )
+        {
+            // A script that threw or was terminated half way does not get its lazy functions cached.
+            ReportException ( mIsolate.get(), try_catch );
+            return;
+        }
+
+        /*  Created after the first run so functions compiled lazily
+            while the script ran are part of the cache as well. */
+        if ( produce_cache )
+        {
+            std::unique_ptr<v8::ScriptCompiler::CachedData> cached_data{v8::ScriptCompiler::CreateCodeCache ( script->GetUnboundScript() ) };
+            if ( cached_data && cached_data->length > 0 )
+            {
+                WriteCodeCache ( cache_path, cached_data->data, cached_data->length );
+            }
+            mCompileTime += std::chrono::steady_clock::now() - executed;
+        }
+    }
+
+    bool V8::HasAnimationFrameCallbacks() const
+    {
+        return !mAnimationFrameCallbacks.empty();
+    }
+
+    uint32_t V8::RequestAnimationFrame ( v8::Local<v8::Function> aCallback )
+    {
+        uint32_t handle = mNextAnimationFrameHandle++;
+        if ( mNextAnimationFrameHandle == 0 )
+        {
+            mNextAnimationFrameHandle = 1;
+        }
+        mAnimationFrameCallbacks.emplace_back ( AnimationFrameCallback{handle, v8::Global<v8::Function>{mIsolate.get(), aCallback}} );
+        return handle;
+    }
+
+    void V8::CancelAnimationFrame ( uint32_t aHandle )
+    {
+        auto pending = std::find_if ( mAnimationFrameCallbacks.begin(), mAnimationFrameCallbacks.end(),
+                                      [aHandle] ( const AnimationFrameCallback & aCallback )
+        {
+            return aCallback.handle == aHandle;
+        } );
+        if ( pending != mAnimationFrameCallbacks.end() )
+        {
+            mAnimationFrameCallbacks.erase ( pending );
+            return;
+        }
+        // A callback may cancel one that is due later in the same frame.
+        for ( auto& running : mRunningAnimationFrameCallbacks )
+        {
+            if ( running.handle == aHandle )
+            {
+                running.callback.Reset();
+                return;
+            }
+        }
+    }
+
+    bool V8::RunAnimationFrameCallbacks ( double aTimestamp, std::chrono::steady_clock::time_point aDeadline )
+    {
+        if ( mAnimationFrameCallbacks.empty() )
+        {
+            return true;
+        }
+        v8::Isolate::Scope isolate_scope ( mIsolate.get() );
+        v8::HandleScope handle_scope ( mIsolate.get() );
+        v8::Local<v8::Context> context =
+            v8::Local<v8::Context>::New ( mIsolate.get(), mGlobalContext );
+        v8::Context::Scope context_scope ( context );
+        v8::Local<v8::Value> timestamp = v8::Number::New ( mIsolate.get(), aTimestamp );
+
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        mRunningAnimationFrameCallbacks.swap ( mAnimationFrameCallbacks );
+        size_t next{0};
+        bool completed{true};
+        for ( ; next < mRunningAnimationFrameCallbacks.size(); ++next )
+        {
+            // At least one callback runs each frame so a tight budget still makes progress.
+            if ( next > 0 && std::chrono::steady_clock::now() >= aDeadline )
+            {
+                completed = false;
+                break;
+            }
+            AnimationFrameCallback& callback = mRunningAnimationFrameCallbacks[next];
+            if ( callback.callback.IsEmpty() )
+            {
+                continue;
+            }
+            v8::Local<v8::Function> function = callback.callback.Get ( mIsolate.get() );
+            callback.callback.Reset();
+            // One failing callback must not starve the rest of the frame.
+            v8::TryCatch try_catch ( mIsolate.get() );
+            if ( function->Call ( context, context->Global(), 1, &timestamp ).IsEmpty() && try_catch.HasCaught() )
+            {
+                v8::String::Utf8Value exception ( mIsolate.get(), try_catch.Exception() );
+                std::cerr << "requestAnimationFrame callback threw: " << *exception << std::endl;
+            }
+        }
+        // Callbacks the deadline cut off go first next frame, ahead of the ones registered meanwhile.
+        mRunningAnimationFrameCallbacks.erase ( mRunningAnimationFrameCallbacks.begin(), mRunningAnimationFrameCallbacks.begin() + next );
+        mRunningAnimationFrameCallbacks.erase ( std::remove_if ( mRunningAnimationFrameCallbacks.begin(), mRunningAnimationFrameCallbacks.end(),
+                                                [] ( const AnimationFrameCallback & aCallback )
+        {
+            return aCallback.callback.IsEmpty();
+        } ), mRunningAnimationFrameCallbacks.end() );
+        mAnimationFrameCallbacks.insert ( mAnimationFrameCallbacks.begin(),
+                                          std::make_move_iterator ( mRunningAnimationFrameCallbacks.begin() ),
+                                          std::make_move_iterator ( mRunningAnimationFrameCallbacks.end() ) );
+        mRunningAnimationFrameCallbacks.clear();
+        mExecuteTime += std::chrono::steady_clock::now() - start;
+        return completed;
+    }
+
+    ScriptStatistics V8::GetStatistics() const
+    {
+        v8::HeapStatistics heap;
+        mIsolate->GetHeapStatistics ( &heap );
+        const V8GCStatistics* gc = static_cast<const V8GCStatistics*> ( mIsolate->GetData ( GCStatisticsSlot ) );
+        return ScriptStatistics{mCompileTime, mExecuteTime, heap.used_heap_size(), heap.heap_size_limit(), gc->count, gc->pause_time, gc->longest_pause};
+    }
+
+    /*  V8 measures idle deadlines on the platform clock, which need not share
+        an epoch with std::chrono::steady_clock, so only the remaining time carries over. */
+    bool V8::CollectGarbage ( std::chrono::steady_clock::time_point aDeadline )
+    {
+        v8::Platform* platform = GetV8Platform();
+        const std::chrono::duration<double> idle_time = aDeadline - std::chrono::steady_clock::now();
+        if ( platform == nullptr || idle_time.count() <= 0.0 )
+        {
+            return false;
+        }
+        v8::Isolate::Scope isolate_scope ( mIsolate.get() );
+        return mIsolate->IdleNotificationDeadline ( platform->MonotonicallyIncreasingTime() + idle_time.count() );
     }
 }
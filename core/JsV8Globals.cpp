@@ -0,0 +1,300 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <iostream>
+#include "JsV8Globals.h"
+#include "aeongui/JsV8.h"
+#include "DOMBridge.h"
+#include "dom/Element.h"
+
+namespace AeonGUI
+{
+    static void log ( const v8::FunctionCallbackInfo<v8::Value>& info )
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        v8::HandleScope scope ( isolate );
+        for ( int i = 0; i < info.Length(); ++i )
+        {
+            if ( i > 0 )
+            {
+                std::cout << " ";
+            }
+            v8::String::Utf8Value utf8 ( isolate, info[i] );
+            std::cout << *utf8;
+        }
+        std::cout << std::endl;
+        info.GetReturnValue().Set ( info.Holder() );
+    }
+
+    /*  Native objects are kept as v8::External in the first internal field,
+        anything else, such as a method called on the wrong object, unwraps to nullptr. */
+    template<class T> static T* Unwrap ( v8::Local<v8::Object> aObject )
+    {
+        if ( aObject->InternalFieldCount() < 1 )
+        {
+            return nullptr;
+        }
+        v8::Local<v8::Value> field = aObject->GetInternalField ( 0 );
+        if ( !field->IsExternal() )
+        {
+            return nullptr;
+        }
+        return static_cast<T*> ( v8::Local<v8::External>::Cast ( field )->Value() );
+    }
+
+    /*  The engine is kept in the second internal field of the global object. */
+    static V8* GetEngine ( v8::Isolate* aIsolate )
+    {
+        v8::Local<v8::Object> global = aIsolate->GetCurrentContext()->Global();
+        if ( global->InternalFieldCount() < 2 )
+        {
+            return nullptr;
+        }
+        v8::Local<v8::Value> field = global->GetInternalField ( 1 );
+        if ( !field->IsExternal() )
+        {
+            return nullptr;
+        }
+        return static_cast<V8*> ( v8::Local<v8::External>::Cast ( field )->Value() );
+    }
+
+    static v8::Local<v8::Value> WrapElement ( v8::Isolate* aIsolate, Element* aElement )
+    {
+        V8* engine = GetEngine ( aIsolate );
+        if ( engine == nullptr || aElement == nullptr )
+        {
+            return v8::Null ( aIsolate );
+        }
+        return engine->CreateObject ( aElement );
+    }
+
+    static v8::Local<v8::Value> AttributeToValue ( v8::Isolate* aIsolate, const AttributeType& aAttribute )
+    {
+        if ( std::holds_alternative<double> ( aAttribute ) )
+        {
+            return v8::Number::New ( aIsolate, std::get<double> ( aAttribute ) );
+        }
+        else if ( std::holds_alternative<std::string> ( aAttribute ) )
+        {
+            return v8::String::NewFromUtf8 ( aIsolate, std::get<std::string> ( aAttribute ).c_str() ).ToLocalChecked();
+        }
+        else if ( std::holds_alternative<ColorAttr> ( aAttribute ) )
+        {
+            const ColorAttr& color_attr = std::get<ColorAttr> ( aAttribute );
+            if ( std::holds_alternative<none> ( color_attr ) )
+            {
+                return v8::String::NewFromUtf8Literal ( aIsolate, "none" );
+            }
+            else if ( std::holds_alternative<Color> ( color_attr ) )
+            {
+                return v8::String::NewFromUtf8 ( aIsolate, ColorToString ( std::get<Color> ( color_attr ) ).c_str() ).ToLocalChecked();
+            }
+        }
+        return v8::Null ( aIsolate );
+    }
+
+    static DOMBridge* GetDOMBridge ( v8::Isolate* aIsolate )
+    {
+        V8* engine = GetEngine ( aIsolate );
+        return ( engine != nullptr ) ? engine->GetDOMBridge() : nullptr;
+    }
+
+    static void createElementNS ( const v8::FunctionCallbackInfo<v8::Value>& info )
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        v8::HandleScope scope ( isolate );
+        DOMBridge* bridge = GetDOMBridge ( isolate );
+        if ( bridge == nullptr || info.Length() < 2 )
+        {
+            info.GetReturnValue().SetNull();
+            return;
+        }
+        v8::String::Utf8Value name_space ( isolate, info[0] );
+        v8::String::Utf8Value qualified_name ( isolate, info[1] );
+        info.GetReturnValue().Set ( WrapElement ( isolate, bridge->CreateElementNS ( *name_space, *qualified_name ) ) );
+    }
+
+    static void getElementById ( const v8::FunctionCallbackInfo<v8::Value>& info )
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        v8::HandleScope scope ( isolate );
+        DOMBridge* bridge = GetDOMBridge ( isolate );
+        if ( bridge == nullptr || info.Length() < 1 )
+        {
+            info.GetReturnValue().SetNull();
+            return;
+        }
+        v8::String::Utf8Value id ( isolate, info[0] );
+        info.GetReturnValue().Set ( WrapElement ( isolate, bridge->GetElementById ( *id ) ) );
+    }
+
+    static void setAttribute ( const v8::FunctionCallbackInfo<v8::Value>& info )
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        v8::HandleScope scope ( isolate );
+        DOMBridge* bridge = GetDOMBridge ( isolate );
+        Element* element = Unwrap<Element> ( info.Holder() );
+        if ( bridge == nullptr || element == nullptr || info.Length() < 2 )
+        {
+            return;
+        }
+        v8::String::Utf8Value name ( isolate, info[0] );
+        v8::String::Utf8Value value ( isolate, info[1] );
+        bridge->SetAttribute ( element, *name, *value );
+    }
+
+    static void getAttribute ( const v8::FunctionCallbackInfo<v8::Value>& info )
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        v8::HandleScope scope ( isolate );
+        DOMBridge* bridge = GetDOMBridge ( isolate );
+        Element* element = Unwrap<Element> ( info.Holder() );
+        if ( bridge == nullptr || element == nullptr || info.Length() < 1 )
+        {
+            info.GetReturnValue().SetNull();
+            return;
+        }
+        v8::String::Utf8Value name ( isolate, info[0] );
+        info.GetReturnValue().Set ( AttributeToValue ( isolate, bridge->GetAttribute ( element, *name ) ) );
+    }
+
+    static void appendChild ( const v8::FunctionCallbackInfo<v8::Value>& info )
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        v8::HandleScope scope ( isolate );
+        DOMBridge* bridge = GetDOMBridge ( isolate );
+        Element* element = Unwrap<Element> ( info.Holder() );
+        if ( bridge == nullptr || element == nullptr || info.Length() < 1 || !info[0]->IsObject() )
+        {
+            info.GetReturnValue().SetNull();
+            return;
+        }
+        Element* child = Unwrap<Element> ( v8::Local<v8::Object>::Cast ( info[0] ) );
+        if ( child == nullptr )
+        {
+            info.GetReturnValue().SetNull();
+            return;
+        }
+        bridge->AppendChild ( element, child );
+        info.GetReturnValue().Set ( info[0] );
+    }
+
+    static void requestAnimationFrame ( const v8::FunctionCallbackInfo<v8::Value>& info )
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        v8::HandleScope scope ( isolate );
+        V8* engine = GetEngine ( isolate );
+        if ( engine == nullptr || info.Length() < 1 || !info[0]->IsFunction() )
+        {
+            isolate->ThrowException ( v8::String::NewFromUtf8Literal ( isolate, "requestAnimationFrame expects a function" ) );
+            return;
+        }
+        info.GetReturnValue().Set ( engine->RequestAnimationFrame ( v8::Local<v8::Function>::Cast ( info[0] ) ) );
+    }
+
+    static void cancelAnimationFrame ( const v8::FunctionCallbackInfo<v8::Value>& info )
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        v8::HandleScope scope ( isolate );
+        V8* engine = GetEngine ( isolate );
+        if ( engine == nullptr || info.Length() < 1 || !info[0]->IsNumber() )
+        {
+            return;
+        }
+        engine->CancelAnimationFrame ( info[0]->Uint32Value ( isolate->GetCurrentContext() ).FromMaybe ( 0 ) );
+    }
+
+    const intptr_t V8ExternalReferences[] =
+    {
+        reinterpret_cast<intptr_t> ( log ),
+        reinterpret_cast<intptr_t> ( createElementNS ),
+        reinterpret_cast<intptr_t> ( getElementById ),
+        reinterpret_cast<intptr_t> ( setAttribute ),
+        reinterpret_cast<intptr_t> ( getAttribute ),
+        reinterpret_cast<intptr_t> ( appendChild ),
+        reinterpret_cast<intptr_t> ( requestAnimationFrame ),
+        reinterpret_cast<intptr_t> ( cancelAnimationFrame ),
+        0
+    };
+
+    v8::Local<v8::ObjectTemplate> CreateV8GlobalTemplate ( v8::Isolate* aIsolate )
+    {
+        v8::Local<v8::ObjectTemplate> global = v8::ObjectTemplate::New ( aIsolate );
+        global->SetInternalFieldCount ( 2 );
+        global->Set ( v8::String::NewFromUtf8Literal ( aIsolate, "requestAnimationFrame" ), v8::FunctionTemplate::New ( aIsolate, requestAnimationFrame ) );
+        global->Set ( v8::String::NewFromUtf8Literal ( aIsolate, "cancelAnimationFrame" ), v8::FunctionTemplate::New ( aIsolate, cancelAnimationFrame ) );
+        return global;
+    }
+
+    void InstallV8Globals ( v8::Isolate* aIsolate, v8::Local<v8::Context> aContext )
+    {
+        // Create Console Object Template
+        v8::Local<v8::ObjectTemplate> console = v8::ObjectTemplate::New ( aIsolate );
+        console->Set ( v8::String::NewFromUtf8Literal ( aIsolate, "log" ), v8::FunctionTemplate::New ( aIsolate, log ) );
+        console->Set ( v8::String::NewFromUtf8Literal ( aIsolate, "warn" ), v8::FunctionTemplate::New ( aIsolate, log ) );
+        console->Set ( v8::String::NewFromUtf8Literal ( aIsolate, "info" ), v8::FunctionTemplate::New ( aIsolate, log ) );
+        console->Set ( v8::String::NewFromUtf8Literal ( aIsolate, "error" ), v8::FunctionTemplate::New ( aIsolate, log ) );
+
+        // Create Document Object Template
+        v8::Local<v8::ObjectTemplate> document = v8::ObjectTemplate::New ( aIsolate );
+        document->Set ( v8::String::NewFromUtf8Literal ( aIsolate, "createElementNS" ), v8::FunctionTemplate::New ( aIsolate, createElementNS ) );
+        document->Set ( v8::String::NewFromUtf8Literal ( aIsolate, "getElementById" ), v8::FunctionTemplate::New ( aIsolate, getElementById ) );
+
+        // Proxy the global object thru the window property
+        aContext->Global()->Set ( aContext,
+                                  v8::String::NewFromUtf8Literal ( aIsolate, "window" ),
+                                  aContext->Global() ).Check();
+
+        // Add the console object to the global object
+        aContext->Global()->Set ( aContext,
+                                  v8::String::NewFromUtf8Literal ( aIsolate, "console" ),
+                                  console->NewInstance ( aContext ).ToLocalChecked() ).Check();
+
+        // Add the document object to the global object
+        aContext->Global()->Set ( aContext,
+                                  v8::String::NewFromUtf8Literal ( aIsolate, "document" ),
+                                  document->NewInstance ( aContext ).ToLocalChecked() ).Check();
+    }
+
+    V8IsolateData& GetV8IsolateData ( v8::Isolate* aIsolate )
+    {
+        V8IsolateData* data = static_cast<V8IsolateData*> ( aIsolate->GetData ( 0 ) );
+        if ( data == nullptr )
+        {
+            data = new V8IsolateData{};
+            v8::HandleScope scope ( aIsolate );
+            // Wrapper templates are used at run time only and never stored in the snapshot.
+            v8::Local<v8::FunctionTemplate> node = v8::FunctionTemplate::New ( aIsolate );
+            node->InstanceTemplate()->SetInternalFieldCount ( 1 );
+            node->PrototypeTemplate()->Set ( v8::String::NewFromUtf8Literal ( aIsolate, "appendChild" ), v8::FunctionTemplate::New ( aIsolate, appendChild ) );
+            v8::Local<v8::FunctionTemplate> element = v8::FunctionTemplate::New ( aIsolate );
+            element->Inherit ( node );
+            element->InstanceTemplate()->SetInternalFieldCount ( 1 );
+            element->PrototypeTemplate()->Set ( v8::String::NewFromUtf8Literal ( aIsolate, "setAttribute" ), v8::FunctionTemplate::New ( aIsolate, setAttribute ) );
+            element->PrototypeTemplate()->Set ( v8::String::NewFromUtf8Literal ( aIsolate, "getAttribute" ), v8::FunctionTemplate::New ( aIsolate, getAttribute ) );
+            data->node_template.Reset ( aIsolate, node );
+            data->element_template.Reset ( aIsolate, element );
+            aIsolate->SetData ( 0, data );
+        }
+        return *data;
+    }
+
+    void ReleaseV8IsolateData ( v8::Isolate* aIsolate )
+    {
+        delete static_cast<V8IsolateData*> ( aIsolate->GetData ( 0 ) );
+        aIsolate->SetData ( 0, nullptr );
+    }
+}
@@ -0,0 +1,50 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGUI_JSV8GLOBALS_H
+#define AEONGUI_JSV8GLOBALS_H
+#include <cstdint>
+#include <cstddef>
+#include "v8.h"
+
+namespace AeonGUI
+{
+    /** Index of the AeonGUI context in the startup snapshot. */
+    constexpr size_t V8SnapshotContextIndex{0};
+    /** Native callbacks referenced by the AeonGUI global environment,
+     *  null terminated as both v8::SnapshotCreator and v8::Isolate::CreateParams expect. */
+    extern const intptr_t V8ExternalReferences[];
+    /** Creates the global object template,
+     *  its internal fields hold the Window and V8 engine pointers. */
+    v8::Local<v8::ObjectTemplate> CreateV8GlobalTemplate ( v8::Isolate* aIsolate );
+    /** Adds the window, console and document objects to the global object of a new context. */
+    void InstallV8Globals ( v8::Isolate* aIsolate, v8::Local<v8::Context> aContext );
+
+    /** Per isolate binding state, kept in isolate data slot 0.
+     *  Wrapper templates follow the DOM class hierarchy,
+     *  instances keep the native object in their single internal field. */
+    struct V8IsolateData
+    {
+        v8::Global<v8::FunctionTemplate> node_template;
+        v8::Global<v8::FunctionTemplate> element_template;
+    };
+    /** @return The binding state of an isolate, created on first use. */
+    V8IsolateData& GetV8IsolateData ( v8::Isolate* aIsolate );
+    /** Frees the binding state, call before disposing the isolate. */
+    void ReleaseV8IsolateData ( v8::Isolate* aIsolate );
+    /** @return The platform set up by AeonGUI::Initialize, null before that or after Finalize. */
+    v8::Platform* GetV8Platform();
+}
+#endif
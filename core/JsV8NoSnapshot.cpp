@@ -0,0 +1,26 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+/*  Stands in for the generated V8StartupSnapshot.cpp when there is no snapshot,
+    either because USE_V8_SNAPSHOT is off or because this is the generator itself.
+    A size of zero makes V8 build contexts from templates. */
+namespace AeonGUI
+{
+    extern const char V8StartupSnapshotData[];
+    extern const int V8StartupSnapshotSize;
+    const char V8StartupSnapshotData[] = {0};
+    const int V8StartupSnapshotSize = 0;
+}
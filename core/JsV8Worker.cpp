@@ -0,0 +1,192 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <chrono>
+#include <future>
+#include <optional>
+#include "aeongui/JsV8Worker.h"
+#include "aeongui/JsV8.h"
+#include "DOMBridge.h"
+
+namespace AeonGUI
+{
+    V8Worker::V8Worker ( Window* aWindow, Document* aDocument ) :
+        mDOMBridge{std::make_unique<QueuedDOMBridge> ( aDocument ) },
+        mThread{&V8Worker::Run, this, aWindow}
+    {
+    }
+
+    V8Worker::~V8Worker()
+    {
+        mStopping.store ( true, std::memory_order_release );
+        Wake();
+        /*  A script may never return on its own, so it is terminated,
+            again on every pass in case the worker had not entered it yet.
+            It may also be blocked on a document read, keep serving reads until the worker is done. */
+        while ( !mFinished.load ( std::memory_order_acquire ) )
+        {
+            {
+                std::lock_guard<std::mutex> lock ( mIsolateMutex );
+                if ( mIsolate != nullptr )
+                {
+                    mIsolate->TerminateExecution();
+                }
+            }
+            mDOMBridge->ProcessCommands();
+            std::this_thread::sleep_for ( std::chrono::milliseconds{1} );
+        }
+        mThread.join();
+    }
+
+    void V8Worker::Wake()
+    {
+        mTaskSignal.fetch_add ( 1, std::memory_order_release );
+        mTaskSignal.notify_one();
+    }
+
+    void V8Worker::Post ( Task&& aTask, bool aScripted )
+    {
+        if ( aScripted )
+        {
+            mOutstandingScripts.fetch_add ( 1, std::memory_order_acq_rel );
+        }
+        mTasks.Push ( PostedTask{std::move ( aTask ), aScripted} );
+        Wake();
+    }
+
+    /*  The signal is read before draining the queue,
+        so a post that lands after the queue looked empty changes it and wait returns at once. */
+    void V8Worker::Run ( Window* aWindow )
+    {
+        {
+            V8 engine{aWindow, *mDOMBridge};
+            {
+                std::lock_guard<std::mutex> lock ( mIsolateMutex );
+                mIsolate = engine.GetIsolate();
+            }
+            for ( ;; )
+            {
+                uint32_t signal = mTaskSignal.load ( std::memory_order_acquire );
+                while ( std::optional<PostedTask> task = mTasks.Pop() )
+                {
+                    // Once stopping, queued tasks are dropped, the destructor would only terminate them.
+                    if ( !mStopping.load ( std::memory_order_acquire ) )
+                    {
+                        task->run ( engine );
+                    }
+                    mHasAnimationFrameCallbacks.store ( engine.HasAnimationFrameCallbacks(), std::memory_order_release );
+                    const ScriptStatistics statistics = engine.GetStatistics();
+                    {
+                        std::lock_guard<std::mutex> lock ( mStatisticsMutex );
+                        mStatistics = statistics;
+                    }
+                    if ( task->scripted )
+                    {
+                        mOutstandingScripts.fetch_sub ( 1, std::memory_order_acq_rel );
+                    }
+                }
+                if ( mStopping.load ( std::memory_order_acquire ) )
+                {
+                    break;
+                }
+                mTaskSignal.wait ( signal, std::memory_order_acquire );
+            }
+            // No termination may reach the isolate after this, nor linger on it while the engine goes away.
+            std::lock_guard<std::mutex> lock ( mIsolateMutex );
+            mIsolate = nullptr;
+            engine.GetIsolate()->CancelTerminateExecution();
+        }
+        mFinished.store ( true, std::memory_order_release );
+    }
+
+    void V8Worker::Eval ( const std::string& aString )
+    {
+        Post ( [aString] ( V8 & aEngine )
+        {
+            aEngine.Eval ( aString );
+        } );
+    }
+
+    void V8Worker::EvalScript ( const std::string& aString )
+    {
+        Post ( [aString] ( V8 & aEngine )
+        {
+            aEngine.EvalScript ( aString );
+        } );
+    }
+
+    bool V8Worker::HasAnimationFrameCallbacks() const
+    {
+        // A frame still running will queue document writes the window has yet to draw.
+        return mHasAnimationFrameCallbacks.load ( std::memory_order_acquire ) ||
+               mFrameInFlight.load ( std::memory_order_acquire );
+    }
+
+    bool V8Worker::RunAnimationFrameCallbacks ( double aTimestamp, std::chrono::steady_clock::time_point aDeadline )
+    {
+        if ( mFrameInFlight.exchange ( true, std::memory_order_acq_rel ) )
+        {
+            return false;
+        }
+        const std::chrono::steady_clock::duration budget = aDeadline - std::chrono::steady_clock::now();
+        Post ( [this, aTimestamp, budget] ( V8 & aEngine )
+        {
+            if ( !aEngine.RunAnimationFrameCallbacks ( aTimestamp, std::chrono::steady_clock::now() + budget ) )
+            {
+                mFrameCutShort.store ( true, std::memory_order_release );
+            }
+            mFrameInFlight.store ( false, std::memory_order_release );
+        } );
+        return !mFrameCutShort.exchange ( false, std::memory_order_acq_rel );
+    }
+
+    void V8Worker::ProcessCommands()
+    {
+        mDOMBridge->ProcessCommands();
+    }
+
+    bool V8Worker::HasPendingCommands() const
+    {
+        /*  Checking the queue alone races with the worker: a script that has yet to reach
+            its first document read would let the host go to sleep, and the read would then
+            wait for whatever wakes the host next. */
+        return mOutstandingScripts.load ( std::memory_order_acquire ) != 0 || mDOMBridge->HasPendingCommands();
+    }
+
+    ScriptStatistics V8Worker::GetStatistics() const
+    {
+        std::lock_guard<std::mutex> lock ( mStatisticsMutex );
+        return mStatistics;
+    }
+
+    bool V8Worker::CollectGarbage ( std::chrono::steady_clock::time_point aDeadline )
+    {
+        // A collection started now would only delay the frame the worker is running.
+        if ( mFrameInFlight.load ( std::memory_order_acquire ) )
+        {
+            return false;
+        }
+        // Shared with the task, which may outlive this call if the worker is late.
+        std::shared_ptr<std::promise<bool>> collected = std::make_shared<std::promise<bool>>();
+        std::future<bool> result = collected->get_future();
+        const std::chrono::steady_clock::duration idle_time = aDeadline - std::chrono::steady_clock::now();
+        Post ( [collected, idle_time] ( V8 & aEngine )
+        {
+            collected->set_value ( aEngine.CollectGarbage ( std::chrono::steady_clock::now() + idle_time ) );
+        }, false );
+        return result.wait_until ( aDeadline ) == std::future_status::ready && result.get();
+    }
+}
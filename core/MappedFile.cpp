@@ -0,0 +1,123 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include "aeongui/MappedFile.h"
+
+namespace AeonGUI
+{
+    MappedFile::MappedFile() = default;
+
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+    bool MappedFile::Open ( const char* aFilename )
+    {
+        Close();
+#ifdef _WIN32
+        HANDLE file = CreateFileA ( aFilename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+        if ( file == INVALID_HANDLE_VALUE )
+        {
+            return false;
+        }
+        LARGE_INTEGER size{};
+        if ( !GetFileSizeEx ( file, &size ) || size.QuadPart == 0 )
+        {
+            CloseHandle ( file );
+            return false;
+        }
+        HANDLE mapping = CreateFileMappingA ( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+        if ( mapping == nullptr )
+        {
+            CloseHandle ( file );
+            return false;
+        }
+        const void* data = MapViewOfFile ( mapping, FILE_MAP_READ, 0, 0, 0 );
+        if ( data == nullptr )
+        {
+            CloseHandle ( mapping );
+            CloseHandle ( file );
+            return false;
+        }
+        mFile = file;
+        mMapping = mapping;
+        mData = static_cast<const uint8_t*> ( data );
+        mSize = static_cast<size_t> ( size.QuadPart );
+#else
+        int file = open ( aFilename, O_RDONLY );
+        if ( file < 0 )
+        {
+            return false;
+        }
+        struct stat status {};
+        if ( fstat ( file, &status ) != 0 || status.st_size == 0 )
+        {
+            close ( file );
+            return false;
+        }
+        void* data = mmap ( nullptr, static_cast<size_t> ( status.st_size ), PROT_READ, MAP_PRIVATE, file, 0 );
+        // The mapping keeps its own reference to the file.
+        close ( file );
+        if ( data == MAP_FAILED )
+        {
+            return false;
+        }
+        madvise ( data, static_cast<size_t> ( status.st_size ), MADV_SEQUENTIAL );
+        mData = static_cast<const uint8_t*> ( data );
+        mSize = static_cast<size_t> ( status.st_size );
+#endif
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if ( mData == nullptr )
+        {
+            return;
+        }
+#ifdef _WIN32
+        UnmapViewOfFile ( mData );
+        CloseHandle ( mMapping );
+        CloseHandle ( mFile );
+        mMapping = nullptr;
+        mFile = nullptr;
+#else
+        munmap ( const_cast<uint8_t*> ( mData ), mSize );
+#endif
+        mData = nullptr;
+        mSize = 0;
+    }
+
+    const uint8_t* MappedFile::GetData() const
+    {
+        return mData;
+    }
+
+    size_t MappedFile::GetSize() const
+    {
+        return mSize;
+    }
+}
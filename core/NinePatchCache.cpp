@@ -0,0 +1,206 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include "NinePatchCache.h"
+
+namespace AeonGUI
+{
+    size_t NinePatchCache::KeyHash::operator() ( const Key& aKey ) const
+    {
+        size_t hash = std::hash<uint64_t> {} ( aKey.generation );
+        hash ^= std::hash<uint64_t> {} ( ( static_cast<uint64_t> ( aKey.width ) << 32 ) | aKey.height ) + 0x9e3779b9 + ( hash << 6 ) + ( hash >> 2 );
+        hash ^= std::hash<double> {} ( aKey.scale ) + 0x9e3779b9 + ( hash << 6 ) + ( hash >> 2 );
+        return hash;
+    }
+
+    NinePatchCache::NinePatchCache ( size_t aCapacity, ResampleFilter aFilter ) : mCapacity{aCapacity}, mFilter{aFilter}
+    {
+    }
+
+    NinePatchCache::~NinePatchCache() = default;
+
+    /*  Splits a length into fixed start, stretched middle and fixed end spans.
+        Fixed spans follow the scale and give way proportionally when they do not fit. */
+    static void SplitSpans ( uint32_t aSize, uint32_t aStretchStart, uint32_t aStretchEnd, uint32_t aTarget, double aScale, uint32_t aSpans[3] )
+    {
+        uint32_t start = static_cast<uint32_t> ( std::lround ( aStretchStart * aScale ) );
+        uint32_t end = static_cast<uint32_t> ( std::lround ( ( aSize - aStretchEnd ) * aScale ) );
+        if ( start + end > aTarget )
+        {
+            start = static_cast<uint32_t> ( ( static_cast<uint64_t> ( aTarget ) * start ) / ( start + end ) );
+            end = aTarget - start;
+        }
+        aSpans[0] = start;
+        aSpans[1] = aTarget - start - end;
+        aSpans[2] = end;
+    }
+
+    const NinePatchCache::Bitmap* NinePatchCache::FindSibling ( const Image& aImage, double aScale ) const
+    {
+        for ( auto& i : mLru )
+        {
+            if ( i.generation == aImage.GetGeneration() && i.scale == aScale )
+            {
+                return mEntries.at ( i ).bitmap.get();
+            }
+        }
+        return nullptr;
+    }
+
+    NinePatchCache::Handle NinePatchCache::Render ( const Image& aImage, uint32_t aWidth, uint32_t aHeight, double aScale ) const
+    {
+        auto bitmap = std::make_shared<Bitmap>();
+        bitmap->width = aWidth;
+        bitmap->height = aHeight;
+        bitmap->pixels.resize ( static_cast<size_t> ( aWidth ) * aHeight );
+        const Color* source = aImage.GetBitmap();
+        const uint32_t width = aImage.GetWidth();
+        const uint32_t height = aImage.GetHeight();
+        const size_t source_pitch = width * sizeof ( Color );
+        const size_t destination_pitch = aWidth * sizeof ( Color );
+        if ( source == nullptr || aWidth == 0 || aHeight == 0 )
+        {
+            return bitmap;
+        }
+
+        const bool has_patches = aImage.GetStretchXEnd() > aImage.GetStretchXStart() && aImage.GetStretchYEnd() > aImage.GetStretchYStart();
+        if ( !has_patches )
+        {
+            /*  Shrinking by half or more starts from the smallest mip level still as large as the result,
+                the filter then spans a couple of texels instead of growing with the scale. */
+            uint32_t level_width;
+            uint32_t level_height;
+            const uint32_t level = aImage.GetMipLevelForScale ( std::max ( static_cast<float> ( aWidth ) / width, static_cast<float> ( aHeight ) / height ) );
+            const Color* level_source = aImage.GetMipLevel ( level, level_width, level_height );
+            Resampler{level_width, level_height, aWidth, aHeight, mFilter}.Resample ( level_source, level_width * sizeof ( Color ), bitmap->pixels.data(), destination_pitch );
+            return bitmap;
+        }
+
+        const uint32_t source_x[4] = {0, aImage.GetStretchXStart(), aImage.GetStretchXEnd(), width};
+        const uint32_t source_y[4] = {0, aImage.GetStretchYStart(), aImage.GetStretchYEnd(), height};
+        uint32_t spans_x[3];
+        uint32_t spans_y[3];
+        SplitSpans ( width, source_x[1], source_x[2], aWidth, aScale, spans_x );
+        SplitSpans ( height, source_y[1], source_y[2], aHeight, aScale, spans_y );
+        const uint32_t destination_x[3] = {0, spans_x[0], spans_x[0] + spans_x[1]};
+        const uint32_t destination_y[3] = {0, spans_y[0], spans_y[0] + spans_y[1]};
+
+        // Corners only depend on the scale, so a result at another size can supply them.
+        const Bitmap* sibling = FindSibling ( aImage, aScale );
+        uint32_t sibling_spans_x[3] {};
+        uint32_t sibling_spans_y[3] {};
+        if ( sibling != nullptr )
+        {
+            SplitSpans ( width, source_x[1], source_x[2], sibling->width, aScale, sibling_spans_x );
+            SplitSpans ( height, source_y[1], source_y[2], sibling->height, aScale, sibling_spans_y );
+        }
+
+        for ( uint32_t row = 0; row < 3; ++row )
+        {
+            for ( uint32_t column = 0; column < 3; ++column )
+            {
+                const uint32_t patch_width = spans_x[column];
+                const uint32_t patch_height = spans_y[row];
+                const uint32_t patch_source_width = source_x[column + 1] - source_x[column];
+                const uint32_t patch_source_height = source_y[row + 1] - source_y[row];
+                if ( !patch_width || !patch_height || !patch_source_width || !patch_source_height )
+                {
+                    continue;
+                }
+                Color* destination = bitmap->pixels.data() + ( static_cast<size_t> ( destination_y[row] ) * aWidth ) + destination_x[column];
+                const bool corner = ( row != 1 ) && ( column != 1 );
+                if ( corner && sibling != nullptr && sibling_spans_x[column] == patch_width && sibling_spans_y[row] == patch_height )
+                {
+                    const uint32_t sibling_x = ( column == 0 ) ? 0 : sibling->width - patch_width;
+                    const uint32_t sibling_y = ( row == 0 ) ? 0 : sibling->height - patch_height;
+                    for ( uint32_t y = 0; y < patch_height; ++y )
+                    {
+                        std::copy_n ( sibling->pixels.data() + ( static_cast<size_t> ( sibling_y + y ) * sibling->width ) + sibling_x, patch_width,
+                                      destination + ( static_cast<size_t> ( y ) * aWidth ) );
+                    }
+                    continue;
+                }
+                Resampler{patch_source_width, patch_source_height, patch_width, patch_height, mFilter} .Resample (
+                    source + ( static_cast<size_t> ( source_y[row] ) * width ) + source_x[column], source_pitch,
+                    destination, destination_pitch );
+            }
+        }
+        return bitmap;
+    }
+
+    NinePatchCache::Handle NinePatchCache::Get ( const Image& aImage, uint32_t aWidth, uint32_t aHeight, double aScale )
+    {
+        std::lock_guard<std::mutex> lock ( mMutex );
+        const Key key{aImage.GetGeneration(), aWidth, aHeight, aScale};
+        auto i = mEntries.find ( key );
+        if ( i != mEntries.end() )
+        {
+            ++mHits;
+            mLru.splice ( mLru.begin(), mLru, i->second.lru );
+            return i->second.bitmap;
+        }
+        ++mMisses;
+        Handle bitmap = Render ( aImage, aWidth, aHeight, aScale );
+        if ( mCapacity == 0 )
+        {
+            return bitmap;
+        }
+        if ( mEntries.size() >= mCapacity )
+        {
+            mEntries.erase ( mLru.back() );
+            mLru.pop_back();
+        }
+        mLru.push_front ( key );
+        mEntries.emplace ( key, Entry{bitmap, mLru.begin() } );
+        return bitmap;
+    }
+
+    void NinePatchCache::Forget ( const Image& aImage )
+    {
+        std::lock_guard<std::mutex> lock ( mMutex );
+        for ( auto i = mLru.begin(); i != mLru.end(); )
+        {
+            if ( i->generation == aImage.GetGeneration() )
+            {
+                mEntries.erase ( *i );
+                i = mLru.erase ( i );
+                continue;
+            }
+            ++i;
+        }
+    }
+
+    void NinePatchCache::Clear()
+    {
+        std::lock_guard<std::mutex> lock ( mMutex );
+        mEntries.clear();
+        mLru.clear();
+    }
+
+    size_t NinePatchCache::GetHits() const
+    {
+        std::lock_guard<std::mutex> lock ( mMutex );
+        return mHits;
+    }
+
+    size_t NinePatchCache::GetMisses() const
+    {
+        std::lock_guard<std::mutex> lock ( mMutex );
+        return mMisses;
+    }
+}
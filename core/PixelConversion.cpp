@@ -0,0 +1,212 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <array>
+#include <cstring>
+#include "aeongui/CpuFeatures.h"
+#include "aeongui/PixelConversion.h"
+#if defined(AEONGUI_X86)
+#include <immintrin.h>
+#elif defined(AEONGUI_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace AeonGUI
+{
+    using RowConverter = void ( * ) ( const uint8_t*, Color*, size_t );
+
+    /*  Scalar reference, also used for the tails the vector kernels leave behind.
+        R, G, B and A are the byte offsets of each component in the source pixel. */
+    template<size_t R, size_t G, size_t B, size_t Bpp>
+    static void ConvertScalar ( const uint8_t* aSource, Color* aDestination, size_t aCount )
+    {
+        for ( size_t i = 0; i < aCount; ++i, aSource += Bpp )
+        {
+            aDestination[i].b = aSource[B];
+            aDestination[i].g = aSource[G];
+            aDestination[i].r = aSource[R];
+            aDestination[i].a = ( Bpp == 4 ) ? aSource[3] : 255;
+        }
+    }
+
+    static void CopyBGRA ( const uint8_t* aSource, Color* aDestination, size_t aCount )
+    {
+        memcpy ( aDestination, aSource, sizeof ( Color ) * aCount );
+    }
+
+#if defined(AEONGUI_X86)
+    /*  24 bit kernels expand 4 pixels per 16 byte shuffle, each load reads 16 bytes
+        but only consumes 12, so the loops stop while there is still room for a full load. */
+    template<bool SwapRB>
+    AEONGUI_TARGET ( "ssse3" ) static void Convert24SSSE3 ( const uint8_t* aSource, Color* aDestination, size_t aCount )
+    {
+        const __m128i shuffle = SwapRB ?
+                                _mm_setr_epi8 ( 2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1 ) :
+                                _mm_setr_epi8 ( 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1 );
+        const __m128i alpha = _mm_set1_epi32 ( static_cast<int> ( 0xff000000 ) );
+        size_t i = 0;
+        for ( ; i + 6 <= aCount; i += 4 )
+        {
+            __m128i pixels = _mm_loadu_si128 ( reinterpret_cast<const __m128i*> ( aSource + ( i * 3 ) ) );
+            _mm_storeu_si128 ( reinterpret_cast<__m128i*> ( aDestination + i ), _mm_or_si128 ( _mm_shuffle_epi8 ( pixels, shuffle ), alpha ) );
+        }
+        if ( SwapRB )
+        {
+            ConvertScalar<0, 1, 2, 3> ( aSource + ( i * 3 ), aDestination + i, aCount - i );
+        }
+        else
+        {
+            ConvertScalar<2, 1, 0, 3> ( aSource + ( i * 3 ), aDestination + i, aCount - i );
+        }
+    }
+
+    AEONGUI_TARGET ( "ssse3" ) static void ConvertRGBASSSE3 ( const uint8_t* aSource, Color* aDestination, size_t aCount )
+    {
+        const __m128i shuffle = _mm_setr_epi8 ( 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15 );
+        size_t i = 0;
+        for ( ; i + 4 <= aCount; i += 4 )
+        {
+            __m128i pixels = _mm_loadu_si128 ( reinterpret_cast<const __m128i*> ( aSource + ( i * 4 ) ) );
+            _mm_storeu_si128 ( reinterpret_cast<__m128i*> ( aDestination + i ), _mm_shuffle_epi8 ( pixels, shuffle ) );
+        }
+        ConvertScalar<0, 1, 2, 4> ( aSource + ( i * 4 ), aDestination + i, aCount - i );
+    }
+
+    AEONGUI_TARGET ( "avx2" ) static void ConvertRGBAAVX2 ( const uint8_t* aSource, Color* aDestination, size_t aCount )
+    {
+        const __m256i shuffle = _mm256_setr_epi8 ( 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+                                2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15 );
+        size_t i = 0;
+        for ( ; i + 8 <= aCount; i += 8 )
+        {
+            __m256i pixels = _mm256_loadu_si256 ( reinterpret_cast<const __m256i*> ( aSource + ( i * 4 ) ) );
+            _mm256_storeu_si256 ( reinterpret_cast<__m256i*> ( aDestination + i ), _mm256_shuffle_epi8 ( pixels, shuffle ) );
+        }
+        ConvertRGBASSSE3 ( aSource + ( i * 4 ), aDestination + i, aCount - i );
+    }
+#elif defined(AEONGUI_NEON)
+    // Structured loads and stores do the (de)interleaving, 16 pixels at a time.
+    template<bool SwapRB>
+    static void Convert24NEON ( const uint8_t* aSource, Color* aDestination, size_t aCount )
+    {
+        size_t i = 0;
+        for ( ; i + 16 <= aCount; i += 16 )
+        {
+            uint8x16x3_t source = vld3q_u8 ( aSource + ( i * 3 ) );
+            uint8x16x4_t destination;
+            destination.val[0] = source.val[SwapRB ? 2 : 0];
+            destination.val[1] = source.val[1];
+            destination.val[2] = source.val[SwapRB ? 0 : 2];
+            destination.val[3] = vdupq_n_u8 ( 255 );
+            vst4q_u8 ( reinterpret_cast<uint8_t*> ( aDestination + i ), destination );
+        }
+        if ( SwapRB )
+        {
+            ConvertScalar<0, 1, 2, 3> ( aSource + ( i * 3 ), aDestination + i, aCount - i );
+        }
+        else
+        {
+            ConvertScalar<2, 1, 0, 3> ( aSource + ( i * 3 ), aDestination + i, aCount - i );
+        }
+    }
+
+    static void ConvertRGBANEON ( const uint8_t* aSource, Color* aDestination, size_t aCount )
+    {
+        size_t i = 0;
+        for ( ; i + 16 <= aCount; i += 16 )
+        {
+            uint8x16x4_t source = vld4q_u8 ( aSource + ( i * 4 ) );
+            uint8x16x4_t destination;
+            destination.val[0] = source.val[2];
+            destination.val[1] = source.val[1];
+            destination.val[2] = source.val[0];
+            destination.val[3] = source.val[3];
+            vst4q_u8 ( reinterpret_cast<uint8_t*> ( aDestination + i ), destination );
+        }
+        ConvertScalar<0, 1, 2, 4> ( aSource + ( i * 4 ), aDestination + i, aCount - i );
+    }
+#endif
+
+    // Indexed by PixelFormat.
+    static std::array<RowConverter, 4> SelectRowConverters ( uint32_t aFeatures )
+    {
+#if defined(AEONGUI_X86)
+        if ( aFeatures & CPU_AVX2 )
+        {
+            /*  24 bit rows stay on SSSE3, AVX2 shuffles work within 128 bit lanes
+                so each 8 pixels took two loads and a lane insert, which measured
+                slower than the SSSE3 kernel in core-benchmarks. */
+            return {Convert24SSSE3<true>, Convert24SSSE3<false>, ConvertRGBAAVX2, CopyBGRA};
+        }
+        if ( aFeatures & CPU_SSSE3 )
+        {
+            return {Convert24SSSE3<true>, Convert24SSSE3<false>, ConvertRGBASSSE3, CopyBGRA};
+        }
+#elif defined(AEONGUI_NEON)
+        if ( aFeatures & CPU_NEON )
+        {
+            return {Convert24NEON<true>, Convert24NEON<false>, ConvertRGBANEON, CopyBGRA};
+        }
+#endif
+        return {ConvertScalar<0, 1, 2, 3>, ConvertScalar<2, 1, 0, 3>, ConvertScalar<0, 1, 2, 4>, CopyBGRA};
+    }
+
+    static RowConverter GetRowConverter ( PixelFormat aFormat )
+    {
+        static const std::array<RowConverter, 4> converters{SelectRowConverters ( GetCpuFeatures() ) };
+        return converters[static_cast<size_t> ( aFormat )];
+    }
+
+    void ConvertPixelRow ( PixelFormat aFormat, const uint8_t* aSource, Color* aDestination, size_t aCount )
+    {
+        GetRowConverter ( aFormat ) ( aSource, aDestination, aCount );
+    }
+
+    void ConvertPixels ( PixelFormat aFormat, const uint8_t* aSource, size_t aSourcePitch, Color* aDestination, size_t aDestinationPitch, uint32_t aWidth, uint32_t aHeight )
+    {
+        RowConverter convert = GetRowConverter ( aFormat );
+        const size_t bpp = ( aFormat == PixelFormat::RGB || aFormat == PixelFormat::BGR ) ? 3 : 4;
+        // Contiguous rectangles are converted as a single row.
+        if ( aSourcePitch == aWidth * bpp && aDestinationPitch == aWidth * sizeof ( Color ) )
+        {
+            convert ( aSource, aDestination, static_cast<size_t> ( aWidth ) * aHeight );
+            return;
+        }
+        for ( uint32_t y = 0; y < aHeight; ++y )
+        {
+            convert ( aSource + ( y * aSourcePitch ),
+                      reinterpret_cast<Color*> ( reinterpret_cast<uint8_t*> ( aDestination ) + ( y * aDestinationPitch ) ),
+                      aWidth );
+        }
+    }
+
+    bool ConvertPixelRowWith ( uint32_t aFeatures, PixelFormat aFormat, const uint8_t* aSource, Color* aDestination, size_t aCount )
+    {
+#if defined(AEONGUI_X86)
+        const uint32_t kernels = CPU_AVX2 | CPU_SSSE3;
+#elif defined(AEONGUI_NEON)
+        const uint32_t kernels = CPU_NEON;
+#else
+        const uint32_t kernels = 0;
+#endif
+        if ( ( aFeatures & ~kernels ) != 0 || ( aFeatures & GetCpuFeatures() ) != aFeatures )
+        {
+            return false;
+        }
+        SelectRowConverters ( aFeatures ) [static_cast<size_t> ( aFormat )] ( aSource, aDestination, aCount );
+        return true;
+    }
+}
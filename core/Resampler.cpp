@@ -0,0 +1,460 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <cairo.h>
+#include "aeongui/CpuFeatures.h"
+#include "aeongui/Resampler.h"
+#if defined(AEONGUI_X86)
+#include <emmintrin.h>
+#elif defined(AEONGUI_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace AeonGUI
+{
+    // Weights are 2.14 fixed point so two products and their sum fit the 16 bit multiply-add.
+    static constexpr int32_t WeightBits = 14;
+    static constexpr int32_t WeightOne = 1 << WeightBits;
+    static constexpr double Pi = 3.14159265358979323846;
+
+    static double FilterRadius ( ResampleFilter aFilter )
+    {
+        switch ( aFilter )
+        {
+        case ResampleFilter::BOX:
+            return 0.5;
+        case ResampleFilter::BILINEAR:
+            return 1.0;
+        case ResampleFilter::BICUBIC:
+            return 2.0;
+        case ResampleFilter::LANCZOS3:
+            return 3.0;
+        }
+        return 1.0;
+    }
+
+    static double Sinc ( double x )
+    {
+        return ( x == 0.0 ) ? 1.0 : std::sin ( Pi * x ) / ( Pi * x );
+    }
+
+    static double FilterWeight ( ResampleFilter aFilter, double x )
+    {
+        x = std::fabs ( x );
+        switch ( aFilter )
+        {
+        case ResampleFilter::BOX:
+            return ( x < 0.5 ) ? 1.0 : 0.0;
+        case ResampleFilter::BILINEAR:
+            return ( x < 1.0 ) ? 1.0 - x : 0.0;
+        case ResampleFilter::BICUBIC:
+            // Catmull-Rom, a = -0.5.
+            if ( x < 1.0 )
+            {
+                return ( ( 1.5 * x - 2.5 ) * x * x ) + 1.0;
+            }
+            if ( x < 2.0 )
+            {
+                return ( ( ( -0.5 * x + 2.5 ) * x - 4.0 ) * x ) + 2.0;
+            }
+            return 0.0;
+        case ResampleFilter::LANCZOS3:
+            return ( x < 3.0 ) ? Sinc ( x ) * Sinc ( x / 3.0 ) : 0.0;
+        }
+        return 0.0;
+    }
+
+    Resampler::WeightTable Resampler::BuildWeightTable ( uint32_t aSourceSize, uint32_t aDestinationSize, ResampleFilter aFilter )
+    {
+        WeightTable table;
+        const double scale = static_cast<double> ( aSourceSize ) / aDestinationSize;
+        // When shrinking the filter is stretched so every source sample contributes.
+        const double stretch = std::max ( 1.0, scale );
+        const double support = FilterRadius ( aFilter ) * stretch;
+        table.taps = std::min<uint32_t> ( aSourceSize, static_cast<uint32_t> ( std::ceil ( support ) * 2 ) + 1 );
+        table.first.resize ( aDestinationSize );
+        table.weights.assign ( static_cast<size_t> ( aDestinationSize ) * table.taps, 0 );
+
+        std::vector<double> weights ( table.taps );
+        for ( uint32_t i = 0; i < aDestinationSize; ++i )
+        {
+            const double center = ( ( i + 0.5 ) * scale ) - 0.5;
+            // Taps falling outside the source are dropped and the rest renormalized.
+            int64_t first = static_cast<int64_t> ( std::floor ( center - support ) ) + 1;
+            int64_t last = static_cast<int64_t> ( std::floor ( center + support ) );
+            first = std::max<int64_t> ( first, 0 );
+            last = std::min<int64_t> ( last, aSourceSize - 1 );
+            if ( last - first + 1 > table.taps )
+            {
+                last = first + table.taps - 1;
+            }
+            if ( last < first )
+            {
+                first = last = std::clamp<int64_t> ( static_cast<int64_t> ( std::lround ( center ) ), 0, aSourceSize - 1 );
+            }
+            // Keep the window inside the source so kernels never need bounds checks.
+            if ( first + table.taps > aSourceSize )
+            {
+                first = aSourceSize - table.taps;
+            }
+            double sum = 0.0;
+            for ( uint32_t j = 0; j < table.taps; ++j )
+            {
+                const int64_t sample = first + j;
+                weights[j] = ( sample <= last && sample >= first ) ? FilterWeight ( aFilter, ( sample - center ) / stretch ) : 0.0;
+                sum += weights[j];
+            }
+            if ( sum == 0.0 )
+            {
+                // Degenerate box windows, take the nearest sample.
+                weights.assign ( table.taps, 0.0 );
+                weights[std::clamp<int64_t> ( std::lround ( center ) - first, 0, table.taps - 1 )] = 1.0;
+                sum = 1.0;
+            }
+            // Quantize, pushing the rounding error into the largest weight so they add up to exactly one.
+            int16_t* fixed = table.weights.data() + ( static_cast<size_t> ( i ) * table.taps );
+            int32_t fixed_sum = 0;
+            uint32_t largest = 0;
+            for ( uint32_t j = 0; j < table.taps; ++j )
+            {
+                fixed[j] = static_cast<int16_t> ( std::lround ( ( weights[j] / sum ) * WeightOne ) );
+                fixed_sum += fixed[j];
+                if ( fixed[j] > fixed[largest] )
+                {
+                    largest = j;
+                }
+            }
+            fixed[largest] = static_cast<int16_t> ( fixed[largest] + ( WeightOne - fixed_sum ) );
+            table.first[i] = static_cast<uint32_t> ( first );
+        }
+        return table;
+    }
+
+    Resampler::Resampler ( uint32_t aSourceWidth, uint32_t aSourceHeight, uint32_t aDestinationWidth, uint32_t aDestinationHeight, ResampleFilter aFilter ) :
+        mSourceWidth{aSourceWidth},
+        mSourceHeight{aSourceHeight},
+        mDestinationWidth{aDestinationWidth},
+        mDestinationHeight{aDestinationHeight},
+        mHorizontal{BuildWeightTable ( aSourceWidth, aDestinationWidth, aFilter ) },
+        mVertical{BuildWeightTable ( aSourceHeight, aDestinationHeight, aFilter ) }
+    {
+    }
+
+    static inline uint8_t ClampComponent ( int32_t aValue )
+    {
+        aValue = ( aValue + ( WeightOne / 2 ) ) >> WeightBits;
+        return static_cast<uint8_t> ( std::clamp ( aValue, 0, 255 ) );
+    }
+
+    /*  Horizontal pass, one output pixel at a time.
+        The SSE2 path interleaves two taps so _mm_madd_epi16 applies both weights at once. */
+    static void ResampleRow ( const Color* aSource, Color* aDestination, uint32_t aWidth, uint32_t aTaps, const uint32_t* aFirst, const int16_t* aWeights )
+    {
+        for ( uint32_t x = 0; x < aWidth; ++x )
+        {
+            const Color* source = aSource + aFirst[x];
+            const int16_t* weights = aWeights + ( static_cast<size_t> ( x ) * aTaps );
+#if defined(AEONGUI_X86)
+            const __m128i zero = _mm_setzero_si128();
+            __m128i sum = _mm_setzero_si128();
+            uint32_t j = 0;
+            for ( ; j + 2 <= aTaps; j += 2 )
+            {
+                __m128i pair = _mm_unpacklo_epi8 ( _mm_cvtsi32_si128 ( static_cast<int> ( source[j].bgra ) ), _mm_cvtsi32_si128 ( static_cast<int> ( source[j + 1].bgra ) ) );
+                __m128i weight = _mm_set1_epi32 ( static_cast<int> ( ( static_cast<uint32_t> ( static_cast<uint16_t> ( weights[j + 1] ) ) << 16 ) | static_cast<uint16_t> ( weights[j] ) ) );
+                sum = _mm_add_epi32 ( sum, _mm_madd_epi16 ( _mm_unpacklo_epi8 ( pair, zero ), weight ) );
+            }
+            if ( j < aTaps )
+            {
+                __m128i pixel = _mm_unpacklo_epi8 ( _mm_unpacklo_epi8 ( _mm_cvtsi32_si128 ( static_cast<int> ( source[j].bgra ) ), zero ), zero );
+                sum = _mm_add_epi32 ( sum, _mm_madd_epi16 ( pixel, _mm_set1_epi32 ( static_cast<uint16_t> ( weights[j] ) ) ) );
+            }
+            sum = _mm_srai_epi32 ( _mm_add_epi32 ( sum, _mm_set1_epi32 ( WeightOne / 2 ) ), WeightBits );
+            sum = _mm_packs_epi32 ( sum, sum );
+            aDestination[x].bgra = static_cast<uint32_t> ( _mm_cvtsi128_si32 ( _mm_packus_epi16 ( sum, sum ) ) );
+#elif defined(AEONGUI_NEON)
+            int32x4_t sum = vdupq_n_s32 ( 0 );
+            for ( uint32_t j = 0; j < aTaps; ++j )
+            {
+                int16x4_t pixel = vreinterpret_s16_u16 ( vget_low_u16 ( vmovl_u8 ( vreinterpret_u8_u32 ( vdup_n_u32 ( source[j].bgra ) ) ) ) );
+                sum = vmlal_n_s16 ( sum, pixel, weights[j] );
+            }
+            sum = vrshrq_n_s32 ( sum, WeightBits );
+            uint8x8_t packed = vqmovun_s16 ( vcombine_s16 ( vqmovn_s32 ( sum ), vdup_n_s16 ( 0 ) ) );
+            aDestination[x].bgra = vget_lane_u32 ( vreinterpret_u32_u8 ( packed ), 0 );
+#else
+            int32_t b = 0, g = 0, r = 0, a = 0;
+            for ( uint32_t j = 0; j < aTaps; ++j )
+            {
+                b += source[j].b * weights[j];
+                g += source[j].g * weights[j];
+                r += source[j].r * weights[j];
+                a += source[j].a * weights[j];
+            }
+            aDestination[x].b = ClampComponent ( b );
+            aDestination[x].g = ClampComponent ( g );
+            aDestination[x].r = ClampComponent ( r );
+            aDestination[x].a = ClampComponent ( a );
+#endif
+        }
+    }
+
+    /*  Vertical pass, a weighted sum of whole rows.
+        Vector paths handle four pixels per step and fall back to scalar for the rest. */
+    static void ResampleColumn ( const Color* const* aRows, Color* aDestination, uint32_t aWidth, uint32_t aTaps, const int16_t* aWeights )
+    {
+        uint32_t x = 0;
+#if defined(AEONGUI_X86)
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i rounding = _mm_set1_epi32 ( WeightOne / 2 );
+        for ( ; x + 4 <= aWidth; x += 4 )
+        {
+            __m128i sums[4] = {zero, zero, zero, zero};
+            uint32_t j = 0;
+            for ( ; j < aTaps; j += 2 )
+            {
+                const __m128i first = _mm_loadu_si128 ( reinterpret_cast<const __m128i*> ( aRows[j] + x ) );
+                const bool pair = ( j + 1 < aTaps );
+                const __m128i second = pair ? _mm_loadu_si128 ( reinterpret_cast<const __m128i*> ( aRows[j + 1] + x ) ) : zero;
+                const __m128i weight = _mm_set1_epi32 ( static_cast<int> ( ( static_cast<uint32_t> ( static_cast<uint16_t> ( pair ? aWeights[j + 1] : 0 ) ) << 16 ) | static_cast<uint16_t> ( aWeights[j] ) ) );
+                const __m128i low = _mm_unpacklo_epi8 ( first, second );
+                const __m128i high = _mm_unpackhi_epi8 ( first, second );
+                sums[0] = _mm_add_epi32 ( sums[0], _mm_madd_epi16 ( _mm_unpacklo_epi8 ( low, zero ), weight ) );
+                sums[1] = _mm_add_epi32 ( sums[1], _mm_madd_epi16 ( _mm_unpackhi_epi8 ( low, zero ), weight ) );
+                sums[2] = _mm_add_epi32 ( sums[2], _mm_madd_epi16 ( _mm_unpacklo_epi8 ( high, zero ), weight ) );
+                sums[3] = _mm_add_epi32 ( sums[3], _mm_madd_epi16 ( _mm_unpackhi_epi8 ( high, zero ), weight ) );
+            }
+            for ( auto& sum : sums )
+            {
+                sum = _mm_srai_epi32 ( _mm_add_epi32 ( sum, rounding ), WeightBits );
+            }
+            const __m128i packed = _mm_packus_epi16 ( _mm_packs_epi32 ( sums[0], sums[1] ), _mm_packs_epi32 ( sums[2], sums[3] ) );
+            _mm_storeu_si128 ( reinterpret_cast<__m128i*> ( aDestination + x ), packed );
+        }
+#elif defined(AEONGUI_NEON)
+        for ( ; x + 4 <= aWidth; x += 4 )
+        {
+            int32x4_t sums[4] = {vdupq_n_s32 ( 0 ), vdupq_n_s32 ( 0 ), vdupq_n_s32 ( 0 ), vdupq_n_s32 ( 0 ) };
+            for ( uint32_t j = 0; j < aTaps; ++j )
+            {
+                const uint8x16_t pixels = vld1q_u8 ( reinterpret_cast<const uint8_t*> ( aRows[j] + x ) );
+                const int16x8_t low = vreinterpretq_s16_u16 ( vmovl_u8 ( vget_low_u8 ( pixels ) ) );
+                const int16x8_t high = vreinterpretq_s16_u16 ( vmovl_u8 ( vget_high_u8 ( pixels ) ) );
+                sums[0] = vmlal_n_s16 ( sums[0], vget_low_s16 ( low ), aWeights[j] );
+                sums[1] = vmlal_n_s16 ( sums[1], vget_high_s16 ( low ), aWeights[j] );
+                sums[2] = vmlal_n_s16 ( sums[2], vget_low_s16 ( high ), aWeights[j] );
+                sums[3] = vmlal_n_s16 ( sums[3], vget_high_s16 ( high ), aWeights[j] );
+            }
+            const int16x8_t low = vcombine_s16 ( vqmovn_s32 ( vrshrq_n_s32 ( sums[0], WeightBits ) ), vqmovn_s32 ( vrshrq_n_s32 ( sums[1], WeightBits ) ) );
+            const int16x8_t high = vcombine_s16 ( vqmovn_s32 ( vrshrq_n_s32 ( sums[2], WeightBits ) ), vqmovn_s32 ( vrshrq_n_s32 ( sums[3], WeightBits ) ) );
+            vst1q_u8 ( reinterpret_cast<uint8_t*> ( aDestination + x ), vcombine_u8 ( vqmovun_s16 ( low ), vqmovun_s16 ( high ) ) );
+        }
+#endif
+        for ( ; x < aWidth; ++x )
+        {
+            int32_t b = 0, g = 0, r = 0, a = 0;
+            for ( uint32_t j = 0; j < aTaps; ++j )
+            {
+                const Color& source = aRows[j][x];
+                b += source.b * aWeights[j];
+                g += source.g * aWeights[j];
+                r += source.r * aWeights[j];
+                a += source.a * aWeights[j];
+            }
+            aDestination[x].b = ClampComponent ( b );
+            aDestination[x].g = ClampComponent ( g );
+            aDestination[x].r = ClampComponent ( r );
+            aDestination[x].a = ClampComponent ( a );
+        }
+    }
+
+    // Runs aFunction over [0, aCount) split into contiguous ranges, one per thread.
+    template<class F>
+    static void ParallelRows ( uint32_t aCount, uint32_t aThreads, F aFunction )
+    {
+        if ( aThreads == 0 )
+        {
+            aThreads = std::max ( 1u, std::thread::hardware_concurrency() );
+        }
+        aThreads = std::min ( aThreads, aCount );
+        if ( aThreads <= 1 )
+        {
+            aFunction ( 0, aCount );
+            return;
+        }
+        std::vector<std::thread> threads;
+        threads.reserve ( aThreads - 1 );
+        const uint32_t step = ( aCount + aThreads - 1 ) / aThreads;
+        for ( uint32_t begin = step; begin < aCount; begin += step )
+        {
+            threads.emplace_back ( aFunction, begin, std::min ( aCount, begin + step ) );
+        }
+        aFunction ( 0, std::min ( aCount, step ) );
+        for ( auto& thread : threads )
+        {
+            thread.join();
+        }
+    }
+
+    void Resampler::Resample ( const Color* aSource, size_t aSourcePitch, Color* aDestination, size_t aDestinationPitch, uint32_t aThreads ) const
+    {
+        if ( !mSourceWidth || !mSourceHeight || !mDestinationWidth || !mDestinationHeight )
+        {
+            return;
+        }
+        // Horizontal pass into an intermediate of destination width and source height.
+        std::vector<Color> intermediate ( static_cast<size_t> ( mDestinationWidth ) * mSourceHeight );
+        ParallelRows ( mSourceHeight, aThreads, [&] ( uint32_t aBegin, uint32_t aEnd )
+        {
+            for ( uint32_t y = aBegin; y < aEnd; ++y )
+            {
+                ResampleRow ( reinterpret_cast<const Color*> ( reinterpret_cast<const uint8_t*> ( aSource ) + ( y * aSourcePitch ) ),
+                              intermediate.data() + ( static_cast<size_t> ( y ) * mDestinationWidth ),
+                              mDestinationWidth, mHorizontal.taps, mHorizontal.first.data(), mHorizontal.weights.data() );
+            }
+        } );
+        ParallelRows ( mDestinationHeight, aThreads, [&] ( uint32_t aBegin, uint32_t aEnd )
+        {
+            std::vector<const Color*> rows ( mVertical.taps );
+            for ( uint32_t y = aBegin; y < aEnd; ++y )
+            {
+                for ( uint32_t j = 0; j < mVertical.taps; ++j )
+                {
+                    rows[j] = intermediate.data() + ( static_cast<size_t> ( mVertical.first[y] + j ) * mDestinationWidth );
+                }
+                ResampleColumn ( rows.data(),
+                                 reinterpret_cast<Color*> ( reinterpret_cast<uint8_t*> ( aDestination ) + ( y * aDestinationPitch ) ),
+                                 mDestinationWidth, mVertical.taps, mVertical.weights.data() + ( static_cast<size_t> ( y ) * mVertical.taps ) );
+            }
+        } );
+    }
+
+    uint32_t Resampler::GetSourceWidth() const
+    {
+        return mSourceWidth;
+    }
+
+    uint32_t Resampler::GetSourceHeight() const
+    {
+        return mSourceHeight;
+    }
+
+    uint32_t Resampler::GetDestinationWidth() const
+    {
+        return mDestinationWidth;
+    }
+
+    uint32_t Resampler::GetDestinationHeight() const
+    {
+        return mDestinationHeight;
+    }
+
+    cairo_surface_t* ResampleSurface ( cairo_surface_t* aSurface, uint32_t aWidth, uint32_t aHeight, ResampleFilter aFilter, uint32_t aThreads )
+    {
+        if ( cairo_surface_get_type ( aSurface ) != CAIRO_SURFACE_TYPE_IMAGE )
+        {
+            return nullptr;
+        }
+        const cairo_format_t format = cairo_image_surface_get_format ( aSurface );
+        if ( format != CAIRO_FORMAT_ARGB32 && format != CAIRO_FORMAT_RGB24 )
+        {
+            return nullptr;
+        }
+        cairo_surface_flush ( aSurface );
+        cairo_surface_t* result = cairo_image_surface_create ( format, aWidth, aHeight );
+        Resampler resampler
+        {
+            static_cast<uint32_t> ( cairo_image_surface_get_width ( aSurface ) ),
+            static_cast<uint32_t> ( cairo_image_surface_get_height ( aSurface ) ),
+            aWidth, aHeight, aFilter
+        };
+        resampler.Resample ( reinterpret_cast<const Color*> ( cairo_image_surface_get_data ( aSurface ) ),
+                             cairo_image_surface_get_stride ( aSurface ),
+                             reinterpret_cast<Color*> ( cairo_image_surface_get_data ( result ) ),
+                             cairo_image_surface_get_stride ( result ), aThreads );
+        cairo_surface_mark_dirty ( result );
+        return result;
+    }
+
+    static inline uint8_t Average ( uint32_t a, uint32_t b, uint32_t c, uint32_t d )
+    {
+        return static_cast<uint8_t> ( ( a + b + c + d + 2 ) >> 2 );
+    }
+
+    void HalveBitmap ( const Color* aSource, size_t aSourcePitch, uint32_t aSourceWidth, uint32_t aSourceHeight, Color* aDestination, size_t aDestinationPitch )
+    {
+        const uint32_t width = std::max ( aSourceWidth / 2, 1u );
+        const uint32_t height = std::max ( aSourceHeight / 2, 1u );
+        // Only the single column case reads the same source pixel twice.
+        const uint32_t step = ( aSourceWidth > 1 ) ? 1 : 0;
+        for ( uint32_t y = 0; y < height; ++y )
+        {
+            const Color* top = reinterpret_cast<const Color*> ( reinterpret_cast<const uint8_t*> ( aSource ) + ( aSourcePitch * std::min ( y * 2, aSourceHeight - 1 ) ) );
+            const Color* bottom = reinterpret_cast<const Color*> ( reinterpret_cast<const uint8_t*> ( aSource ) + ( aSourcePitch * std::min ( y * 2 + 1, aSourceHeight - 1 ) ) );
+            Color* destination = reinterpret_cast<Color*> ( reinterpret_cast<uint8_t*> ( aDestination ) + ( aDestinationPitch * y ) );
+            uint32_t x = 0;
+            if ( step )
+            {
+#if defined(AEONGUI_X86)
+                // Four output pixels per step, horizontal neighbours are summed by swapping 64 bit halves.
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i rounding = _mm_set1_epi16 ( 2 );
+                for ( ; x + 4 <= width; x += 4 )
+                {
+                    __m128i halves[2];
+                    for ( uint32_t i = 0; i < 2; ++i )
+                    {
+                        const __m128i upper = _mm_loadu_si128 ( reinterpret_cast<const __m128i*> ( top + ( x * 2 ) + ( i * 4 ) ) );
+                        const __m128i lower = _mm_loadu_si128 ( reinterpret_cast<const __m128i*> ( bottom + ( x * 2 ) + ( i * 4 ) ) );
+                        const __m128i low = _mm_add_epi16 ( _mm_unpacklo_epi8 ( upper, zero ), _mm_unpacklo_epi8 ( lower, zero ) );
+                        const __m128i high = _mm_add_epi16 ( _mm_unpackhi_epi8 ( upper, zero ), _mm_unpackhi_epi8 ( lower, zero ) );
+                        const __m128i sum = _mm_add_epi16 ( _mm_unpacklo_epi64 ( low, high ), _mm_unpackhi_epi64 ( low, high ) );
+                        halves[i] = _mm_srli_epi16 ( _mm_add_epi16 ( sum, rounding ), 2 );
+                    }
+                    _mm_storeu_si128 ( reinterpret_cast<__m128i*> ( destination + x ), _mm_packus_epi16 ( halves[0], halves[1] ) );
+                }
+#elif defined(AEONGUI_NEON)
+                // Eight output pixels per step, deinterleaved loads let vpaddl sum horizontal neighbours.
+                for ( ; x + 8 <= width; x += 8 )
+                {
+                    const uint8x16x4_t upper = vld4q_u8 ( reinterpret_cast<const uint8_t*> ( top + ( x * 2 ) ) );
+                    const uint8x16x4_t lower = vld4q_u8 ( reinterpret_cast<const uint8_t*> ( bottom + ( x * 2 ) ) );
+                    uint8x8x4_t result;
+                    for ( int i = 0; i < 4; ++i )
+                    {
+                        result.val[i] = vrshrn_n_u16 ( vaddq_u16 ( vpaddlq_u8 ( upper.val[i] ), vpaddlq_u8 ( lower.val[i] ) ), 2 );
+                    }
+                    vst4_u8 ( reinterpret_cast<uint8_t*> ( destination + x ), result );
+                }
+#endif
+            }
+            for ( ; x < width; ++x )
+            {
+                const Color& a = top[x * 2];
+                const Color& b = top[ ( x * 2 ) + step];
+                const Color& c = bottom[x * 2];
+                const Color& d = bottom[ ( x * 2 ) + step];
+                destination[x].b = Average ( a.b, b.b, c.b, d.b );
+                destination[x].g = Average ( a.g, b.g, c.g, d.g );
+                destination[x].r = Average ( a.r, b.r, c.r, d.r );
+                destination[x].a = Average ( a.a, b.a, c.a, d.a );
+            }
+        }
+    }
+}
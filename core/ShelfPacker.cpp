@@ -0,0 +1,173 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <limits>
+#include "aeongui/ShelfPacker.h"
+
+namespace AeonGUI
+{
+    // Shelf heights are rounded up so glyphs of close sizes share shelves.
+    static constexpr uint32_t ShelfGranularity = 4;
+
+    ShelfPacker::ShelfPacker ( uint32_t aWidth, uint32_t aHeight, uint32_t aPadding ) :
+        mWidth{aWidth}, mHeight{aHeight}, mPadding{aPadding}
+    {
+        Reset();
+    }
+
+    void ShelfPacker::Reset()
+    {
+        mShelves.clear();
+        mTop = 0;
+        mUsedArea = 0;
+    }
+
+    bool ShelfPacker::Allocate ( Shelf& aShelf, uint32_t aWidth, uint32_t& aX )
+    {
+        for ( auto i = aShelf.free.begin(); i != aShelf.free.end(); ++i )
+        {
+            if ( i->width >= aWidth )
+            {
+                aX = i->x;
+                i->x += aWidth;
+                i->width -= aWidth;
+                if ( i->width == 0 )
+                {
+                    aShelf.free.erase ( i );
+                }
+                ++aShelf.used;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool ShelfPacker::Insert ( uint32_t aWidth, uint32_t aHeight, Rect& aRect )
+    {
+        const uint32_t width = aWidth + mPadding;
+        const uint32_t height = aHeight + mPadding;
+        if ( width > mWidth || height > mHeight )
+        {
+            return false;
+        }
+        // Prefer the shortest shelf that fits, tall shelves only take short rectangles once they are empty.
+        Shelf* best = nullptr;
+        for ( auto& shelf : mShelves )
+        {
+            if ( shelf.height >= height &&
+                 ( shelf.used == 0 || shelf.height <= height + ( height / 2 ) ) &&
+                 ( best == nullptr || shelf.height < best->height ) )
+            {
+                const bool has_room = std::any_of ( shelf.free.begin(), shelf.free.end(), [width] ( const Span & span )
+                {
+                    return span.width >= width;
+                } );
+                if ( has_room )
+                {
+                    best = &shelf;
+                }
+            }
+        }
+        if ( best == nullptr )
+        {
+            const uint32_t shelf_height = std::min ( ( ( height + ShelfGranularity - 1 ) / ShelfGranularity ) * ShelfGranularity, mHeight - mTop );
+            if ( mTop + height <= mHeight )
+            {
+                mShelves.push_back ( {mTop, shelf_height, 0, {{0, mWidth}}} );
+                mTop += shelf_height;
+                best = &mShelves.back();
+            }
+        }
+        if ( best == nullptr )
+        {
+            // Out of vertical space, settle for any shelf tall enough.
+            for ( auto& shelf : mShelves )
+            {
+                uint32_t x;
+                if ( shelf.height >= height && Allocate ( shelf, width, x ) )
+                {
+                    mUsedArea += static_cast<uint64_t> ( width ) * height;
+                    aRect = Rect{static_cast<int32_t> ( x ), static_cast<int32_t> ( shelf.y ), aWidth, aHeight};
+                    return true;
+                }
+            }
+            return false;
+        }
+        uint32_t x;
+        Allocate ( *best, width, x );
+        mUsedArea += static_cast<uint64_t> ( width ) * height;
+        aRect = Rect{static_cast<int32_t> ( x ), static_cast<int32_t> ( best->y ), aWidth, aHeight};
+        return true;
+    }
+
+    void ShelfPacker::Remove ( const Rect& aRect )
+    {
+        auto shelf = std::lower_bound ( mShelves.begin(), mShelves.end(), static_cast<uint32_t> ( aRect.GetY() ), [] ( const Shelf & shelf, uint32_t y )
+        {
+            return shelf.y < y;
+        } );
+        if ( shelf == mShelves.end() || shelf->y != static_cast<uint32_t> ( aRect.GetY() ) || shelf->used == 0 )
+        {
+            return;
+        }
+        const Span span{static_cast<uint32_t> ( aRect.GetX() ), aRect.GetWidth() + mPadding};
+        auto next = std::lower_bound ( shelf->free.begin(), shelf->free.end(), span.x, [] ( const Span & free, uint32_t x )
+        {
+            return free.x < x;
+        } );
+        next = shelf->free.insert ( next, span );
+        // Merge with the spans on either side.
+        if ( next + 1 != shelf->free.end() && next->x + next->width == ( next + 1 )->x )
+        {
+            next->width += ( next + 1 )->width;
+            shelf->free.erase ( next + 1 );
+        }
+        if ( next != shelf->free.begin() && ( next - 1 )->x + ( next - 1 )->width == next->x )
+        {
+            ( next - 1 )->width += next->width;
+            shelf->free.erase ( next );
+        }
+        --shelf->used;
+        mUsedArea -= static_cast<uint64_t> ( span.width ) * ( aRect.GetHeight() + mPadding );
+        // Empty shelves at the top give their height back so it can be reshaped.
+        while ( !mShelves.empty() && mShelves.back().used == 0 )
+        {
+            mTop = mShelves.back().y;
+            mShelves.pop_back();
+        }
+    }
+
+    uint32_t ShelfPacker::GetWidth() const
+    {
+        return mWidth;
+    }
+
+    uint32_t ShelfPacker::GetHeight() const
+    {
+        return mHeight;
+    }
+
+    uint32_t ShelfPacker::GetPadding() const
+    {
+        return mPadding;
+    }
+
+    double ShelfPacker::GetOccupancy() const
+    {
+        return ( mWidth && mHeight ) ? static_cast<double> ( mUsedArea ) / ( static_cast<double> ( mWidth ) * mHeight ) : 0.0;
+    }
+}
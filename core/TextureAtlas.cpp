@@ -0,0 +1,238 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#include <algorithm>
+#include <fstream>
+#include "TextureAtlas.h"
+#include "aeongui/MappedFile.h"
+
+namespace AeonGUI
+{
+    /*  Atlas file layout, little endian:
+        AtlasHeader, AtlasRegion[region_count], Color[width * height]. */
+    static const char AtlasMagic[8] = {'A', 'E', 'O', 'N', 'A', 'T', 'L', 'S'};
+    static const uint32_t AtlasVersion = 1;
+
+    struct AtlasHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t width;
+        uint32_t height;
+        uint32_t padding;
+        uint32_t region_count;
+    };
+
+    struct AtlasRegion
+    {
+        int32_t x;
+        int32_t y;
+        uint32_t width;
+        uint32_t height;
+        uint32_t used;
+    };
+
+    TextureAtlas::TextureAtlas ( uint32_t aWidth, uint32_t aHeight, uint32_t aPadding ) :
+        mPacker{aWidth, aHeight, aPadding},
+        mBitmap ( static_cast<size_t> ( aWidth ) * aHeight )
+    {
+    }
+
+    TextureAtlas::~TextureAtlas() = default;
+
+    void TextureAtlas::Blit ( const Color* aSource, uint32_t aSourceWidth, const Rect& aSourceRect, int32_t aX, int32_t aY )
+    {
+        for ( uint32_t y = 0; y < aSourceRect.GetHeight(); ++y )
+        {
+            std::copy_n ( aSource + ( ( aSourceRect.GetY() + y ) * aSourceWidth ) + aSourceRect.GetX(),
+                          aSourceRect.GetWidth(),
+                          mBitmap.data() + ( ( aY + y ) * mPacker.GetWidth() ) + aX );
+        }
+    }
+
+    TextureAtlas::Handle TextureAtlas::Add ( const Image& aImage )
+    {
+        const uint32_t width = aImage.GetWidth();
+        const uint32_t height = aImage.GetHeight();
+        if ( mNeedsRepack && !Compact() )
+        {
+            return InvalidHandle;
+        }
+        Rect rect;
+        if ( aImage.GetBitmap() == nullptr || !mPacker.Insert ( width, height, rect ) )
+        {
+            return InvalidHandle;
+        }
+        Blit ( aImage.GetBitmap(), width, Rect{0, 0, width, height}, rect.GetX(), rect.GetY() );
+        Handle handle;
+        if ( !mFreeHandles.empty() )
+        {
+            handle = mFreeHandles.back();
+            mFreeHandles.pop_back();
+            mRegions[handle] = Region{rect, 1};
+        }
+        else
+        {
+            handle = static_cast<Handle> ( mRegions.size() );
+            mRegions.push_back ( Region{rect, 1} );
+        }
+        return handle;
+    }
+
+    void TextureAtlas::Remove ( Handle aHandle )
+    {
+        if ( aHandle < mRegions.size() && mRegions[aHandle].used )
+        {
+            mRegions[aHandle].used = 0;
+            mFreeHandles.push_back ( aHandle );
+        }
+    }
+
+    const Rect& TextureAtlas::GetRegion ( Handle aHandle ) const
+    {
+        return mRegions.at ( aHandle ).rect;
+    }
+
+    bool TextureAtlas::Compact()
+    {
+        std::vector<Handle> handles;
+        for ( Handle i = 0; i < mRegions.size(); ++i )
+        {
+            if ( mRegions[i].used )
+            {
+                handles.push_back ( i );
+            }
+        }
+        // Tallest first packs tighter on a skyline.
+        std::sort ( handles.begin(), handles.end(), [this] ( Handle a, Handle b )
+        {
+            return mRegions[a].rect.GetHeight() > mRegions[b].rect.GetHeight();
+        } );
+
+        AtlasPacker packer{mPacker};
+        packer.Reset();
+        std::vector<Rect> rects ( handles.size() );
+        for ( size_t i = 0; i < handles.size(); ++i )
+        {
+            const Rect& rect = mRegions[handles[i]].rect;
+            if ( !packer.Insert ( rect.GetWidth(), rect.GetHeight(), rects[i] ) )
+            {
+                return false;
+            }
+        }
+
+        std::vector<Color> source ( mBitmap.size() );
+        source.swap ( mBitmap );
+        for ( size_t i = 0; i < handles.size(); ++i )
+        {
+            Blit ( source.data(), mPacker.GetWidth(), mRegions[handles[i]].rect, rects[i].GetX(), rects[i].GetY() );
+            mRegions[handles[i]].rect = rects[i];
+        }
+        mPacker = packer;
+        mNeedsRepack = false;
+        return true;
+    }
+
+    uint32_t TextureAtlas::GetWidth() const
+    {
+        return mPacker.GetWidth();
+    }
+
+    uint32_t TextureAtlas::GetHeight() const
+    {
+        return mPacker.GetHeight();
+    }
+
+    const Color* TextureAtlas::GetBitmap() const
+    {
+        return mBitmap.data();
+    }
+
+    double TextureAtlas::GetOccupancy() const
+    {
+        return mPacker.GetOccupancy();
+    }
+
+    bool TextureAtlas::Save ( const char* aFilename ) const
+    {
+        std::ofstream file ( aFilename, std::ios_base::out | std::ios_base::binary );
+        if ( !file.is_open() )
+        {
+            return false;
+        }
+        AtlasHeader header{};
+        std::copy_n ( AtlasMagic, sizeof ( AtlasMagic ), header.magic );
+        header.version = AtlasVersion;
+        header.width = mPacker.GetWidth();
+        header.height = mPacker.GetHeight();
+        header.padding = mPacker.GetPadding();
+        header.region_count = static_cast<uint32_t> ( mRegions.size() );
+        file.write ( reinterpret_cast<const char*> ( &header ), sizeof ( AtlasHeader ) );
+        for ( auto& i : mRegions )
+        {
+            AtlasRegion region{i.rect.GetX(), i.rect.GetY(), i.rect.GetWidth(), i.rect.GetHeight(), i.used};
+            file.write ( reinterpret_cast<const char*> ( &region ), sizeof ( AtlasRegion ) );
+        }
+        file.write ( reinterpret_cast<const char*> ( mBitmap.data() ), sizeof ( Color ) * mBitmap.size() );
+        return file.good();
+    }
+
+    bool TextureAtlas::Load ( const char* aFilename )
+    {
+        MappedFile file;
+        if ( !file.Open ( aFilename ) || file.GetSize() < sizeof ( AtlasHeader ) )
+        {
+            return false;
+        }
+        AtlasHeader header;
+        std::copy_n ( file.GetData(), sizeof ( AtlasHeader ), reinterpret_cast<uint8_t*> ( &header ) );
+        const size_t pixel_count = static_cast<size_t> ( header.width ) * header.height;
+        if ( !std::equal ( AtlasMagic, AtlasMagic + sizeof ( AtlasMagic ), header.magic ) || header.version != AtlasVersion ||
+             file.GetSize() != sizeof ( AtlasHeader ) + ( sizeof ( AtlasRegion ) * header.region_count ) + ( sizeof ( Color ) * pixel_count ) )
+        {
+            return false;
+        }
+
+        // Regions are checked against the atlas bounds before anything is replaced, so a bad file leaves the atlas as it was.
+        const uint8_t* data = file.GetData() + sizeof ( AtlasHeader );
+        std::vector<Region> regions ( header.region_count );
+        std::vector<Handle> free_handles;
+        for ( uint32_t i = 0; i < header.region_count; ++i, data += sizeof ( AtlasRegion ) )
+        {
+            AtlasRegion region;
+            std::copy_n ( data, sizeof ( AtlasRegion ), reinterpret_cast<uint8_t*> ( &region ) );
+            if ( region.x < 0 || region.y < 0 ||
+                 static_cast<uint64_t> ( region.x ) + region.width > header.width ||
+                 static_cast<uint64_t> ( region.y ) + region.height > header.height )
+            {
+                return false;
+            }
+            regions[i] = Region{Rect{region.x, region.y, region.width, region.height}, region.used};
+            if ( !region.used )
+            {
+                free_handles.push_back ( i );
+            }
+        }
+
+        // The saved layout is used as is, the packer is only rebuilt if more images are added.
+        mPacker = AtlasPacker{header.width, header.height, header.padding};
+        mRegions.swap ( regions );
+        mFreeHandles.swap ( free_handles );
+        mBitmap.resize ( pixel_count );
+        std::copy_n ( data, sizeof ( Color ) * pixel_count, reinterpret_cast<uint8_t*> ( mBitmap.data() ) );
+        mNeedsRepack = true;
+        return true;
+    }
+}
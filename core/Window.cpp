@@ -18,29 +18,71 @@ limitations under the License.
 #include <stdexcept>
 #include <string>
 #include "aeongui/Window.h"
+#ifdef AEONGUI_USE_V8
+#include "aeongui/JsV8.h"
+#include "aeongui/JsV8Worker.h"
+#endif
+#ifdef AEONGUI_USE_DUKTAPE
+#include "aeongui/JsDuktape.h"
+#endif
 
 namespace AeonGUI
 {
-    Window::Window ()
+    static std::unique_ptr<JavaScript> CreateJavaScript ( Window* aWindow, Document* aDocument, ScriptThread aScriptThread, ScriptEngine aScriptEngine )
     {
-        mDocument.Load ( mJavaScript );
+        if ( aScriptEngine == ScriptEngine::Default )
+        {
+#ifdef AEONGUI_USE_V8
+            aScriptEngine = ScriptEngine::V8;
+#else
+            aScriptEngine = ScriptEngine::Duktape;
+#endif
+        }
+        switch ( aScriptEngine )
+        {
+#ifdef AEONGUI_USE_V8
+        case ScriptEngine::V8:
+            if ( aScriptThread == ScriptThread::Dedicated )
+            {
+                return std::make_unique<V8Worker> ( aWindow, aDocument );
+            }
+            return std::make_unique<V8> ( aWindow, aDocument );
+#endif
+#ifdef AEONGUI_USE_DUKTAPE
+        case ScriptEngine::Duktape:
+            if ( aScriptThread == ScriptThread::Dedicated )
+            {
+                throw std::runtime_error ( "Duktape scripts can only run on the window thread" );
+            }
+            return std::make_unique<JsDuktape> ( aWindow, aDocument );
+#endif
+        default:
+            throw std::runtime_error ( "Script engine not available in this build" );
+        }
     }
-    Window::Window ( const std::string aFilename, uint32_t aWidth, uint32_t aHeight ) :
+
+    Window::Window () :
+        mJavaScript{CreateJavaScript ( this, &mDocument, ScriptThread::Shared, ScriptEngine::Default ) }
+    {
+        mDocument.Load ( *mJavaScript );
+    }
+    Window::Window ( const std::string aFilename, uint32_t aWidth, uint32_t aHeight, ScriptThread aScriptThread, ScriptEngine aScriptEngine ) :
         mDocument{aFilename},
-        mJavaScript{this, &mDocument},
+        mJavaScript{CreateJavaScript ( this, &mDocument, aScriptThread, aScriptEngine ) },
         mCanvas{aWidth, aHeight}
     {
-        mDocument.Load ( mJavaScript );
+        mDocument.Load ( *mJavaScript );
     }
 
     Window::~Window()
     {
-        mDocument.Unload ( mJavaScript );
+        mDocument.Unload ( *mJavaScript );
     }
 
     void Window::ResizeViewport ( uint32_t aWidth, uint32_t aHeight )
     {
         mCanvas.ResizeViewport ( aWidth, aHeight );
+        mDirty = true;
     }
 
     const uint8_t* Window::GetPixels() const
@@ -63,7 +105,71 @@ namespace AeonGUI
 
     void Window::Draw()
     {
+        const std::chrono::steady_clock::time_point frame_start = std::chrono::steady_clock::now();
+        const double timestamp = std::chrono::duration<double, std::milli> ( frame_start - mTimeOrigin ).count();
+        // A single callback can't be interrupted, so running late counts as an overrun too.
+        if ( !mJavaScript->RunAnimationFrameCallbacks ( timestamp, frame_start + mAnimationFrameBudget ) ||
+             std::chrono::steady_clock::now() - frame_start > mAnimationFrameBudget )
+        {
+            ++mAnimationFrameOverruns;
+        }
+        const std::chrono::steady_clock::time_point draw_start = std::chrono::steady_clock::now();
+        mJavaScript->ProcessCommands();
+        mDocument.ApplyPendingAttributes();
         mCanvas.Clear();
         mDocument.Draw ( mCanvas );
+        mDirty = false;
+        const std::chrono::steady_clock::time_point frame_end = std::chrono::steady_clock::now();
+        mFrameStatistics.script_time = draw_start - frame_start;
+        mFrameStatistics.draw_time = frame_end - draw_start;
+        if ( mSampleScriptStatistics )
+        {
+            const ScriptStatistics script = mJavaScript->GetStatistics();
+            mFrameStatistics.gc_count = script.gc_count - mFrameStatistics.script.gc_count;
+            mFrameStatistics.gc_pause_time = script.gc_pause_time - mFrameStatistics.script.gc_pause_time;
+            mFrameStatistics.script = script;
+        }
+    }
+
+    bool Window::NeedsFrame() const
+    {
+        return mDirty || mDocument.HasPendingAttributes() ||
+               mJavaScript->HasPendingCommands() || mJavaScript->HasAnimationFrameCallbacks();
+    }
+
+    void Window::SetAnimationFrameBudget ( std::chrono::microseconds aBudget )
+    {
+        mAnimationFrameBudget = aBudget;
+    }
+
+    size_t Window::GetAnimationFrameOverruns() const
+    {
+        return mAnimationFrameOverruns;
+    }
+
+    void Window::SetScriptStatisticsSampling ( bool aEnabled )
+    {
+        mSampleScriptStatistics = aEnabled;
+        // The first sampled frame counts collections from here on, not since the engine started.
+        mFrameStatistics = FrameStatistics{};
+        if ( aEnabled )
+        {
+            mFrameStatistics.script = mJavaScript->GetStatistics();
+        }
+    }
+
+    const FrameStatistics& Window::GetFrameStatistics() const
+    {
+        return mFrameStatistics;
+    }
+
+    bool Window::CollectGarbage ( std::chrono::steady_clock::time_point aDeadline )
+    {
+        const bool collected = mJavaScript->CollectGarbage ( aDeadline );
+        if ( mSampleScriptStatistics )
+        {
+            mFrameStatistics.script = mJavaScript->GetStatistics();
+        }
+        return collected;
     }
 }
@@ -15,12 +15,50 @@ Copyright (C) 2010-2013,2019,2020 Rodrigo Hernandez Cordoba
 ******************************************************************************/
 #include <iostream>
 #include <string>
+#include <regex>
 #include "Element.h"
 #include "aeongui/Color.h"
+#include "aeongui/Document.h"
 
 namespace AeonGUI
 {
     int ParseStyle ( AttributeMap& aAttributeMap, const char* s );
+
+    static const std::regex number{"-?([0-9]+|[0-9]*\\.[0-9]+([eE][-+]?[0-9]+)?)"};
+    /*  Only these attributes take colors, anywhere else a color keyword
+        such as an id of "red" or a class of "none" is just a string. */
+    static bool IsColorAttribute ( std::string_view aName )
+    {
+        return aName == "fill" || aName == "stroke" || aName == "stop-color" ||
+               aName == "color" || aName == "flood-color" || aName == "lighting-color";
+    }
+    AttributeType ParseAttributeValue ( const char* aName, const char* aValue )
+    {
+        std::cmatch match;
+        Color color;
+        // Ids are always looked up as strings, even if they look like numbers or colors.
+        if ( std::string_view{aName} == "id" )
+        {
+            return std::string{aValue};
+        }
+        else if ( std::regex_match ( aValue, match, number ) )
+        {
+            return std::stod ( match[0].str() );
+        }
+        else if ( IsColorAttribute ( aName ) )
+        {
+            if ( Color::Parse ( aValue, color ) )
+            {
+                return ColorAttr{color};
+            }
+            else if ( std::string_view{aValue} == "none" )
+            {
+                return ColorAttr{};
+            }
+        }
+        return std::string{aValue};
+    }
+
     Element::Element ( const std::string& aTagName, const AttributeMap& aAttributes ) : mTagName{aTagName}, mAttributeMap{aAttributes}
     {
         auto style = mAttributeMap.find ( "style" );
@@ -65,6 +103,41 @@ namespace AeonGUI
         return std::holds_alternative<std::monostate> ( attr ) ? aDefault : attr;
     }
 
+    void Element::SetAttribute ( const char* aAttrName, const std::string& aValue )
+    {
+        std::string_view name{aAttrName};
+        Document* document = ownerDocument();
+        if ( name == "id" )
+        {
+            if ( document )
+            {
+                document->RemoveFromIndex ( this );
+            }
+            mAttributeMap[aAttrName] = ParseAttributeValue ( aAttrName, aValue.c_str() );
+            if ( document )
+            {
+                document->AddToIndex ( this );
+            }
+        }
+        else if ( name == "style" )
+        {
+            mAttributeMap[aAttrName] = aValue;
+            if ( ParseStyle ( mAttributeMap, aValue.c_str() ) )
+            {
+                std::cerr << "Error parsing style: " << aValue << std::endl;
+            }
+        }
+        else
+        {
+            mAttributeMap[aAttrName] = ParseAttributeValue ( aAttrName, aValue.c_str() );
+        }
+    }
+
+    void Element::OnAttributesChanged()
+    {
+        // Do nothing by default
+    }
+
     Node::NodeType Element::nodeType() const
     {
         return ELEMENT_NODE;
@@ -29,12 +29,22 @@ namespace AeonGUI
     class Canvas;
     class JavaScript;
     class Document;
+    /** Parses an attribute value the same way document attributes are parsed,
+     *  into a number or a plain string, colors and none are only recognized for color attributes such as fill
+     *  and id is always kept as a string. */
+    DLL AttributeType ParseAttributeValue ( const char* aName, const char* aValue );
     class Element : public Node
     {
     public:
         DLL Element ( const std::string& aTagName, const AttributeMap& aAttributes );
         DLL AttributeType GetAttribute ( const char* attrName, const AttributeType& aDefault = {} ) const;
         DLL AttributeType GetInheritedAttribute ( const char* attrName, const AttributeType& aDefault = {} ) const;
+        /** Sets an attribute from its string value.
+         *  Elements of a drawn document should be written through Document::QueueAttribute instead,
+         *  so many writes cost a single OnAttributesChanged call. */
+        DLL void SetAttribute ( const char* aAttrName, const std::string& aValue );
+        /** Called once after a batch of attribute writes has been applied to the element. */
+        DLL virtual void OnAttributesChanged();
         DLL virtual ~Element();
         /**DOM Properties and Methods @{*/
         NodeType nodeType() const final;
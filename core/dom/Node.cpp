@@ -16,7 +16,9 @@ Copyright (C) 2010-2013,2019,2020 Rodrigo Hernandez Cordoba
 #include <iostream>
 #include <string>
 #include "Node.h"
+#include "Element.h"
 #include "aeongui/Color.h"
+#include "aeongui/Document.h"
 
 namespace AeonGUI
 {
@@ -61,6 +63,37 @@ namespace AeonGUI
     {
         return mParent;
     }
+    Document* Node::ownerDocument() const
+    {
+        return mOwnerDocument;
+    }
+
+    void Node::SetOwnerDocument ( Document* aDocument )
+    {
+        if ( mOwnerDocument == aDocument )
+        {
+            return;
+        }
+        if ( nodeType() == ELEMENT_NODE )
+        {
+            if ( mOwnerDocument )
+            {
+                mOwnerDocument->RemoveFromIndex ( reinterpret_cast<Element*> ( this ) );
+                mOwnerDocument->DropPendingAttributes ( reinterpret_cast<Element*> ( this ) );
+            }
+            if ( aDocument )
+            {
+                aDocument->AddToIndex ( reinterpret_cast<Element*> ( this ) );
+                aDocument->ForgetCreatedElement ( reinterpret_cast<Element*> ( this ) );
+            }
+        }
+        mOwnerDocument = aDocument;
+        for ( auto& i : mChildren )
+        {
+            i->SetOwnerDocument ( aDocument );
+        }
+    }
+
     Node* Node::parentElement() const
     {
         if ( mParent && mParent->nodeType() == ELEMENT_NODE )
@@ -199,6 +232,7 @@ namespace AeonGUI
     Node* Node::AddNode ( Node* aNode )
     {
         aNode->mParent = this;
+        aNode->SetOwnerDocument ( mOwnerDocument );
         return mChildren.emplace_back ( aNode );
     }
 
@@ -213,8 +247,9 @@ namespace AeonGUI
         {
             result = std::move ( *i );
             mChildren.erase ( std::remove ( i, mChildren.end(), *i ), mChildren.end() );
+            result->mParent = nullptr;
+            result->SetOwnerDocument ( nullptr );
         }
-        result->mParent = nullptr;
         return result;
     }
 }
@@ -71,10 +71,16 @@ namespace AeonGUI
         /**DOM Properties and Methods @{*/
         DLL Node* parentNode() const;
         DLL Node* parentElement() const;
+        DLL Document* ownerDocument() const;
         virtual NodeType nodeType() const = 0;
         const std::vector<Node*>& childNodes() const;
         /**@}*/
     private:
+        friend class Document;
+        /** Sets the owner document of the node and its descendants,
+         *  moving their ids from the old document index to the new one. */
+        void SetOwnerDocument ( Document* aDocument );
+        Document* mOwnerDocument{};
         Node* mParent{};
         std::vector<Node*> mChildren{};
         mutable std::vector<Node*>::size_type mIterator{ 0 };
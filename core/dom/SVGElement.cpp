@@ -13,6 +13,7 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License.
 */
+#include <cstdlib>
 #include "SVGElement.h"
 
 namespace AeonGUI
@@ -21,5 +22,34 @@ namespace AeonGUI
     {
         SVGElement::SVGElement ( const std::string& aTagName, const AttributeMap& aAttributes ) : Element { aTagName, aAttributes } {}
         SVGElement::~SVGElement() = default;
+        double SVGElement::Coordinate::Resolve ( double aReference ) const
+        {
+            return percentage ? ( value / 100.0 ) * aReference : value;
+        }
+
+        double SVGElement::GetNumberOrPercentage ( const char* aAttrName, double aDefault ) const
+        {
+            return GetCoordinate ( aAttrName, Coordinate{aDefault, false} ).Resolve ( 1.0 );
+        }
+
+        SVGElement::Coordinate SVGElement::GetCoordinate ( const char* aAttrName, const Coordinate& aDefault ) const
+        {
+            AttributeType value = GetAttribute ( aAttrName );
+            if ( std::holds_alternative<double> ( value ) )
+            {
+                return Coordinate{std::get<double> ( value ), false};
+            }
+            else if ( std::holds_alternative<std::string> ( value ) )
+            {
+                const char* string = std::get<std::string> ( value ).c_str();
+                char* end{};
+                double number = std::strtod ( string, &end );
+                if ( end != string )
+                {
+                    return Coordinate{number, *end == '%'};
+                }
+            }
+            return aDefault;
+        }
     }
 }
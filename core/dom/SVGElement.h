@@ -26,6 +26,21 @@ namespace AeonGUI
         public:
             SVGElement ( const std::string& aTagName, const AttributeMap& aAttributes );
             ~SVGElement() override;
+        protected:
+            /** A coordinate given either in user units or as a percentage of a reference length. */
+            struct Coordinate
+            {
+                double value;
+                bool percentage;
+                /** @return The value in user units, percentages taken of aReference. */
+                double Resolve ( double aReference ) const;
+            };
+            /** Reads an attribute that may be given as a plain number or as a percentage,
+             *  percentages are returned as fractions (50% == 0.5). */
+            double GetNumberOrPercentage ( const char* aAttrName, double aDefault ) const;
+            /** Reads a coordinate attribute, keeping whether it was a percentage so it can be
+             *  resolved later against a length that is not known yet. */
+            Coordinate GetCoordinate ( const char* aAttrName, const Coordinate& aDefault ) const;
         };
     }
 }
@@ -13,7 +13,9 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License.
 */
+#include <algorithm>
 #include "SVGGradientElement.h"
+#include "SVGStopElement.h"
 
 namespace AeonGUI
 {
@@ -21,7 +23,94 @@ namespace AeonGUI
     {
         SVGGradientElement::SVGGradientElement ( const std::string& aTagName, const AttributeMap& aAttributes ) : SVGElement {aTagName, aAttributes}
         {
+            AttributeType units = GetAttribute ( "gradientUnits" );
+            if ( std::holds_alternative<std::string> ( units ) && std::get<std::string> ( units ) == "userSpaceOnUse" )
+            {
+                mUnits = Gradient::USER_SPACE_ON_USE;
+            }
+            AttributeType spread = GetAttribute ( "spreadMethod" );
+            if ( std::holds_alternative<std::string> ( spread ) )
+            {
+                if ( std::get<std::string> ( spread ) == "reflect" )
+                {
+                    mSpread = Gradient::REFLECT;
+                }
+                else if ( std::get<std::string> ( spread ) == "repeat" )
+                {
+                    mSpread = Gradient::REPEAT;
+                }
+            }
+            /**@todo Support gradientTransform and href stop inheritance.*/
         }
         SVGGradientElement::~SVGGradientElement() = default;
+
+        bool SVGGradientElement::IsDrawEnabled() const
+        {
+            return false;
+        }
+
+        /*  Compares the current child stops against the cached ones in place,
+            so the common case of unchanged stops does not allocate. */
+        bool SVGGradientElement::UpdateColorStops() const
+        {
+            bool changed{false};
+            size_t count{0};
+            double last_offset{0.0};
+            for ( auto& i : childNodes() )
+            {
+                const SVGStopElement* stop = dynamic_cast<const SVGStopElement*> ( i );
+                if ( stop == nullptr )
+                {
+                    continue;
+                }
+                ColorStop color_stop{stop->GetColorStop() };
+                /*  https://www.w3.org/TR/SVG/pservers.html#StopElementOffsetAttribute
+                    An offset less than a previous stop offset is set to the largest previous offset. */
+                color_stop.offset = std::max ( color_stop.offset, last_offset );
+                last_offset = color_stop.offset;
+                if ( count < mColorStops.size() )
+                {
+                    if ( ! ( mColorStops[count] == color_stop ) )
+                    {
+                        mColorStops[count] = color_stop;
+                        changed = true;
+                    }
+                }
+                else
+                {
+                    mColorStops.emplace_back ( color_stop );
+                    changed = true;
+                }
+                ++count;
+            }
+            if ( count != mColorStops.size() )
+            {
+                mColorStops.resize ( count );
+                changed = true;
+            }
+            return changed;
+        }
+
+        const Gradient* SVGGradientElement::GetGradient ( double aViewportWidth, double aViewportHeight ) const
+        {
+            const bool viewport_changed = ( mUnits == Gradient::USER_SPACE_ON_USE ) &&
+                                          ( aViewportWidth != mViewportWidth || aViewportHeight != mViewportHeight );
+            if ( UpdateColorStops() || !mConstructed || viewport_changed )
+            {
+                mViewportWidth = aViewportWidth;
+                mViewportHeight = aViewportHeight;
+                if ( mUnits == Gradient::USER_SPACE_ON_USE )
+                {
+                    Construct ( mGradient, mColorStops, mUnits, mSpread, aViewportWidth, aViewportHeight );
+                }
+                else
+                {
+                    // Bounding box units are fractions of the box, 100% == 1.
+                    Construct ( mGradient, mColorStops, mUnits, mSpread, 1.0, 1.0 );
+                }
+                mConstructed = true;
+            }
+            return &mGradient;
+        }
     }
-}
\ No newline at end of file
+}
@@ -16,7 +16,10 @@ limitations under the License.
 #ifndef AEONGUI_SVGGRADIENTELEMENT_H
 #define AEONGUI_SVGGRADIENTELEMENT_H
 
+#include <vector>
 #include "SVGElement.h"
+// Gradient type should be selectable and should match Canvas type
+#include "aeongui/CairoGradient.h"
 
 namespace AeonGUI
 {
@@ -28,6 +31,27 @@ namespace AeonGUI
         public:
             SVGGradientElement ( const std::string& aTagName, const AttributeMap& aAttributes );
             ~SVGGradientElement() override;
+            bool IsDrawEnabled() const final;
+            /** Returns the paint server for this gradient.
+             *  The underlying pattern is cached and only rebuilt when the color stops change,
+             *  or the viewport does for userSpaceOnUse gradients,
+             *  so every element referencing the gradient shares the same pattern.
+             *  @param aViewportWidth Width percentages resolve against with userSpaceOnUse.
+             *  @param aViewportHeight Height percentages resolve against with userSpaceOnUse. */
+            const Gradient* GetGradient ( double aViewportWidth, double aViewportHeight ) const;
+        protected:
+            /** Builds the pattern, percentages resolve against aWidth and aHeight,
+             *  which are 1 for objectBoundingBox and the viewport size for userSpaceOnUse. */
+            virtual void Construct ( Gradient& aGradient, const std::vector<ColorStop>& aColorStops, Gradient::Units aUnits, Gradient::Spread aSpread , double aWidth, double aHeight ) const = 0;
+        private:
+            bool UpdateColorStops() const;
+            Gradient::Units mUnits{Gradient::OBJECT_BOUNDING_BOX};
+            Gradient::Spread mSpread{Gradient::PAD};
+            mutable CairoGradient mGradient{};
+            mutable std::vector<ColorStop> mColorStops{};
+            mutable bool mConstructed{false};
+            mutable double mViewportWidth{};
+            mutable double mViewportHeight{};
         };
     }
 }
@@ -24,11 +24,16 @@ namespace AeonGUI
 {
     namespace DOM
     {
+        class SVGGradientElement;
         class SVGGraphicsElement : public SVGElement
         {
         public:
             SVGGraphicsElement ( const std::string& aTagName, const AttributeMap& aAttributes );
             ~SVGGraphicsElement() override;
+            /** Sets fill, stroke and opacity properties on the canvas from the element attributes. */
+            void SetPaint ( Canvas& aCanvas ) const;
+        private:
+            ColorAttr GetPaint ( const char* aAttrName, const ColorAttr& aDefault, const Canvas& aCanvas ) const;
         };
     }
 }
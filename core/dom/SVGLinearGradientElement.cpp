@@ -19,9 +19,17 @@ namespace AeonGUI
 {
     namespace DOM
     {
-        SVGLinearGradientElement::SVGLinearGradientElement ( const std::string& aTagName, const AttributeMap& aAttributes ) : SVGGradientElement {aTagName, aAttributes}
+        SVGLinearGradientElement::SVGLinearGradientElement ( const std::string& aTagName, const AttributeMap& aAttributes ) : SVGGradientElement {aTagName, aAttributes},
+            mX1{GetCoordinate ( "x1", {0.0, true} ) },
+            mY1{GetCoordinate ( "y1", {0.0, true} ) },
+            mX2{GetCoordinate ( "x2", {100.0, true} ) },
+            mY2{GetCoordinate ( "y2", {0.0, true} ) }
         {
         }
         SVGLinearGradientElement::~SVGLinearGradientElement() = default;
+        void SVGLinearGradientElement::Construct ( Gradient& aGradient, const std::vector<ColorStop>& aColorStops, Gradient::Units aUnits, Gradient::Spread aSpread, double aWidth, double aHeight ) const
+        {
+            aGradient.ConstructLinear ( mX1.Resolve ( aWidth ), mY1.Resolve ( aHeight ), mX2.Resolve ( aWidth ), mY2.Resolve ( aHeight ), aColorStops, aUnits, aSpread );
+        }
     }
 }
\ No newline at end of file
@@ -29,6 +29,13 @@ namespace AeonGUI
         public:
             SVGLinearGradientElement ( const std::string& aTagName, const AttributeMap& aAttributes );
             ~SVGLinearGradientElement() final;
+        protected:
+            void Construct ( Gradient& aGradient, const std::vector<ColorStop>& aColorStops, Gradient::Units aUnits, Gradient::Spread aSpread, double aWidth, double aHeight ) const final;
+        private:
+            Coordinate mX1{};
+            Coordinate mY1{};
+            Coordinate mX2{};
+            Coordinate mY2{};
         };
     }
 }
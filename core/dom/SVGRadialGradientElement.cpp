@@ -0,0 +1,43 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#include <cmath>
+#include "SVGRadialGradientElement.h"
+
+namespace AeonGUI
+{
+    namespace DOM
+    {
+        SVGRadialGradientElement::SVGRadialGradientElement ( const std::string& aTagName, const AttributeMap& aAttributes ) : SVGGradientElement {aTagName, aAttributes},
+            mCx{GetCoordinate ( "cx", {50.0, true} ) },
+            mCy{GetCoordinate ( "cy", {50.0, true} ) },
+            mR{GetCoordinate ( "r", {50.0, true} ) },
+            // The focal point defaults to the center.
+            mFx{GetCoordinate ( "fx", mCx ) },
+            mFy{GetCoordinate ( "fy", mCy ) }
+        {
+        }
+        SVGRadialGradientElement::~SVGRadialGradientElement() = default;
+        void SVGRadialGradientElement::Construct ( Gradient& aGradient, const std::vector<ColorStop>& aColorStops, Gradient::Units aUnits, Gradient::Spread aSpread, double aWidth, double aHeight ) const
+        {
+            /*  https://www.w3.org/TR/SVG2/coords.html#Units
+                Percentages of lengths that are neither horizontal nor vertical
+                refer to the normalized diagonal of the reference box. */
+            const double diagonal = std::sqrt ( ( ( aWidth * aWidth ) + ( aHeight * aHeight ) ) / 2.0 );
+            aGradient.ConstructRadial ( mCx.Resolve ( aWidth ), mCy.Resolve ( aHeight ), mR.Resolve ( diagonal ),
+                                        mFx.Resolve ( aWidth ), mFy.Resolve ( aHeight ), aColorStops, aUnits, aSpread );
+        }
+    }
+}
\ No newline at end of file
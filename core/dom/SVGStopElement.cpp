@@ -14,6 +14,7 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 #include <iostream>
+#include <algorithm>
 #include "SVGStopElement.h"
 
 namespace AeonGUI
@@ -22,7 +23,19 @@ namespace AeonGUI
     {
         SVGStopElement::SVGStopElement ( const std::string& aTagName, const AttributeMap& aAttributes ) : SVGElement {aTagName, aAttributes}
         {
+            mColorStop.offset = std::clamp ( GetNumberOrPercentage ( "offset", 0.0 ), 0.0, 1.0 );
+            AttributeType color = GetAttribute ( "stop-color", Color{black} );
+            if ( std::holds_alternative<ColorAttr> ( color ) && std::holds_alternative<Color> ( std::get<ColorAttr> ( color ) ) )
+            {
+                mColorStop.color = std::get<Color> ( std::get<ColorAttr> ( color ) );
+            }
+            double opacity = std::clamp ( GetNumberOrPercentage ( "stop-opacity", 1.0 ), 0.0, 1.0 );
+            mColorStop.color.a = static_cast<uint8_t> ( static_cast<double> ( mColorStop.color.a ) * opacity );
         }
         SVGStopElement::~SVGStopElement() = default;
+        const ColorStop& SVGStopElement::GetColorStop() const
+        {
+            return mColorStop;
+        }
     }
 }
\ No newline at end of file
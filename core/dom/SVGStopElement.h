@@ -17,6 +17,7 @@ limitations under the License.
 #define AEONGUI_SVGSTOPELEMENT_H
 
 #include "SVGElement.h"
+#include "aeongui/Gradient.h"
 
 namespace AeonGUI
 {
@@ -28,6 +29,10 @@ namespace AeonGUI
         public:
             SVGStopElement ( const std::string& aTagName, const AttributeMap& aAttributes );
             ~SVGStopElement() final;
+            /** Returns the stop offset and color with stop-opacity applied. */
+            const ColorStop& GetColorStop() const;
+        private:
+            ColorStop mColorStop{};
         };
     }
 }
@@ -0,0 +1,40 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#include "SVGTSpanElement.h"
+#include "SVGTextElement.h"
+
+namespace AeonGUI
+{
+    namespace DOM
+    {
+        SVGTSpanElement::SVGTSpanElement ( const std::string& aTagName, const AttributeMap& aAttributes ) : SVGGraphicsElement {aTagName, aAttributes}
+        {
+        }
+        SVGTSpanElement::~SVGTSpanElement() = default;
+
+        void SVGTSpanElement::OnAttributesChanged()
+        {
+            for ( Node* parent = parentNode(); parent != nullptr; parent = parent->parentNode() )
+            {
+                if ( SVGTextElement* text = dynamic_cast<SVGTextElement*> ( parent ) )
+                {
+                    text->InvalidateLayout();
+                    return;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,36 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGUI_SVGTSPANELEMENT_H
+#define AEONGUI_SVGTSPANELEMENT_H
+
+#include "SVGGraphicsElement.h"
+
+namespace AeonGUI
+{
+    namespace DOM
+    {
+        /** Text span, laid out and drawn by its enclosing text element. */
+        class SVGTSpanElement : public SVGGraphicsElement
+        {
+        public:
+            SVGTSpanElement ( const std::string& aTagName, const AttributeMap& aAttributes );
+            ~SVGTSpanElement() final;
+            /** Invalidates the layout of the enclosing text element. */
+            void OnAttributesChanged() final;
+        };
+    }
+}
+#endif
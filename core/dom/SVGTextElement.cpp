@@ -0,0 +1,250 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#include <cstdlib>
+#include "SVGTextElement.h"
+#include "SVGTSpanElement.h"
+#include "Text.h"
+#include "aeongui/Canvas.h"
+
+namespace AeonGUI
+{
+    namespace DOM
+    {
+        SVGTextElement::SVGTextElement ( const std::string& aTagName, const AttributeMap& aAttributes ) : SVGGraphicsElement {aTagName, aAttributes}
+        {
+        }
+        SVGTextElement::~SVGTextElement() = default;
+
+        /** Text between two position changes, shaped into a single run. */
+        struct TextChunk
+        {
+            const SVGGraphicsElement* source;
+            std::string text;
+            bool absolute_x;
+            bool absolute_y;
+            double x;
+            double y;
+            double dx;
+            double dy;
+        };
+
+        /*  Lengths with units such as "12px" are kept as strings by the
+            document parser, only the leading number is used. */
+        static double ToNumber ( const AttributeType& aValue, double aDefault )
+        {
+            if ( std::holds_alternative<double> ( aValue ) )
+            {
+                return std::get<double> ( aValue );
+            }
+            else if ( std::holds_alternative<std::string> ( aValue ) )
+            {
+                const char* string = std::get<std::string> ( aValue ).c_str();
+                char* end{};
+                double number = std::strtod ( string, &end );
+                if ( end != string )
+                {
+                    return number;
+                }
+            }
+            return aDefault;
+        }
+
+        /*  Only the first family of a font-family list is requested,
+            the font backend falls back to a default face if it is missing. */
+        static std::string GetFontFamily ( const Element* aElement )
+        {
+            AttributeType family = aElement->GetInheritedAttribute ( "font-family" );
+            if ( std::holds_alternative<std::string> ( family ) )
+            {
+                const std::string& families = std::get<std::string> ( family );
+                size_t start = families.find_first_not_of ( " \t\"'" );
+                size_t end = families.find_first_of ( ",\"'", start );
+                if ( start != std::string::npos )
+                {
+                    std::string result = families.substr ( start, ( end == std::string::npos ) ? end : end - start );
+                    result.erase ( result.find_last_not_of ( " \t" ) + 1 );
+                    if ( !result.empty() )
+                    {
+                        return result;
+                    }
+                }
+            }
+            return "sans-serif";
+        }
+
+        static bool IsBold ( const Element* aElement )
+        {
+            AttributeType weight = aElement->GetInheritedAttribute ( "font-weight" );
+            if ( std::holds_alternative<double> ( weight ) )
+            {
+                return std::get<double> ( weight ) >= 600.0;
+            }
+            else if ( std::holds_alternative<std::string> ( weight ) )
+            {
+                return std::get<std::string> ( weight ) == "bold" || std::get<std::string> ( weight ) == "bolder";
+            }
+            return false;
+        }
+
+        static TextChunk StartChunk ( const SVGGraphicsElement* aSource )
+        {
+            AttributeType x = aSource->GetAttribute ( "x" );
+            AttributeType y = aSource->GetAttribute ( "y" );
+            return TextChunk
+            {
+                aSource, {},
+                !std::holds_alternative<std::monostate> ( x ),
+                !std::holds_alternative<std::monostate> ( y ),
+                ToNumber ( x, 0.0 ),
+                ToNumber ( y, 0.0 ),
+                ToNumber ( aSource->GetAttribute ( "dx" ), 0.0 ),
+                ToNumber ( aSource->GetAttribute ( "dy" ), 0.0 )
+            };
+        }
+
+        /*  https://www.w3.org/TR/SVG2/text.html#WhiteSpace
+            Default white space handling: line breaks and tabs become spaces,
+            consecutive spaces collapse into one and leading spaces are dropped.
+            aSpace carries whether the last kept character was a space across text nodes. */
+        static void AppendCollapsed ( std::string& aText, const std::string& aData, bool& aSpace )
+        {
+            for ( char c : aData )
+            {
+                if ( c == '\n' || c == '\r' || c == '\t' )
+                {
+                    c = ' ';
+                }
+                if ( c == ' ' && aSpace )
+                {
+                    continue;
+                }
+                aSpace = ( c == ' ' );
+                aText.push_back ( c );
+            }
+        }
+
+        static void CollectChunks ( const SVGGraphicsElement* aSource, std::vector<TextChunk>& aChunks, bool& aSpace )
+        {
+            aChunks.emplace_back ( StartChunk ( aSource ) );
+            for ( auto& i : aSource->childNodes() )
+            {
+                if ( i->nodeType() == Node::TEXT_NODE )
+                {
+                    AppendCollapsed ( aChunks.back().text, reinterpret_cast<const Text*> ( i )->data(), aSpace );
+                }
+                else if ( const SVGTSpanElement* tspan = dynamic_cast<const SVGTSpanElement*> ( i ) )
+                {
+                    CollectChunks ( tspan, aChunks, aSpace );
+                    // Text following the span continues from the pen position with the enclosing paint.
+                    aChunks.emplace_back ( TextChunk{aSource, {}, false, false, 0.0, 0.0, 0.0, 0.0} );
+                }
+            }
+        }
+
+        bool SVGTextElement::Font::operator== ( const Font& aFont ) const
+        {
+            return family == aFont.family && size == aFont.size && bold == aFont.bold;
+        }
+
+        SVGTextElement::Font SVGTextElement::ResolveFont ( const SVGGraphicsElement* aSource )
+        {
+            return Font
+            {
+                GetFontFamily ( aSource ),
+                ToNumber ( aSource->GetInheritedAttribute ( "font-size" ), 16.0 ),
+                IsBold ( aSource )
+            };
+        }
+
+        void SVGTextElement::Layout() const
+        {
+            std::vector<TextChunk> chunks;
+            bool space{true};
+            CollectChunks ( this, chunks, space );
+            for ( auto i = chunks.rbegin(); i != chunks.rend(); ++i )
+            {
+                if ( !i->text.empty() )
+                {
+                    if ( i->text.back() == ' ' )
+                    {
+                        i->text.pop_back();
+                    }
+                    break;
+                }
+            }
+            mRuns.clear();
+            double x{};
+            double y{};
+            for ( auto& i : chunks )
+            {
+                x = ( i.absolute_x ? i.x : x ) + i.dx;
+                y = ( i.absolute_y ? i.y : y ) + i.dy;
+                if ( i.text.empty() )
+                {
+                    continue;
+                }
+                Run run{i.source, ResolveFont ( i.source ), std::make_unique<CairoGlyphRun>() };
+                run.glyph_run->Construct ( i.text, run.font.family, run.font.size, run.font.bold, x, y );
+                x += run.glyph_run->GetAdvance();
+                mRuns.emplace_back ( std::move ( run ) );
+            }
+            mLayoutValid = true;
+        }
+
+        /*  Font properties inherit from any ancestor, and ancestors are not told about
+            the text elements below them, so the resolved fonts are compared on every draw.
+            This is a walk up the tree per run, shaping is only redone when one differs. */
+        bool SVGTextElement::IsLayoutValid() const
+        {
+            if ( !mLayoutValid )
+            {
+                return false;
+            }
+            for ( auto& i : mRuns )
+            {
+                if ( ! ( ResolveFont ( i.source ) == i.font ) )
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void SVGTextElement::InvalidateLayout()
+        {
+            mRuns.clear();
+            mLayoutValid = false;
+        }
+
+        void SVGTextElement::OnAttributesChanged()
+        {
+            InvalidateLayout();
+        }
+
+        void SVGTextElement::DrawStart ( Canvas& aCanvas ) const
+        {
+            if ( !IsLayoutValid() )
+            {
+                Layout();
+            }
+            for ( auto& i : mRuns )
+            {
+                i.source->SetPaint ( aCanvas );
+                aCanvas.Draw ( *i.glyph_run );
+            }
+        }
+    }
+}
@@ -0,0 +1,68 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGUI_SVGTEXTELEMENT_H
+#define AEONGUI_SVGTEXTELEMENT_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include "SVGGraphicsElement.h"
+// Glyph run type should be selectable and should match Canvas type
+#include "aeongui/CairoGlyphRun.h"
+
+namespace AeonGUI
+{
+    namespace DOM
+    {
+        /** Text element, its content and tspan children are shaped into glyph runs
+         *  on the first draw and the runs are reused until the layout is invalidated
+         *  or the font a run resolves to through inheritance changes. */
+        class SVGTextElement : public SVGGraphicsElement
+        {
+        public:
+            SVGTextElement ( const std::string& aTagName, const AttributeMap& aAttributes );
+            ~SVGTextElement() final;
+            void DrawStart ( Canvas& aCanvas ) const final;
+            void OnAttributesChanged() final;
+            /** Drops the cached glyph runs,
+             *  must be called when the text or position of the element or any of its spans changes,
+             *  font changes on ancestors are picked up on the next draw. */
+            void InvalidateLayout();
+        private:
+            /** Inherited font properties a run was shaped with. */
+            struct Font
+            {
+                std::string family;
+                double size;
+                bool bold;
+                bool operator== ( const Font& aFont ) const;
+            };
+            /** A shaped run and the element whose paint it is drawn with. */
+            struct Run
+            {
+                const SVGGraphicsElement* source;
+                Font font;
+                std::unique_ptr<CairoGlyphRun> glyph_run;
+            };
+            static Font ResolveFont ( const SVGGraphicsElement* aSource );
+            void Layout() const;
+            bool IsLayoutValid() const;
+            mutable std::vector<Run> mRuns{};
+            mutable bool mLayoutValid{false};
+        };
+    }
+}
+#endif
@@ -38,7 +38,7 @@ namespace AeonGUI
             } );
             if ( text_node != children.end() )
             {
-                aJavaScript.Eval ( reinterpret_cast<const Text*> ( *text_node )->wholeText() );
+                aJavaScript.EvalScript ( reinterpret_cast<const Text*> ( *text_node )->wholeText() );
             }
         }
     }
@@ -57,4 +57,9 @@ namespace AeonGUI
         }
         return mText;
     }
+
+    const std::string& Text::data() const
+    {
+        return mText;
+    }
 }
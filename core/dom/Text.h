@@ -29,6 +29,7 @@ namespace AeonGUI
         /**DOM Properties and Methods @{*/
         NodeType nodeType() const final;
         std::string wholeText() const;
+        const std::string& data() const;
         /**@}*/
     private:
         std::string mText{};
@@ -0,0 +1,72 @@
+/*!
+@file
+@author Rodrigo Hernandez
+@copy 2020
+*/
+#include <vector>
+#include "gtest/gtest.h"
+#include "aeongui/AtlasPacker.h"
+
+using namespace ::testing;
+namespace AeonGUI
+{
+    static bool Overlap ( const Rect& a, const Rect& b, uint32_t aPadding )
+    {
+        return a.GetX() < static_cast<int32_t> ( b.GetX() + b.GetWidth() + aPadding ) &&
+               b.GetX() < static_cast<int32_t> ( a.GetX() + a.GetWidth() + aPadding ) &&
+               a.GetY() < static_cast<int32_t> ( b.GetY() + b.GetHeight() + aPadding ) &&
+               b.GetY() < static_cast<int32_t> ( a.GetY() + a.GetHeight() + aPadding );
+    }
+
+    TEST ( AtlasPackerTest, PlacedRectanglesStayInsideAndApart )
+    {
+        AtlasPacker packer{128, 128, 1};
+        std::vector<Rect> placed;
+        for ( uint32_t i = 0; i < 200; ++i )
+        {
+            Rect rect;
+            if ( !packer.Insert ( 3 + ( i * 7 ) % 13, 2 + ( i * 5 ) % 11, rect ) )
+            {
+                continue;
+            }
+            EXPECT_LE ( rect.GetX() + rect.GetWidth(), 128u );
+            EXPECT_LE ( rect.GetY() + rect.GetHeight(), 128u );
+            for ( auto& other : placed )
+            {
+                EXPECT_FALSE ( Overlap ( rect, other, 1 ) );
+            }
+            placed.push_back ( rect );
+        }
+        EXPECT_GT ( placed.size(), 100u );
+        EXPECT_GT ( packer.GetOccupancy(), 0.7 );
+    }
+
+    TEST ( AtlasPackerTest, RejectsWhatDoesNotFit )
+    {
+        AtlasPacker packer{16, 16, 0};
+        Rect rect;
+        EXPECT_FALSE ( packer.Insert ( 17, 1, rect ) );
+        EXPECT_TRUE ( packer.Insert ( 16, 16, rect ) );
+        EXPECT_FALSE ( packer.Insert ( 1, 1, rect ) );
+        packer.Reset();
+        EXPECT_TRUE ( packer.Insert ( 1, 1, rect ) );
+        EXPECT_EQ ( rect.GetX(), 0 );
+        EXPECT_EQ ( rect.GetY(), 0 );
+    }
+
+    TEST ( AtlasPackerTest, PaddingOnlyGoesBetweenRectangles )
+    {
+        AtlasPacker packer{16, 16, 2};
+        Rect rect;
+        EXPECT_FALSE ( packer.Insert ( 17, 1, rect ) );
+        EXPECT_TRUE ( packer.Insert ( 16, 16, rect ) );
+        EXPECT_DOUBLE_EQ ( packer.GetOccupancy(), 1.0 );
+        packer.Reset();
+        // Two 7 wide rectangles plus the padding between them fill the row exactly.
+        EXPECT_TRUE ( packer.Insert ( 7, 16, rect ) );
+        EXPECT_EQ ( rect.GetX(), 0 );
+        EXPECT_TRUE ( packer.Insert ( 7, 16, rect ) );
+        EXPECT_EQ ( rect.GetX(), 9 );
+        EXPECT_FALSE ( packer.Insert ( 1, 1, rect ) );
+    }
+}
@@ -0,0 +1,359 @@
+/*!
+@file
+@author Rodrigo Hernandez
+@copy 2020
+*/
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "aeongui/PixelConversion.h"
+#include "aeongui/CpuFeatures.h"
+#include "aeongui/Compositing.h"
+#include "aeongui/DistanceField.h"
+#include "Image.h"
+#include "pcx.h"
+#if defined(AEONGUI_TEST_FONT)
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include "aeongui/GlyphCache.h"
+#endif
+#if defined(AEONGUI_USE_DUKTAPE)
+#include "aeongui/Document.h"
+#include "aeongui/JsDuktape.h"
+#endif
+
+/*  Timed runs of the hot loops the library has vector or cached paths for.
+    Not registered with CTest, timings depend on the machine and its load.
+    Build with optimizations (CMAKE_BUILD_TYPE=Release) before reading the numbers. */
+namespace AeonGUI
+{
+    template<class F>
+    static double BestSeconds ( size_t aRepetitions, F aFunction )
+    {
+        double best{1e30};
+        for ( size_t i = 0; i < aRepetitions; ++i )
+        {
+            auto start = std::chrono::steady_clock::now();
+            aFunction();
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            best = ( elapsed.count() < best ) ? elapsed.count() : best;
+        }
+        return best;
+    }
+
+    static void BenchmarkPixelConversion()
+    {
+        const uint32_t width{1920};
+        const uint32_t height{1080};
+        std::vector<uint8_t> source ( size_t{width} * height * 4 );
+        for ( size_t i = 0; i < source.size(); ++i )
+        {
+            source[i] = static_cast<uint8_t> ( ( i * 37 ) + 11 );
+        }
+        std::vector<Color> destination ( size_t{width} * height );
+        std::printf ( "Pixel conversion, %ux%u image, MB/s of source read\n", width, height );
+        std::printf ( "%-8s %12s %12s %12s %12s\n", "format", "scalar", "ssse3", "avx2", "neon" );
+        const struct
+        {
+            const char* name;
+            PixelFormat format;
+            size_t size;
+        } formats[] = {{"RGB", PixelFormat::RGB, 3}, {"BGR", PixelFormat::BGR, 3}, {"RGBA", PixelFormat::RGBA, 4}, {"BGRA", PixelFormat::BGRA, 4}};
+        for ( const auto& format : formats )
+        {
+            const double megabytes = static_cast<double> ( size_t{width} * height * format.size ) / ( 1024.0 * 1024.0 );
+            std::printf ( "%-8s", format.name );
+            for ( uint32_t features : {0u, static_cast<uint32_t> ( CPU_SSSE3 ), static_cast<uint32_t> ( CPU_AVX2 ), static_cast<uint32_t> ( CPU_NEON ) } )
+            {
+                if ( !ConvertPixelRowWith ( features, format.format, source.data(), destination.data(), 1 ) )
+                {
+                    std::printf ( " %12s", "n/a" );
+                    continue;
+                }
+                double seconds = BestSeconds ( 20, [&]()
+                {
+                    for ( uint32_t y = 0; y < height; ++y )
+                    {
+                        ConvertPixelRowWith ( features, format.format, source.data() + ( size_t{y} * width * format.size ), destination.data() + ( size_t{y} * width ), width );
+                    }
+                } );
+                std::printf ( " %12.1f", megabytes / seconds );
+            }
+            std::printf ( "\n" );
+        }
+    }
+
+    // A ring stands in for a glyph, it has both inner and outer edges like an 'o'.
+    static std::vector<uint8_t> MakeRing ( uint32_t aSize )
+    {
+        std::vector<uint8_t> coverage ( size_t{aSize} * aSize );
+        const float center = static_cast<float> ( aSize ) / 2.0f;
+        for ( uint32_t y = 0; y < aSize; ++y )
+        {
+            for ( uint32_t x = 0; x < aSize; ++x )
+            {
+                const float dx = static_cast<float> ( x ) + 0.5f - center;
+                const float dy = static_cast<float> ( y ) + 0.5f - center;
+                const float distance = std::sqrt ( dx * dx + dy * dy );
+                coverage[ ( size_t{y} * aSize ) + x] = ( distance <= center * 0.9f && distance >= center * 0.5f ) ? 255 : 0;
+            }
+        }
+        return coverage;
+    }
+
+    static void BenchmarkDistanceField()
+    {
+        const uint32_t base_size{32};
+        const uint32_t oversample{4};
+        const uint32_t glyphs{95};
+        const std::vector<uint8_t> coverage = MakeRing ( base_size * oversample );
+        DistanceFieldAtlas atlas{1024, 1024, base_size};
+        double seconds = BestSeconds ( 5, [&]()
+        {
+            atlas = DistanceFieldAtlas{1024, 1024, base_size};
+            for ( uint32_t codepoint = U' '; codepoint < U' ' + glyphs; ++codepoint )
+            {
+                atlas.Add ( codepoint, coverage.data(), base_size * oversample, base_size * oversample, base_size * oversample,
+                            0, static_cast<int32_t> ( base_size * oversample ), static_cast<float> ( base_size * oversample ), oversample );
+            }
+        } );
+        std::printf ( "\nDistance field atlas, %u glyphs at base size %u, %ux oversampled coverage\n", glyphs, base_size, oversample );
+        std::printf ( "generation %.3f ms per glyph, one 8 bit atlas serves every size\n", seconds * 1000.0 / glyphs );
+
+        /*  The per size bitmap baseline tints a coverage bitmap rendered at the exact size
+            and blends it with the same compositing kernels, one coverage bitmap per size. */
+        const uint32_t width{1024};
+        const uint32_t height{256};
+        std::vector<Color> target ( size_t{width} * height, Color{0xff000000} );
+        std::u32string text ( 40, U'A' );
+        std::printf ( "%-6s %16s %16s %18s\n", "size", "sdf glyphs/s", "bitmap glyphs/s", "bitmap bytes/size" );
+        for ( uint32_t text_size : {12u, 24u, 48u} )
+        {
+            double sdf = BestSeconds ( 20, [&]()
+            {
+                atlas.DrawText ( text, 0.0f, static_cast<float> ( text_size ), static_cast<float> ( text_size ), Color{0xffffffff},
+                                 target.data(), width * sizeof ( Color ), width, height );
+            } );
+            const std::vector<uint8_t> bitmap = MakeRing ( text_size );
+            std::vector<Color> tinted ( text_size );
+            double blended = BestSeconds ( 20, [&]()
+            {
+                for ( size_t glyph = 0; glyph < text.size(); ++glyph )
+                {
+                    const uint32_t x = static_cast<uint32_t> ( glyph * text_size ) % ( width - text_size );
+                    for ( uint32_t y = 0; y < text_size; ++y )
+                    {
+                        for ( uint32_t i = 0; i < text_size; ++i )
+                        {
+                            tinted[i] = Color{static_cast<uint32_t> ( ( uint32_t{bitmap[ ( size_t{y} * text_size ) + i]} << 24 ) | 0xffffff ) };
+                        }
+                        BlendRow ( tinted.data(), target.data() + ( size_t{y} * width ) + x, text_size, AlphaMode::STRAIGHT );
+                    }
+                }
+            } );
+            std::printf ( "%-6u %16.0f %16.0f %18u\n", text_size, static_cast<double> ( text.size() ) / sdf,
+                          static_cast<double> ( text.size() ) / blended, text_size * text_size * glyphs );
+        }
+    }
+
+    /*  The decoder PCX streaming replaced, kept here as the baseline: RLE bytes are
+        written one at a time with a plane stride, then every pixel is swizzled to BGRA. */
+    static void ReferencePcxDecode ( const uint8_t* aBuffer, uint32_t aWidth, uint32_t aHeight, uint8_t aPlanes, uint16_t aBytesPerLine, Color* aDestination )
+    {
+        const uint32_t scanline_length = aPlanes * aBytesPerLine;
+        std::vector<uint8_t> pixels ( size_t{scanline_length} * aHeight );
+        const uint8_t* byte = aBuffer + 128;
+        for ( uint32_t i = 0; i < aHeight; ++i )
+        {
+            for ( uint8_t j = 0; j < aPlanes; ++j )
+            {
+                uint8_t* pixel = pixels.data() + ( size_t{scanline_length} * i ) + j;
+                for ( uint16_t k = 0; k < aBytesPerLine; )
+                {
+                    if ( ( byte[0] & 0xC0 ) == 0xC0 )
+                    {
+                        uint8_t count = byte[0] & 0x3F;
+                        for ( uint8_t l = 0; l < count; ++l )
+                        {
+                            *pixel = byte[1];
+                            pixel += aPlanes;
+                        }
+                        byte += 2;
+                        k += count;
+                    }
+                    else
+                    {
+                        *pixel = byte[0];
+                        pixel += aPlanes;
+                        ++byte;
+                        ++k;
+                    }
+                }
+            }
+        }
+        for ( size_t i = 0; i < size_t{aWidth} * aHeight; ++i )
+        {
+            aDestination[i].r = pixels[ ( i * 4 ) + 0];
+            aDestination[i].g = pixels[ ( i * 4 ) + 1];
+            aDestination[i].b = pixels[ ( i * 4 ) + 2];
+            aDestination[i].a = pixels[ ( i * 4 ) + 3];
+        }
+    }
+
+    static void CopyRow ( uint32_t aRow, const uint8_t* aBGRA, uint32_t aWidth, void* aUserData )
+    {
+        std::memcpy ( static_cast<Color*> ( aUserData ) + ( size_t{aRow} * aWidth ), aBGRA, sizeof ( Color ) * aWidth );
+    }
+
+    static void BenchmarkPcx()
+    {
+        const uint32_t width{1920};
+        const uint32_t height{1080};
+        // Runs of 8 alternate with literal bytes, roughly what a UI skin with flat areas and gradients encodes to.
+        std::vector<uint8_t> pcx ( 128, 0 );
+        pcx[0] = 0x0A;
+        pcx[1] = 5;
+        pcx[2] = 1;
+        pcx[3] = 8;
+        pcx[8] = static_cast<uint8_t> ( ( width - 1 ) & 0xff );
+        pcx[9] = static_cast<uint8_t> ( ( width - 1 ) >> 8 );
+        pcx[10] = static_cast<uint8_t> ( ( height - 1 ) & 0xff );
+        pcx[11] = static_cast<uint8_t> ( ( height - 1 ) >> 8 );
+        pcx[65] = 4;
+        pcx[66] = static_cast<uint8_t> ( width & 0xff );
+        pcx[67] = static_cast<uint8_t> ( width >> 8 );
+        for ( uint32_t y = 0; y < height; ++y )
+        {
+            for ( uint32_t plane = 0; plane < 4; ++plane )
+            {
+                for ( uint32_t x = 0; x < width; x += 16 )
+                {
+                    pcx.push_back ( 0xC8 );
+                    pcx.push_back ( static_cast<uint8_t> ( y + plane ) );
+                    for ( uint32_t i = 0; i < 8; ++i )
+                    {
+                        pcx.push_back ( static_cast<uint8_t> ( ( x + i ) & 0x7f ) );
+                    }
+                }
+            }
+        }
+        const double megabytes = static_cast<double> ( size_t{width} * height * 4 ) / ( 1024.0 * 1024.0 );
+        std::vector<Color> destination ( size_t{width} * height );
+        double reference = BestSeconds ( 10, [&]()
+        {
+            ReferencePcxDecode ( pcx.data(), width, height, 4, static_cast<uint16_t> ( width ), destination.data() );
+        } );
+        double streamed = BestSeconds ( 10, [&]()
+        {
+            Pcx decoder;
+            decoder.DecodeRows ( static_cast<uint32_t> ( pcx.size() ), pcx.data(), CopyRow, destination.data() );
+        } );
+        double loaded = BestSeconds ( 10, [&]()
+        {
+            Image image;
+            image.LoadFromMemory ( static_cast<uint32_t> ( pcx.size() ), pcx.data() );
+        } );
+        std::printf ( "\nPCX %ux%u RGBA to BGRA, MB/s of decoded pixels\n", width, height );
+        std::printf ( "byte at a time planar decode %10.1f\n", megabytes / reference );
+        std::printf ( "Pcx::DecodeRows              %10.1f\n", megabytes / streamed );
+        std::printf ( "Image::LoadFromMemory        %10.1f (allocates the bitmap, looks for a 9 patch frame)\n", megabytes / loaded );
+    }
+
+#if defined(AEONGUI_TEST_FONT)
+    static void BenchmarkGlyphIndex ( const char* aFontPath )
+    {
+        FT_Library library{};
+        FT_Face face{};
+        if ( FT_Init_FreeType ( &library ) != 0 )
+        {
+            return;
+        }
+        if ( FT_New_Face ( library, aFontPath, 0, &face ) != 0 )
+        {
+            std::printf ( "\nGlyph index: %s is not available, skipped\n", aFontPath );
+            FT_Done_FreeType ( library );
+            return;
+        }
+        const std::u32string_view sample{U"The quick brown fox jumps over the lazy dog, \u00e9\u00e0\u00fc \u20ac"};
+        std::u32string text;
+        for ( size_t i = 0; i < 100000; ++i )
+        {
+            text.push_back ( sample[i % sample.size()] );
+        }
+        GlyphCache cache{256, 256};
+        uint64_t charmap_sum{};
+        uint64_t cache_sum{};
+        double charmap = BestSeconds ( 10, [&]()
+        {
+            for ( char32_t code_point : text )
+            {
+                charmap_sum += FT_Get_Char_Index ( face, code_point );
+            }
+        } );
+        double cached = BestSeconds ( 10, [&]()
+        {
+            for ( char32_t code_point : text )
+            {
+                cache_sum += cache.GetGlyphIndex ( face, code_point );
+            }
+        } );
+        std::printf ( "\nGlyph index lookup, %s, ns per code point\n", aFontPath );
+        std::printf ( "FT_Get_Char_Index         %6.1f\n", charmap * 1e9 / static_cast<double> ( text.size() ) );
+        std::printf ( "GlyphCache::GetGlyphIndex %6.1f%s\n", cached * 1e9 / static_cast<double> ( text.size() ),
+                      ( charmap_sum == cache_sum ) ? "" : " (indices differ)" );
+        FT_Done_Face ( face );
+        FT_Done_FreeType ( library );
+    }
+#endif
+
+#if defined(AEONGUI_USE_DUKTAPE)
+    static void BenchmarkDuktape()
+    {
+        const std::string filename{"aeongui-benchmark.svg"};
+        {
+            std::ofstream file ( filename );
+            file << "<svg xmlns=\"http://www.w3.org/2000/svg\"><g id=\"group\"/></svg>";
+        }
+        Document document{filename};
+        std::remove ( filename.c_str() );
+        const size_t engines{100};
+        double created = BestSeconds ( 5, [&]()
+        {
+            for ( size_t i = 0; i < engines; ++i )
+            {
+                JsDuktape javascript{nullptr, &document};
+            }
+        } );
+        JsDuktape javascript{nullptr, &document};
+        const size_t writes{10000};
+        double written = BestSeconds ( 5, [&]()
+        {
+            javascript.Eval ( "var group = document.getElementById('group');"
+                              "for (var i = 0; i < 10000; ++i) { group.setAttribute('class', 'c' + i); }" );
+            document.ApplyPendingAttributes();
+        } );
+        std::printf ( "\nDuktape backend\n" );
+        std::printf ( "create and destroy %.3f ms per engine with bindings\n", created * 1000.0 / engines );
+        std::printf ( "setAttribute from script %.0f writes/s, batched and applied once\n", writes / written );
+    }
+#endif
+}
+
+int main ( int argc, char** argv )
+{
+    AeonGUI::BenchmarkPixelConversion();
+    AeonGUI::BenchmarkDistanceField();
+    AeonGUI::BenchmarkPcx();
+#if defined(AEONGUI_TEST_FONT)
+    AeonGUI::BenchmarkGlyphIndex ( ( argc > 1 ) ? argv[1] : AEONGUI_TEST_FONT );
+#endif
+#if defined(AEONGUI_USE_DUKTAPE)
+    AeonGUI::BenchmarkDuktape();
+#endif
+    return 0;
+}
@@ -0,0 +1,124 @@
+/*!
+@file
+@author Rodrigo Hernandez
+@copy 2020
+*/
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "aeongui/Color.h"
+#include "dom/Element.h"
+
+using namespace ::testing;
+namespace AeonGUI
+{
+    TEST ( ColorTest, ParsesKeywords )
+    {
+        const std::pair<const char*, uint32_t> keywords[] =
+        {
+            {"aliceblue", aliceblue},
+            {"black", black},
+            {"darkslategrey", darkslategrey},
+            {"lightgoldenrodyellow", lightgoldenrodyellow},
+            {"mediumspringgreen", mediumspringgreen},
+            {"red", red},
+            {"tan", tan},
+            {"transparent", transparent},
+            {"yellowgreen", yellowgreen},
+        };
+        for ( auto& i : keywords )
+        {
+            Color color{0x12345678u};
+            EXPECT_TRUE ( Color::Parse ( i.first, color ) ) << i.first;
+            EXPECT_EQ ( color.bgra, i.second ) << i.first;
+        }
+    }
+
+    TEST ( ColorTest, RejectsNonKeywords )
+    {
+        const char* values[] = {"", "none", "re", "redd", "Red", "aliceblue2", "#", "#12", "#1234", "#12345g", "#123456789"};
+        for ( auto i : values )
+        {
+            Color color{0x12345678u};
+            EXPECT_FALSE ( Color::Parse ( i, color ) ) << i;
+            EXPECT_EQ ( color.bgra, 0x12345678u ) << i;
+        }
+    }
+
+    TEST ( ColorTest, ParsesHexColors )
+    {
+        Color color;
+        ASSERT_TRUE ( Color::Parse ( "#f0A", color ) );
+        EXPECT_EQ ( color.bgra, 0xffff00aau );
+        ASSERT_TRUE ( Color::Parse ( "#12aBcD", color ) );
+        EXPECT_EQ ( color.bgra, 0xff12abcdu );
+        ASSERT_TRUE ( Color::Parse ( "#80102030", color ) );
+        EXPECT_EQ ( color.a, 0x80 );
+        EXPECT_EQ ( color.r, 0x10 );
+        EXPECT_EQ ( color.g, 0x20 );
+        EXPECT_EQ ( color.b, 0x30 );
+    }
+
+    TEST ( ColorTest, StringConstructorIgnoresWhitespace )
+    {
+        EXPECT_EQ ( Color{std::string{"  navy\n"}} .bgra, static_cast<uint32_t> ( navy ) );
+        EXPECT_EQ ( Color{std::string{"\t#00ff00 "}} .bgra, 0xff00ff00u );
+        EXPECT_EQ ( Color{std::string{"nocolor"}} .bgra, 0u );
+    }
+
+    /*  flex is not always available to regenerate style_lexer.cpp,
+        so style.l keeps its own keyword list and these make sure it does not drift from Color::Parse. */
+    TEST ( ColorTest, StyleLexerKeywordsMatchParse )
+    {
+        std::ifstream file{AEONGUI_STYLE_LEXER_SOURCE};
+        ASSERT_TRUE ( file.is_open() ) << AEONGUI_STYLE_LEXER_SOURCE;
+        std::string line;
+        while ( std::getline ( file, line ) && line.compare ( 0, 6, "color " ) != 0 ) {}
+        ASSERT_FALSE ( line.empty() ) << "No color definition in " << AEONGUI_STYLE_LEXER_SOURCE;
+        std::istringstream alternatives{line.substr ( line.find_first_not_of ( " \t", 5 ) ) };
+        std::vector<std::string> lexer_keywords;
+        for ( std::string alternative; std::getline ( alternatives, alternative, '|' ); )
+        {
+            alternative.erase ( alternative.find_last_not_of ( " \t\r" ) + 1 );
+            if ( alternative[0] != '#' )
+            {
+                lexer_keywords.emplace_back ( alternative );
+            }
+        }
+        std::vector<std::string> keywords;
+        Color::EnumerateKeywords ( [&keywords] ( std::string_view aKeyword )
+        {
+            keywords.emplace_back ( aKeyword );
+            return true;
+        } );
+        std::sort ( lexer_keywords.begin(), lexer_keywords.end() );
+        std::sort ( keywords.begin(), keywords.end() );
+        EXPECT_EQ ( lexer_keywords, keywords );
+    }
+
+    TEST ( ColorTest, StyleAttributeParsesEveryKeyword )
+    {
+        Color::EnumerateKeywords ( [] ( std::string_view aKeyword )
+        {
+            const std::string keyword{aKeyword};
+            Element element{"g", AttributeMap{{"style", std::string{"fill:"} + keyword}}};
+            AttributeType fill = element.GetAttribute ( "fill" );
+            Color color;
+            EXPECT_TRUE ( Color::Parse ( aKeyword, color ) ) << keyword;
+            EXPECT_TRUE ( std::holds_alternative<ColorAttr> ( fill ) ) << keyword;
+            if ( std::holds_alternative<ColorAttr> ( fill ) )
+            {
+                const ColorAttr& color_attr = std::get<ColorAttr> ( fill );
+                EXPECT_TRUE ( std::holds_alternative<Color> ( color_attr ) ) << keyword;
+                if ( std::holds_alternative<Color> ( color_attr ) )
+                {
+                    EXPECT_EQ ( std::get<Color> ( color_attr ).bgra, color.bgra ) << keyword;
+                }
+            }
+            return true;
+        } );
+    }
+}
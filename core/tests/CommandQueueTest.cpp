@@ -0,0 +1,81 @@
+/*!
+@file
+@author Rodrigo Hernandez
+@copy 2020
+*/
+#include <thread>
+#include <vector>
+#include <memory>
+#include "gtest/gtest.h"
+#include "aeongui/CommandQueue.h"
+
+using namespace ::testing;
+namespace AeonGUI
+{
+    TEST ( CommandQueueTest, PopsInPushOrder )
+    {
+        CommandQueue<int> queue;
+        EXPECT_TRUE ( queue.Empty() );
+        EXPECT_FALSE ( queue.Pop().has_value() );
+        for ( int i = 0; i < 5; ++i )
+        {
+            queue.Push ( int{i} );
+        }
+        EXPECT_FALSE ( queue.Empty() );
+        for ( int i = 0; i < 5; ++i )
+        {
+            std::optional<int> value = queue.Pop();
+            ASSERT_TRUE ( value.has_value() );
+            EXPECT_EQ ( *value, i );
+        }
+        EXPECT_TRUE ( queue.Empty() );
+    }
+
+    TEST ( CommandQueueTest, ReleasesUnpoppedValues )
+    {
+        auto value = std::make_shared<int> ( 42 );
+        {
+            CommandQueue<std::shared_ptr<int>> queue;
+            queue.Push ( std::shared_ptr<int> {value} );
+            queue.Push ( std::shared_ptr<int> {value} );
+            EXPECT_EQ ( value.use_count(), 3 );
+            queue.Pop();
+            EXPECT_EQ ( value.use_count(), 2 );
+        }
+        EXPECT_EQ ( value.use_count(), 1 );
+    }
+
+    TEST ( CommandQueueTest, KeepsOrderOfEachProducer )
+    {
+        constexpr int producer_count{4};
+        constexpr int push_count{10000};
+        CommandQueue<std::pair<int, int>> queue;
+        std::vector<std::thread> producers;
+        for ( int producer = 0; producer < producer_count; ++producer )
+        {
+            producers.emplace_back ( [&queue, producer]()
+            {
+                for ( int i = 0; i < push_count; ++i )
+                {
+                    queue.Push ( std::pair<int, int> {producer, i} );
+                }
+            } );
+        }
+        std::vector<int> next ( producer_count, 0 );
+        int popped{0};
+        while ( popped < producer_count * push_count )
+        {
+            if ( std::optional<std::pair<int, int>> value = queue.Pop() )
+            {
+                ASSERT_EQ ( value->second, next[value->first] );
+                ++next[value->first];
+                ++popped;
+            }
+        }
+        for ( auto& producer : producers )
+        {
+            producer.join();
+        }
+        EXPECT_TRUE ( queue.Empty() );
+    }
+}
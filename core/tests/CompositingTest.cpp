@@ -0,0 +1,138 @@
+/*!
+@file
+@author Rodrigo Hernandez
+@copy 2020
+*/
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "aeongui/Compositing.h"
+
+using namespace ::testing;
+namespace AeonGUI
+{
+    static uint8_t Div255 ( uint32_t x )
+    {
+        return static_cast<uint8_t> ( ( x + 128 + ( ( x + 128 ) >> 8 ) ) >> 8 );
+    }
+
+    static Color ReferenceBlend ( Color aSource, Color aDestination, AlphaMode aMode, uint8_t aOpacity )
+    {
+        Color result;
+        if ( aMode == AlphaMode::STRAIGHT )
+        {
+            const uint32_t alpha = Div255 ( aSource.a * aOpacity );
+            result.b = Div255 ( aSource.b * alpha + aDestination.b * ( 255 - alpha ) );
+            result.g = Div255 ( aSource.g * alpha + aDestination.g * ( 255 - alpha ) );
+            result.r = Div255 ( aSource.r * alpha + aDestination.r * ( 255 - alpha ) );
+            result.a = Div255 ( 255 * alpha + aDestination.a * ( 255 - alpha ) );
+            return result;
+        }
+        const uint8_t b = Div255 ( aSource.b * aOpacity );
+        const uint8_t g = Div255 ( aSource.g * aOpacity );
+        const uint8_t r = Div255 ( aSource.r * aOpacity );
+        const uint8_t a = Div255 ( aSource.a * aOpacity );
+        result.b = static_cast<uint8_t> ( std::min<uint32_t> ( 255, b + Div255 ( aDestination.b * ( 255 - a ) ) ) );
+        result.g = static_cast<uint8_t> ( std::min<uint32_t> ( 255, g + Div255 ( aDestination.g * ( 255 - a ) ) ) );
+        result.r = static_cast<uint8_t> ( std::min<uint32_t> ( 255, r + Div255 ( aDestination.r * ( 255 - a ) ) ) );
+        result.a = static_cast<uint8_t> ( std::min<uint32_t> ( 255, a + Div255 ( aDestination.a * ( 255 - a ) ) ) );
+        return result;
+    }
+
+    // Mixes random pixels with runs of fully transparent and fully opaque ones to hit the kernel shortcuts.
+    static std::vector<Color> MakePixels ( size_t aCount, std::mt19937& aRandom, AlphaMode aMode )
+    {
+        std::vector<Color> pixels ( aCount );
+        for ( size_t i = 0; i < aCount; ++i )
+        {
+            Color& color = pixels[i];
+            color.bgra = aRandom();
+            switch ( ( i / 8 ) % 4 )
+            {
+            case 0:
+                color.a = 0;
+                break;
+            case 1:
+                color.a = 255;
+                break;
+            default:
+                break;
+            }
+            if ( aMode == AlphaMode::PREMULTIPLIED )
+            {
+                color.b = std::min ( color.b, color.a );
+                color.g = std::min ( color.g, color.a );
+                color.r = std::min ( color.r, color.a );
+            }
+        }
+        return pixels;
+    }
+
+    TEST ( CompositingTest, BlendRowMatchesReference )
+    {
+        std::mt19937 random{1234};
+        for ( AlphaMode mode : {AlphaMode::STRAIGHT, AlphaMode::PREMULTIPLIED} )
+        {
+            for ( uint8_t opacity : {255, 128, 1} )
+            {
+                for ( size_t count : {1u, 3u, 4u, 7u, 8u, 9u, 31u, 64u, 101u} )
+                {
+                    std::vector<Color> source = MakePixels ( count, random, mode );
+                    std::vector<Color> destination = MakePixels ( count, random, mode );
+                    std::vector<Color> expected ( count );
+                    for ( size_t i = 0; i < count; ++i )
+                    {
+                        expected[i] = ReferenceBlend ( source[i], destination[i], mode, opacity );
+                    }
+                    BlendRow ( source.data(), destination.data(), count, mode, opacity );
+                    for ( size_t i = 0; i < count; ++i )
+                    {
+                        EXPECT_EQ ( destination[i].bgra, expected[i].bgra ) << "pixel " << i << " of " << count;
+                    }
+                }
+            }
+        }
+    }
+
+    TEST ( CompositingTest, BlendHonorsPitch )
+    {
+        std::mt19937 random{42};
+        const uint32_t width = 13;
+        const uint32_t height = 3;
+        const uint32_t destination_width = 20;
+        std::vector<Color> source = MakePixels ( width * height, random, AlphaMode::STRAIGHT );
+        std::vector<Color> destination = MakePixels ( destination_width * height, random, AlphaMode::STRAIGHT );
+        std::vector<Color> expected{destination};
+        for ( uint32_t y = 0; y < height; ++y )
+        {
+            for ( uint32_t x = 0; x < width; ++x )
+            {
+                expected[y * destination_width + x + 2] = ReferenceBlend ( source[y * width + x], destination[y * destination_width + x + 2], AlphaMode::STRAIGHT, 255 );
+            }
+        }
+        Blend ( source.data(), width * sizeof ( Color ), destination.data() + 2, destination_width * sizeof ( Color ), width, height, AlphaMode::STRAIGHT );
+        for ( size_t i = 0; i < destination.size(); ++i )
+        {
+            EXPECT_EQ ( destination[i].bgra, expected[i].bgra ) << "pixel " << i;
+        }
+    }
+
+    TEST ( CompositingTest, FillSolidColor )
+    {
+        std::vector<Color> destination ( 100, Color{0xff102030} );
+        Fill ( Color{0xffa0b0c0}, destination.data(), 10 * sizeof ( Color ), 10, 10, AlphaMode::STRAIGHT );
+        EXPECT_TRUE ( std::all_of ( destination.begin(), destination.end(), [] ( const Color & color )
+        {
+            return color.bgra == 0xffa0b0c0;
+        } ) );
+        const Color translucent{0x80ffffff};
+        const Color expected = ReferenceBlend ( translucent, Color{0xffa0b0c0}, AlphaMode::STRAIGHT, 255 );
+        Fill ( translucent, destination.data(), 10 * sizeof ( Color ), 10, 10, AlphaMode::STRAIGHT );
+        for ( auto& i : destination )
+        {
+            EXPECT_EQ ( i.bgra, expected.bgra );
+        }
+    }
+}
@@ -0,0 +1,83 @@
+/*!
+@file
+@author Rodrigo Hernandez
+@copy 2020
+*/
+#include <atomic>
+#include <fstream>
+#include <string>
+#include <thread>
+#include "gtest/gtest.h"
+#include "aeongui/Document.h"
+#include "dom/Element.h"
+#include "DOMBridge.h"
+
+using namespace ::testing;
+namespace AeonGUI
+{
+    class DOMBridgeTest : public Test
+    {
+    protected:
+        void SetUp() override
+        {
+            mFilename = TempDir() + "aeongui-dombridge-test.svg";
+            std::ofstream file ( mFilename );
+            file << "<svg xmlns=\"http://www.w3.org/2000/svg\"><g id=\"group\"><g id=\"child\"/></g></svg>";
+        }
+        void TearDown() override
+        {
+            std::remove ( mFilename.c_str() );
+        }
+        std::string mFilename;
+    };
+
+    TEST_F ( DOMBridgeTest, QueuedCallsRunOnDocumentThread )
+    {
+        Document document{mFilename};
+        QueuedDOMBridge bridge{&document};
+        std::atomic<bool> done{false};
+        Element* found{};
+        AttributeType read_back{};
+        std::thread script ( [&]()
+        {
+            found = bridge.GetElementById ( "group" );
+            bridge.SetAttribute ( found, "opacity", "0.5" );
+            read_back = bridge.GetAttribute ( found, "opacity" );
+            done = true;
+        } );
+        while ( !done )
+        {
+            bridge.ProcessCommands();
+            std::this_thread::yield();
+        }
+        script.join();
+        EXPECT_EQ ( found, document.getElementById ( "group" ) );
+        // The write is still pending in the document, the read returns its unparsed value.
+        ASSERT_TRUE ( std::holds_alternative<std::string> ( read_back ) );
+        EXPECT_EQ ( std::get<std::string> ( read_back ), "0.5" );
+        EXPECT_FALSE ( bridge.HasPendingCommands() );
+        document.ApplyPendingAttributes();
+        ASSERT_TRUE ( std::holds_alternative<double> ( found->GetAttribute ( "opacity" ) ) );
+        EXPECT_EQ ( std::get<double> ( found->GetAttribute ( "opacity" ) ), 0.5 );
+    }
+
+    TEST_F ( DOMBridgeTest, AppendChildRejectsCycles )
+    {
+        Document document{mFilename};
+        DirectDOMBridge bridge{&document};
+        Element* group = document.getElementById ( "group" );
+        Element* child = document.getElementById ( "child" );
+        ASSERT_NE ( group, nullptr );
+        ASSERT_NE ( child, nullptr );
+        Node* root = group->parentNode();
+        bridge.AppendChild ( child, group );
+        bridge.AppendChild ( group, group );
+        EXPECT_EQ ( group->parentNode(), root );
+        EXPECT_EQ ( child->parentNode(), group );
+        EXPECT_EQ ( group->ownerDocument(), &document );
+        // Moving a descendant up past its parent is not a cycle.
+        bridge.AppendChild ( static_cast<Element*> ( document.documentElement() ), child );
+        EXPECT_EQ ( child->parentNode(), root );
+        EXPECT_TRUE ( group->childNodes().empty() );
+    }
+}
@@ -0,0 +1,74 @@
+/*!
+@file
+@author Rodrigo Hernandez
+@copy 2020
+*/
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "gtest/gtest.h"
+#include "aeongui/DistanceField.h"
+
+using namespace ::testing;
+namespace AeonGUI
+{
+    static std::vector<uint8_t> MakeDisc ( uint32_t aSize, float aRadius )
+    {
+        std::vector<uint8_t> coverage ( aSize * aSize );
+        const float center = static_cast<float> ( aSize ) / 2.0f;
+        for ( uint32_t y = 0; y < aSize; ++y )
+        {
+            for ( uint32_t x = 0; x < aSize; ++x )
+            {
+                const float dx = static_cast<float> ( x ) + 0.5f - center;
+                const float dy = static_cast<float> ( y ) + 0.5f - center;
+                coverage[y * aSize + x] = ( std::sqrt ( dx * dx + dy * dy ) <= aRadius ) ? 255 : 0;
+            }
+        }
+        return coverage;
+    }
+
+    TEST ( DistanceFieldTest, FieldTracksDistanceToOutline )
+    {
+        const uint32_t oversample = 4;
+        const uint32_t size = 32;
+        const float spread = 4.0f;
+        const std::vector<uint8_t> coverage = MakeDisc ( size * oversample, 10.0f * oversample );
+        std::vector<uint8_t> field ( size * size );
+        GenerateDistanceField ( coverage.data(), size * oversample, field.data(), size, size, size, oversample, spread );
+        for ( uint32_t y = 0; y < size; ++y )
+        {
+            for ( uint32_t x = 0; x < size; ++x )
+            {
+                const float dx = static_cast<float> ( x ) + 0.5f - 16.0f;
+                const float dy = static_cast<float> ( y ) + 0.5f - 16.0f;
+                const float distance = 10.0f - std::sqrt ( dx * dx + dy * dy );
+                const float expected = std::clamp ( 128.0f + distance * 127.0f / spread, 0.0f, 255.0f );
+                EXPECT_NEAR ( field[y * size + x], expected, 4.0f ) << x << "," << y;
+            }
+        }
+    }
+
+    TEST ( DistanceFieldTest, DrawsAtAnySize )
+    {
+        const uint32_t oversample = 4;
+        const std::vector<uint8_t> coverage = MakeDisc ( 16 * oversample, 8.0f * oversample );
+        DistanceFieldAtlas atlas{64, 64, 16, 4};
+        ASSERT_TRUE ( atlas.Add ( U'o', coverage.data(), 16 * oversample, 16 * oversample, 16 * oversample, 0, 16 * oversample, 18.0f * oversample, oversample ) );
+        ASSERT_EQ ( atlas.GetGlyph ( U'x' ), nullptr );
+        for ( float text_size : {8.0f, 16.0f, 40.0f} )
+        {
+            const uint32_t width = 64;
+            std::vector<Color> target ( width * width, Color{0xff000000} );
+            const float pen = atlas.DrawText ( U"o", 4.0f, 4.0f + text_size, text_size, Color{0xffffffff}, target.data(), width * sizeof ( Color ), width, width );
+            EXPECT_FLOAT_EQ ( pen, 4.0f + 18.0f * text_size / 16.0f );
+            const uint32_t center = 4 + static_cast<uint32_t> ( text_size / 2.0f );
+            const uint32_t radius = static_cast<uint32_t> ( text_size / 2.0f );
+            // Center of the disc is lit, points well outside stay dark.
+            EXPECT_EQ ( target[center * width + center].r, 255 ) << text_size;
+            EXPECT_EQ ( target[center * width + center + radius + 2].r, 0 ) << text_size;
+            EXPECT_EQ ( target[ ( center + radius + 2 ) * width + center].r, 0 ) << text_size;
+            EXPECT_EQ ( target[2 * width + 2].r, 0 ) << text_size;
+        }
+    }
+}
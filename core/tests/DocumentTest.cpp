@@ -0,0 +1,172 @@
+/*!
+@file
+@author Rodrigo Hernandez
+@copy 2020
+*/
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include "gtest/gtest.h"
+#include "aeongui/Document.h"
+#include "dom/Element.h"
+
+using namespace ::testing;
+namespace AeonGUI
+{
+    class DocumentTest : public Test
+    {
+    protected:
+        void SetUp() override
+        {
+            mFilename = TempDir() + "aeongui-document-test.svg";
+            std::ofstream file ( mFilename );
+            file << "<svg xmlns=\"http://www.w3.org/2000/svg\" id=\"root\">"
+                 "<g id=\"group\"><g id=\"twin\"/></g>"
+                 "<g id=\"twin\"/>"
+                 "<g id=\"red\"/><g id=\"1\"/>"
+                 "</svg>";
+        }
+        void TearDown() override
+        {
+            std::remove ( mFilename.c_str() );
+        }
+        std::string mFilename;
+    };
+
+    TEST_F ( DocumentTest, GetElementByIdUsesIndex )
+    {
+        Document document{mFilename};
+        ASSERT_NE ( document.getElementById ( "root" ), nullptr );
+        EXPECT_EQ ( document.getElementById ( "root" ), reinterpret_cast<Element*> ( document.documentElement() ) );
+        EXPECT_EQ ( document.getElementById ( "missing" ), nullptr );
+        Element* group = document.getElementById ( "group" );
+        ASSERT_NE ( group, nullptr );
+        EXPECT_EQ ( group->ownerDocument(), &document );
+        // Duplicated ids resolve to the first one in tree order.
+        Element* twin = document.getElementById ( "twin" );
+        ASSERT_NE ( twin, nullptr );
+        EXPECT_EQ ( twin->parentNode(), group );
+    }
+
+    TEST_F ( DocumentTest, RemovedElementsLeaveIndex )
+    {
+        Document document{mFilename};
+        Element* group = document.getElementById ( "group" );
+        ASSERT_NE ( group, nullptr );
+        Element* nested_twin = document.getElementById ( "twin" );
+        document.documentElement()->RemoveNode ( group );
+        EXPECT_EQ ( document.getElementById ( "group" ), nullptr );
+        EXPECT_EQ ( group->ownerDocument(), nullptr );
+        EXPECT_EQ ( nested_twin->ownerDocument(), nullptr );
+        Element* twin = document.getElementById ( "twin" );
+        ASSERT_NE ( twin, nullptr );
+        EXPECT_NE ( twin, nested_twin );
+        delete nested_twin;
+        delete group;
+    }
+
+    TEST_F ( DocumentTest, QueuedAttributesApplyInOrder )
+    {
+        Document document{mFilename};
+        Element* group = document.getElementById ( "group" );
+        ASSERT_NE ( group, nullptr );
+        document.QueueAttribute ( group, "opacity", "0.25" );
+        document.QueueAttribute ( group, "opacity", "0.5" );
+        ASSERT_NE ( document.GetPendingAttribute ( group, "opacity" ), nullptr );
+        EXPECT_EQ ( *document.GetPendingAttribute ( group, "opacity" ), "0.5" );
+        EXPECT_TRUE ( std::holds_alternative<std::monostate> ( group->GetAttribute ( "opacity" ) ) );
+        document.ApplyPendingAttributes();
+        EXPECT_EQ ( document.GetPendingAttribute ( group, "opacity" ), nullptr );
+        ASSERT_TRUE ( std::holds_alternative<double> ( group->GetAttribute ( "opacity" ) ) );
+        EXPECT_EQ ( std::get<double> ( group->GetAttribute ( "opacity" ) ), 0.5 );
+    }
+
+    TEST_F ( DocumentTest, RemovedElementsDropTheirQueuedAttributes )
+    {
+        Document document{mFilename};
+        Element* group = document.getElementById ( "group" );
+        Element* red = document.getElementById ( "red" );
+        ASSERT_NE ( group, nullptr );
+        ASSERT_NE ( red, nullptr );
+        document.QueueAttribute ( red, "opacity", "0.25" );
+        document.QueueAttribute ( group, "opacity", "0.75" );
+        document.documentElement()->RemoveNode ( red );
+        EXPECT_EQ ( document.GetPendingAttribute ( red, "opacity" ), nullptr );
+        ASSERT_NE ( document.GetPendingAttribute ( group, "opacity" ), nullptr );
+        EXPECT_EQ ( *document.GetPendingAttribute ( group, "opacity" ), "0.75" );
+        document.ApplyPendingAttributes();
+        EXPECT_TRUE ( std::holds_alternative<std::monostate> ( red->GetAttribute ( "opacity" ) ) );
+        EXPECT_EQ ( std::get<double> ( group->GetAttribute ( "opacity" ) ), 0.75 );
+        delete red;
+    }
+
+    TEST_F ( DocumentTest, CreatedElementsAreSVGOnly )
+    {
+        Document document{mFilename};
+        EXPECT_EQ ( document.createElementNS ( "http://www.w3.org/1999/xhtml", "div" ), nullptr );
+        Element* rect = document.createElementNS ( "http://www.w3.org/2000/svg", "rect" );
+        ASSERT_NE ( rect, nullptr );
+        EXPECT_EQ ( rect->tagName(), "rect" );
+        EXPECT_EQ ( rect->ownerDocument(), nullptr );
+    }
+
+    TEST_F ( DocumentTest, CreatedElementsAreDeletedWithTheDocument )
+    {
+        // Run under a leak checker, none of these may outlive the document.
+        Document document{mFilename};
+        Element* detached = document.createElementNS ( "http://www.w3.org/2000/svg", "g" );
+        Element* nested = document.createElementNS ( "http://www.w3.org/2000/svg", "rect" );
+        Element* attached = document.createElementNS ( "http://www.w3.org/2000/svg", "g" );
+        ASSERT_NE ( detached, nullptr );
+        ASSERT_NE ( nested, nullptr );
+        ASSERT_NE ( attached, nullptr );
+        detached->AddNode ( nested );
+        document.getElementById ( "group" )->AddNode ( attached );
+        EXPECT_EQ ( attached->ownerDocument(), &document );
+        EXPECT_EQ ( nested->parentNode(), detached );
+    }
+
+    TEST_F ( DocumentTest, ChangingIdReindexes )
+    {
+        Document document{mFilename};
+        Element* group = document.getElementById ( "group" );
+        ASSERT_NE ( group, nullptr );
+        document.QueueAttribute ( group, "id", "renamed" );
+        document.ApplyPendingAttributes();
+        EXPECT_EQ ( document.getElementById ( "group" ), nullptr );
+        EXPECT_EQ ( document.getElementById ( "renamed" ), group );
+    }
+
+    TEST_F ( DocumentTest, IdsThatLookLikeValuesAreStrings )
+    {
+        Document document{mFilename};
+        for ( const char* id : {"red", "1"} )
+        {
+            Element* element = document.getElementById ( id );
+            ASSERT_NE ( element, nullptr ) << id;
+            AttributeType attribute = element->GetAttribute ( "id" );
+            ASSERT_TRUE ( std::holds_alternative<std::string> ( attribute ) ) << id;
+            EXPECT_EQ ( std::get<std::string> ( attribute ), id );
+        }
+        EXPECT_TRUE ( std::holds_alternative<std::string> ( ParseAttributeValue ( "id", "#fff" ) ) );
+    }
+
+    TEST ( AttributeParsingTest, ColorsOnlyForColorAttributes )
+    {
+        EXPECT_TRUE ( std::holds_alternative<ColorAttr> ( ParseAttributeValue ( "fill", "red" ) ) );
+        EXPECT_TRUE ( std::holds_alternative<ColorAttr> ( ParseAttributeValue ( "stop-color", "#ff0000" ) ) );
+        AttributeType none = ParseAttributeValue ( "stroke", "none" );
+        ASSERT_TRUE ( std::holds_alternative<ColorAttr> ( none ) );
+        EXPECT_TRUE ( std::holds_alternative<std::monostate> ( std::get<ColorAttr> ( none ) ) );
+        EXPECT_TRUE ( std::holds_alternative<double> ( ParseAttributeValue ( "opacity", "0.5" ) ) );
+        for ( const char* name : {"class", "font-family", "gradientUnits", "href"} )
+        {
+            for ( const char* value : {"red", "gold", "none", "#fff"} )
+            {
+                AttributeType attribute = ParseAttributeValue ( name, value );
+                ASSERT_TRUE ( std::holds_alternative<std::string> ( attribute ) ) << name << "=" << value;
+                EXPECT_EQ ( std::get<std::string> ( attribute ), value );
+            }
+        }
+    }
+}
@@ -0,0 +1,145 @@
+/*!
+@file
+@author Rodrigo Hernandez
+@copy 2020
+*/
+#include <vector>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include "gtest/gtest.h"
+#include "aeongui/GlyphCache.h"
+
+using namespace ::testing;
+namespace AeonGUI
+{
+    class GlyphCacheTest : public Test
+    {
+    protected:
+        void SetUp() override
+        {
+            ASSERT_EQ ( FT_Init_FreeType ( &mLibrary ), 0 );
+            if ( FT_New_Face ( mLibrary, AEONGUI_TEST_FONT, 0, &mFace ) != 0 )
+            {
+                mFace = nullptr;
+                GTEST_SKIP() << "Test font " << AEONGUI_TEST_FONT << " is not available.";
+            }
+        }
+        void TearDown() override
+        {
+            if ( mFace != nullptr )
+            {
+                FT_Done_Face ( mFace );
+            }
+            FT_Done_FreeType ( mLibrary );
+        }
+        FT_Library mLibrary{};
+        FT_Face mFace{};
+    };
+
+    TEST_F ( GlyphCacheTest, GlyphIndexMatchesCharmap )
+    {
+        GlyphCache cache{256, 256};
+        for ( char32_t code_point : {U'A', U'z', U'0', U' ', U'\u00e9', U'\u20ac'} )
+        {
+            EXPECT_EQ ( cache.GetGlyphIndex ( mFace, code_point ), FT_Get_Char_Index ( mFace, code_point ) );
+        }
+        EXPECT_NE ( cache.GetGlyphIndex ( mFace, U'A' ), 0u );
+        // Repeated lookups are served from the memoized page.
+        EXPECT_EQ ( cache.GetGlyphIndex ( mFace, U'A' ), FT_Get_Char_Index ( mFace, U'A' ) );
+    }
+
+    TEST_F ( GlyphCacheTest, GlyphIndexIsZeroForMissingCodePoints )
+    {
+        GlyphCache cache{256, 256};
+        // Private use and astral code points the face has no glyph for.
+        EXPECT_EQ ( cache.GetGlyphIndex ( mFace, U'\ue000' ), 0u );
+        EXPECT_EQ ( cache.GetGlyphIndex ( mFace, U'\U0001f600' ), 0u );
+        EXPECT_EQ ( cache.GetGlyphIndex ( mFace, U'\U0001f600' ), 0u );
+    }
+
+    TEST_F ( GlyphCacheTest, ClearDropsGlyphIndex )
+    {
+        GlyphCache cache{256, 256};
+        const uint32_t index = cache.GetGlyphIndex ( mFace, U'A' );
+        cache.Clear();
+        EXPECT_EQ ( cache.GetGlyphIndex ( mFace, U'A' ), index );
+    }
+
+    TEST_F ( GlyphCacheTest, SecondRequestIsAHit )
+    {
+        GlyphCache cache{256, 256};
+        const uint32_t index = cache.GetGlyphIndex ( mFace, U'A' );
+        const GlyphCache::Glyph* glyph = cache.Get ( mFace, 16, index );
+        ASSERT_NE ( glyph, nullptr );
+        EXPECT_GT ( glyph->region.GetWidth(), 0u );
+        EXPECT_GT ( glyph->advance, 0.0f );
+        EXPECT_EQ ( cache.Get ( mFace, 16, index ), glyph );
+        EXPECT_EQ ( cache.GetMisses(), 1u );
+        EXPECT_EQ ( cache.GetHits(), 1u );
+        // The rasterized coverage is copied into the atlas.
+        const uint8_t* bitmap = cache.GetBitmap();
+        uint32_t coverage = 0;
+        for ( uint32_t y = 0; y < glyph->region.GetHeight(); ++y )
+        {
+            for ( uint32_t x = 0; x < glyph->region.GetWidth(); ++x )
+            {
+                coverage += bitmap[ ( ( glyph->region.GetY() + y ) * cache.GetWidth() ) + glyph->region.GetX() + x];
+            }
+        }
+        EXPECT_GT ( coverage, 0u );
+    }
+
+    TEST_F ( GlyphCacheTest, SizeAndSubpixelOffsetAreMisses )
+    {
+        GlyphCache cache{256, 256, 4};
+        const uint32_t index = cache.GetGlyphIndex ( mFace, U'A' );
+        ASSERT_NE ( cache.Get ( mFace, 16, index, 0.0f ), nullptr );
+        ASSERT_NE ( cache.Get ( mFace, 16, index, 0.5f ), nullptr );
+        ASSERT_NE ( cache.Get ( mFace, 20, index, 0.0f ), nullptr );
+        // Offsets quantize to the same subpixel step, integer parts are ignored.
+        ASSERT_NE ( cache.Get ( mFace, 16, index, 2.1f ), nullptr );
+        EXPECT_EQ ( cache.GetMisses(), 3u );
+        EXPECT_EQ ( cache.GetHits(), 1u );
+        EXPECT_EQ ( cache.GetGlyphCount(), 3u );
+    }
+
+    TEST_F ( GlyphCacheTest, EvictsGlyphsFromPreviousFrames )
+    {
+        GlyphCache cache{32, 32};
+        const uint32_t first = cache.GetGlyphIndex ( mFace, U'W' );
+        ASSERT_NE ( cache.Get ( mFace, 24, first ), nullptr );
+        for ( char32_t code_point = U'A'; code_point <= U'Z'; ++code_point )
+        {
+            cache.BeginFrame();
+            EXPECT_NE ( cache.Get ( mFace, 24, cache.GetGlyphIndex ( mFace, code_point ) ), nullptr );
+        }
+        EXPECT_GT ( cache.GetEvictions(), 0u );
+        const size_t misses = cache.GetMisses();
+        cache.BeginFrame();
+        ASSERT_NE ( cache.Get ( mFace, 24, first ), nullptr );
+        EXPECT_EQ ( cache.GetMisses(), misses + 1 );
+    }
+
+    TEST_F ( GlyphCacheTest, FullAtlasKeepsGlyphsOfTheCurrentFrame )
+    {
+        GlyphCache cache{32, 32};
+        std::vector<const GlyphCache::Glyph*> glyphs;
+        bool full = false;
+        for ( char32_t code_point = U'A'; code_point <= U'Z' && !full; ++code_point )
+        {
+            const GlyphCache::Glyph* glyph = cache.Get ( mFace, 24, cache.GetGlyphIndex ( mFace, code_point ) );
+            full = ( glyph == nullptr );
+            if ( !full )
+            {
+                glyphs.push_back ( glyph );
+            }
+        }
+        ASSERT_TRUE ( full );
+        EXPECT_FALSE ( glyphs.empty() );
+        EXPECT_EQ ( cache.GetEvictions(), 0u );
+        EXPECT_EQ ( cache.GetGlyphCount(), glyphs.size() );
+        // A glyph larger than the whole atlas never fits.
+        cache.BeginFrame();
+        EXPECT_EQ ( cache.Get ( mFace, 64, cache.GetGlyphIndex ( mFace, U'W' ) ), nullptr );
+    }
+}
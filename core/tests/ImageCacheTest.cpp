@@ -0,0 +1,110 @@
+/*!
+@file
+@author Rodrigo Hernandez
+@copy 2020
+*/
+#include <cstdint>
+#include <vector>
+#include "gtest/gtest.h"
+#include "ImageCache.h"
+
+using namespace ::testing;
+namespace AeonGUI
+{
+    // 4x4 BGRA images, 64 bytes each once decoded.
+    static const size_t ImageBytes = 4 * 4 * sizeof ( Color );
+    static const std::vector<uint8_t> Pixels ( ImageBytes, 0x40 );
+
+    static ImageCache::Handle Get ( ImageCache& aCache, const char* aName )
+    {
+        return aCache.GetFromResource ( aName, 4, 4, Image::BGRA, Pixels.data() );
+    }
+
+    TEST ( ImageCacheTest, HitsReturnTheSameImage )
+    {
+        ImageCache cache;
+        ImageCache::Handle first = Get ( cache, "a" );
+        ImageCache::Handle second = Get ( cache, "a" );
+        ASSERT_NE ( first, nullptr );
+        EXPECT_EQ ( first.get(), second.get() );
+        ImageCache::Statistics statistics = cache.GetStatistics();
+        EXPECT_EQ ( statistics.misses, 1u );
+        EXPECT_EQ ( statistics.hits, 1u );
+        EXPECT_EQ ( statistics.entries, 1u );
+        EXPECT_EQ ( statistics.bytes, ImageBytes );
+    }
+
+    TEST ( ImageCacheTest, EvictsLeastRecentlyUsedFirst )
+    {
+        ImageCache cache ( ImageBytes * 2 );
+        const Image* a = Get ( cache, "a" ).get();
+        Get ( cache, "b" );
+        // Touching a makes b the least recently used entry.
+        EXPECT_EQ ( Get ( cache, "a" ).get(), a );
+        Get ( cache, "c" );
+        ImageCache::Statistics statistics = cache.GetStatistics();
+        EXPECT_EQ ( statistics.evictions, 1u );
+        EXPECT_EQ ( statistics.entries, 2u );
+        EXPECT_EQ ( statistics.bytes, ImageBytes * 2 );
+        EXPECT_EQ ( Get ( cache, "a" ).get(), a );
+        EXPECT_EQ ( cache.GetStatistics().hits, 2u );
+        Get ( cache, "b" );
+        EXPECT_EQ ( cache.GetStatistics().misses, 4u );
+    }
+
+    TEST ( ImageCacheTest, ReleasingTheLastHandleTrimsTheCache )
+    {
+        ImageCache cache ( ImageBytes );
+        ImageCache::Handle a = Get ( cache, "a" );
+        ImageCache::Handle also_a = Get ( cache, "a" );
+        ImageCache::Handle b = Get ( cache, "b" );
+        // Both images are in use, so the cache stays over budget.
+        EXPECT_EQ ( cache.GetStatistics().bytes, ImageBytes * 2 );
+        a.reset();
+        EXPECT_EQ ( cache.GetStatistics().entries, 2u );
+        also_a.reset();
+        ImageCache::Statistics statistics = cache.GetStatistics();
+        EXPECT_EQ ( statistics.entries, 1u );
+        EXPECT_EQ ( statistics.bytes, ImageBytes );
+        EXPECT_EQ ( statistics.evictions, 1u );
+        b.reset();
+        EXPECT_EQ ( cache.GetStatistics().entries, 1u );
+    }
+
+    TEST ( ImageCacheTest, LoweringTheBudgetEvicts )
+    {
+        ImageCache cache;
+        Get ( cache, "a" );
+        ImageCache::Handle b = Get ( cache, "b" );
+        Get ( cache, "c" );
+        cache.SetBudget ( ImageBytes );
+        EXPECT_EQ ( cache.GetBudget(), ImageBytes );
+        ImageCache::Statistics statistics = cache.GetStatistics();
+        EXPECT_EQ ( statistics.entries, 1u );
+        EXPECT_EQ ( statistics.evictions, 2u );
+        EXPECT_EQ ( Get ( cache, "b" ).get(), b.get() );
+        b.reset();
+        cache.Purge();
+        EXPECT_EQ ( cache.GetStatistics().entries, 0u );
+        EXPECT_EQ ( cache.GetStatistics().bytes, 0u );
+    }
+
+    TEST ( ImageCacheTest, HandlesOutliveTheCache )
+    {
+        ImageCache::Handle image;
+        {
+            ImageCache cache;
+            image = Get ( cache, "a" );
+        }
+        ASSERT_NE ( image, nullptr );
+        EXPECT_EQ ( image->GetWidth(), 4 );
+        EXPECT_EQ ( image->GetBitmap() [15].bgra, 0x40404040u );
+    }
+
+    TEST ( ImageCacheTest, FailedLoadsAreNotCached )
+    {
+        ImageCache cache;
+        EXPECT_EQ ( cache.GetFromFile ( ::testing::TempDir() + "ImageCacheTestMissing.pcx" ), nullptr );
+        EXPECT_EQ ( cache.GetStatistics().entries, 0u );
+    }
+}
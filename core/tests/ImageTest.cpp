@@ -0,0 +1,262 @@
+/*!
+@file
+@author Rodrigo Hernandez
+@copy 2020
+*/
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "Image.h"
+
+using namespace ::testing;
+namespace AeonGUI
+{
+    static const Color White{0, 255, 255, 255};
+    static const Color Black{255, 0, 0, 0};
+    static const Color Content{255, 10, 20, 30};
+
+    /*  Builds a version 5 RLE PCX with one plane per BGRA channel,
+        every byte is written as a run of one so the test data stays readable. */
+    static std::vector<uint8_t> MakePcx ( uint32_t aWidth, uint32_t aHeight, const std::vector<Color>& aPixels )
+    {
+        std::vector<uint8_t> pcx ( 128, 0 );
+        pcx[0] = 0x0A;
+        pcx[1] = 5;
+        pcx[2] = 1;
+        pcx[3] = 8;
+        pcx[8] = static_cast<uint8_t> ( aWidth - 1 );
+        pcx[10] = static_cast<uint8_t> ( aHeight - 1 );
+        pcx[65] = 4;
+        pcx[66] = static_cast<uint8_t> ( aWidth );
+        for ( uint32_t y = 0; y < aHeight; ++y )
+        {
+            for ( uint8_t Color::* channel : {&Color::r, &Color::g, &Color::b, &Color::a} )
+            {
+                for ( uint32_t x = 0; x < aWidth; ++x )
+                {
+                    pcx.push_back ( 0xC1 );
+                    pcx.push_back ( aPixels[y * aWidth + x].*channel );
+                }
+            }
+        }
+        return pcx;
+    }
+
+    /* 5x5 image with a one pixel 9-patch guide frame around 3x3 content. */
+    static std::vector<Color> MakePatch9()
+    {
+        std::vector<Color> pixels ( 25, White );
+        for ( uint32_t i = 1; i < 4; ++i )
+        {
+            pixels[i] = Black;
+            pixels[i * 5] = Black;
+            for ( uint32_t x = 1; x < 4; ++x )
+            {
+                pixels[i * 5 + x] = Content;
+            }
+        }
+        return pixels;
+    }
+
+    TEST ( ImageTest, LoadsPcxFromMemory )
+    {
+        std::vector<Color> pixels ( 6 );
+        for ( uint32_t i = 0; i < pixels.size(); ++i )
+        {
+            pixels[i] = Color{static_cast<uint8_t> ( 200 + i ), static_cast<uint8_t> ( i * 40 ), static_cast<uint8_t> ( i * 20 ), static_cast<uint8_t> ( i * 10 ) };
+        }
+        std::vector<uint8_t> pcx = MakePcx ( 3, 2, pixels );
+        Image image;
+        ASSERT_TRUE ( image.LoadFromMemory ( static_cast<uint32_t> ( pcx.size() ), pcx.data() ) );
+        ASSERT_EQ ( image.GetWidth(), 3 );
+        ASSERT_EQ ( image.GetHeight(), 2 );
+        for ( uint32_t i = 0; i < pixels.size(); ++i )
+        {
+            EXPECT_EQ ( image.GetBitmap() [i].bgra, pixels[i].bgra );
+        }
+    }
+
+    TEST ( ImageTest, RejectsPcxLargerThanItsData )
+    {
+        // 65535x65536 with 4 planes would overflow 32 bit size math, and no RLE data could fill it.
+        std::vector<uint8_t> pcx = MakePcx ( 1, 1, {Content} );
+        pcx[8] = 0xfe;
+        pcx[9] = 0xff;
+        pcx[10] = 0xff;
+        pcx[11] = 0xff;
+        pcx[66] = 0xff;
+        pcx[67] = 0xff;
+        Image image;
+        EXPECT_FALSE ( image.LoadFromMemory ( static_cast<uint32_t> ( pcx.size() ), pcx.data() ) );
+        EXPECT_EQ ( image.GetBitmap(), nullptr );
+    }
+
+    TEST ( ImageTest, CropsPcxPatch9Frame )
+    {
+        std::vector<uint8_t> pcx = MakePcx ( 5, 5, MakePatch9() );
+        Image image;
+        ASSERT_TRUE ( image.LoadFromMemory ( static_cast<uint32_t> ( pcx.size() ), pcx.data() ) );
+        ASSERT_EQ ( image.GetWidth(), 3 );
+        ASSERT_EQ ( image.GetHeight(), 3 );
+        EXPECT_EQ ( image.GetStretchXStart(), 0u );
+        EXPECT_EQ ( image.GetStretchXEnd(), 3u );
+        EXPECT_EQ ( image.GetStretchYStart(), 0u );
+        EXPECT_EQ ( image.GetStretchYEnd(), 3u );
+        for ( int32_t i = 0; i < image.GetWidth() * image.GetHeight(); ++i )
+        {
+            EXPECT_EQ ( image.GetBitmap() [i].bgra, Content.bgra );
+        }
+    }
+
+    TEST ( ImageTest, RejectsTruncatedPcx )
+    {
+        std::vector<uint8_t> pcx = MakePcx ( 3, 2, std::vector<Color> ( 6, Content ) );
+        pcx.resize ( pcx.size() - 3 );
+        Image image;
+        EXPECT_FALSE ( image.LoadFromMemory ( static_cast<uint32_t> ( pcx.size() ), pcx.data() ) );
+        EXPECT_EQ ( image.GetBitmap(), nullptr );
+        EXPECT_EQ ( image.GetWidth(), 0 );
+    }
+
+    TEST ( ImageTest, RejectsUnsupportedPcxVersion )
+    {
+        std::vector<uint8_t> pcx = MakePcx ( 3, 2, std::vector<Color> ( 6, Content ) );
+        pcx[1] = 3;
+        Image image;
+        EXPECT_FALSE ( image.LoadFromMemory ( static_cast<uint32_t> ( pcx.size() ), pcx.data() ) );
+        EXPECT_EQ ( image.GetBitmap(), nullptr );
+    }
+
+    TEST ( ImageTest, LoadsFromMappedFile )
+    {
+        std::vector<uint8_t> pcx = MakePcx ( 5, 5, MakePatch9() );
+        std::string path = ::testing::TempDir() + "ImageTest.pcx";
+        FILE* file = fopen ( path.c_str(), "wb" );
+        ASSERT_NE ( file, nullptr );
+        fwrite ( pcx.data(), 1, pcx.size(), file );
+        fclose ( file );
+        Image image;
+        EXPECT_TRUE ( image.LoadFromFile ( path.c_str() ) );
+        EXPECT_EQ ( image.GetWidth(), 3 );
+        EXPECT_EQ ( image.GetHeight(), 3 );
+        remove ( path.c_str() );
+        EXPECT_FALSE ( image.LoadFromFile ( path.c_str() ) );
+    }
+
+    TEST ( ImageTest, ReloadDetectsPatch9Again )
+    {
+        std::vector<uint8_t> patch9 = MakePcx ( 5, 5, MakePatch9() );
+        std::vector<uint8_t> plain = MakePcx ( 3, 2, std::vector<Color> ( 6, Content ) );
+        Image image;
+        ASSERT_TRUE ( image.LoadFromMemory ( static_cast<uint32_t> ( patch9.size() ), patch9.data() ) );
+        ASSERT_TRUE ( image.LoadFromMemory ( static_cast<uint32_t> ( plain.size() ), plain.data() ) );
+        EXPECT_EQ ( image.GetWidth(), 3 );
+        EXPECT_EQ ( image.GetHeight(), 2 );
+        ASSERT_TRUE ( image.LoadFromMemory ( static_cast<uint32_t> ( patch9.size() ), patch9.data() ) );
+        EXPECT_EQ ( image.GetWidth(), 3 );
+        EXPECT_EQ ( image.GetHeight(), 3 );
+    }
+
+    TEST ( ImageTest, MipChainHalvesDownToOnePixel )
+    {
+        // 8x4 image, left half 0x40 and right half 0xC0 on every channel.
+        std::vector<uint8_t> pixels ( 8 * 4 * 4 );
+        for ( uint32_t i = 0; i < 8 * 4; ++i )
+        {
+            std::fill_n ( pixels.begin() + i * 4, 4, ( i % 8 ) < 4 ? 0x40 : 0xC0 );
+        }
+        Image image;
+        ASSERT_TRUE ( image.Load ( 8, 4, Image::BGRA, Image::BYTE, pixels.data() ) );
+        ASSERT_EQ ( image.GetMipLevelCount(), 4u );
+        uint32_t width, height;
+        EXPECT_EQ ( image.GetMipLevel ( 0, width, height ), image.GetBitmap() );
+        const Color* level = image.GetMipLevel ( 1, width, height );
+        ASSERT_NE ( level, nullptr );
+        EXPECT_EQ ( width, 4u );
+        EXPECT_EQ ( height, 2u );
+        EXPECT_EQ ( level[0].bgra, 0x40404040u );
+        EXPECT_EQ ( level[3].bgra, 0xC0C0C0C0u );
+        level = image.GetMipLevel ( 3, width, height );
+        EXPECT_EQ ( width, 1u );
+        EXPECT_EQ ( height, 1u );
+        EXPECT_EQ ( level[0].bgra, 0x80808080u );
+        // Levels past the end clamp to the last one.
+        EXPECT_EQ ( image.GetMipLevel ( 9, width, height ), level );
+    }
+
+    TEST ( ImageTest, MipLevelForScaleNeverSkipsPixels )
+    {
+        std::vector<uint8_t> pixels ( 16 * 16 * 4, 0x80 );
+        Image image;
+        EXPECT_EQ ( image.GetMipLevelCount(), 0u );
+        ASSERT_TRUE ( image.Load ( 16, 16, Image::BGRA, Image::BYTE, pixels.data() ) );
+        EXPECT_EQ ( image.GetMipLevelForScale ( 2.0f ), 0u );
+        EXPECT_EQ ( image.GetMipLevelForScale ( 0.75f ), 0u );
+        EXPECT_EQ ( image.GetMipLevelForScale ( 0.5f ), 1u );
+        EXPECT_EQ ( image.GetMipLevelForScale ( 0.3f ), 1u );
+        EXPECT_EQ ( image.GetMipLevelForScale ( 0.25f ), 2u );
+        EXPECT_EQ ( image.GetMipLevelForScale ( 0.001f ), 4u );
+    }
+
+    TEST ( ImageTest, ReloadDropsMipChain )
+    {
+        std::vector<uint8_t> dark ( 4 * 4 * 4, 0x20 );
+        std::vector<uint8_t> light ( 4 * 4 * 4, 0xE0 );
+        Image image;
+        uint32_t width, height;
+        ASSERT_TRUE ( image.Load ( 4, 4, Image::BGRA, Image::BYTE, dark.data() ) );
+        EXPECT_EQ ( image.GetMipLevel ( 2, width, height ) [0].bgra, 0x20202020u );
+        ASSERT_TRUE ( image.Load ( 4, 4, Image::BGRA, Image::BYTE, light.data() ) );
+        EXPECT_EQ ( image.GetMipLevel ( 2, width, height ) [0].bgra, 0xE0E0E0E0u );
+    }
+
+#ifdef USE_PNG
+    TEST ( ImageTest, DecodesRgbPngIntoBgra )
+    {
+        // 2x2 RGB: red, green / blue, (10,20,30).
+        static const uint8_t png[] =
+        {
+            0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44,
+            0x52, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x08, 0x02, 0x00, 0x00, 0x00, 0xfd,
+            0xd4, 0x9a, 0x73, 0x00, 0x00, 0x00, 0x13, 0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0x63, 0xf8,
+            0xcf, 0xc0, 0xc0, 0x00, 0xc2, 0x0c, 0xff, 0xb9, 0x44, 0xe4, 0x00, 0x1a, 0x58, 0x03, 0x3a,
+            0xe2, 0x92, 0x6e, 0xd9, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60,
+            0x82
+        };
+        Image image;
+        ASSERT_TRUE ( image.LoadFromMemory ( sizeof ( png ), png ) );
+        ASSERT_EQ ( image.GetWidth(), 2 );
+        ASSERT_EQ ( image.GetHeight(), 2 );
+        EXPECT_EQ ( image.GetBitmap() [0].bgra, 0xFFFF0000u );
+        EXPECT_EQ ( image.GetBitmap() [1].bgra, 0xFF00FF00u );
+        EXPECT_EQ ( image.GetBitmap() [2].bgra, 0xFF0000FFu );
+        EXPECT_EQ ( image.GetBitmap() [3].bgra, 0xFF0A141Eu );
+    }
+
+    TEST ( ImageTest, CropsPngPatch9Frame )
+    {
+        // Same 5x5 guide frame as MakePatch9, stored as RGBA.
+        static const uint8_t png[] =
+        {
+            0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44,
+            0x52, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x05, 0x08, 0x06, 0x00, 0x00, 0x00, 0x8d,
+            0x6f, 0x26, 0xe5, 0x00, 0x00, 0x00, 0x1f, 0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0x63, 0xf8,
+            0xff, 0xff, 0x3f, 0x03, 0x10, 0xfc, 0x87, 0x61, 0x28, 0x9f, 0xe1, 0x3f, 0x97, 0x88, 0x1c,
+            0x1c, 0x93, 0x28, 0x08, 0x22, 0xd0, 0x31, 0x00, 0x6e, 0xf2, 0x2e, 0xf0, 0x36, 0x5a, 0xc6,
+            0x94, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60, 0x82
+        };
+        Image image;
+        ASSERT_TRUE ( image.LoadFromMemory ( sizeof ( png ), png ) );
+        ASSERT_EQ ( image.GetWidth(), 3 );
+        ASSERT_EQ ( image.GetHeight(), 3 );
+        EXPECT_EQ ( image.GetStretchXEnd(), 3u );
+        for ( int32_t i = 0; i < image.GetWidth() * image.GetHeight(); ++i )
+        {
+            EXPECT_EQ ( image.GetBitmap() [i].bgra, Content.bgra );
+        }
+    }
+#endif
+}
@@ -0,0 +1,105 @@
+/*!
+@file
+@author Rodrigo Hernandez
+@copy 2020
+*/
+#include <chrono>
+#include <fstream>
+#include <string>
+#include "gtest/gtest.h"
+#include "aeongui/Document.h"
+#include "aeongui/JsDuktape.h"
+#include "dom/Element.h"
+
+using namespace ::testing;
+namespace AeonGUI
+{
+    class JsDuktapeTest : public Test
+    {
+    protected:
+        void SetUp() override
+        {
+            mFilename = TempDir() + "aeongui-jsduktape-test.svg";
+            std::ofstream file ( mFilename );
+            file << "<svg xmlns=\"http://www.w3.org/2000/svg\"><g id=\"group\"/></svg>";
+        }
+        void TearDown() override
+        {
+            std::remove ( mFilename.c_str() );
+        }
+        static std::string GetString ( Element* aElement, const char* aName )
+        {
+            AttributeType value = aElement->GetAttribute ( aName );
+            return std::holds_alternative<std::string> ( value ) ? std::get<std::string> ( value ) : std::string{};
+        }
+        std::string mFilename;
+    };
+
+    TEST_F ( JsDuktapeTest, ElementWrappersKeepIdentity )
+    {
+        Document document{mFilename};
+        JsDuktape javascript{nullptr, &document};
+        javascript.Eval ( "var group = document.getElementById('group');"
+                          "var made = document.createElementNS('http://www.w3.org/2000/svg', 'g');"
+                          "made.setAttribute('id', 'made');"
+                          "group.appendChild(made);"
+                          "group.setAttribute('class', (group === document.getElementById('group')) ? 'same' : 'different');"
+                          "group.setAttribute('title', group.getAttribute('class'));" );
+        Element* group = document.getElementById ( "group" );
+        ASSERT_NE ( group, nullptr );
+        // Writes to elements in the document wait for the next frame.
+        EXPECT_EQ ( GetString ( group, "class" ), "" );
+        document.ApplyPendingAttributes();
+        EXPECT_EQ ( GetString ( group, "class" ), "same" );
+        EXPECT_EQ ( GetString ( group, "title" ), "same" );
+        Element* made = document.getElementById ( "made" );
+        ASSERT_NE ( made, nullptr );
+        EXPECT_EQ ( made->parentNode(), group );
+    }
+
+    TEST_F ( JsDuktapeTest, AnimationFramesRunOncePerRequest )
+    {
+        Document document{mFilename};
+        JsDuktape javascript{nullptr, &document};
+        javascript.Eval ( "var frames = 0;"
+                          "function tick(time) { if (++frames < 3) { requestAnimationFrame(tick); } }"
+                          "requestAnimationFrame(tick);"
+                          "cancelAnimationFrame(requestAnimationFrame(function() { frames = 100; }));" );
+        int runs{0};
+        while ( javascript.HasAnimationFrameCallbacks() && runs < 10 )
+        {
+            EXPECT_TRUE ( javascript.RunAnimationFrameCallbacks ( runs * 16.0, std::chrono::steady_clock::now() + std::chrono::seconds{1} ) );
+            ++runs;
+        }
+        EXPECT_EQ ( runs, 3 );
+        javascript.Eval ( "document.getElementById('group').setAttribute('opacity', frames);" );
+        document.ApplyPendingAttributes();
+        AttributeType frames = document.getElementById ( "group" )->GetAttribute ( "opacity" );
+        ASSERT_TRUE ( std::holds_alternative<double> ( frames ) );
+        EXPECT_EQ ( std::get<double> ( frames ), 3.0 );
+    }
+
+    TEST_F ( JsDuktapeTest, StatisticsTrackHeapAndIdleCollections )
+    {
+        Document document{mFilename};
+        JsDuktape javascript{nullptr, &document};
+        const ScriptStatistics initial = javascript.GetStatistics();
+        EXPECT_GT ( initial.heap_used, 0u );
+        javascript.Eval ( "var garbage = [];"
+                          "for (var i = 0; i < 1000; ++i) { var node = { index: i }; node.self = node; garbage.push(node); }" );
+        const ScriptStatistics loaded = javascript.GetStatistics();
+        EXPECT_GT ( loaded.heap_used, initial.heap_used );
+        EXPECT_GT ( loaded.execute_time.count(), 0 );
+        EXPECT_GT ( loaded.compile_time.count(), 0 );
+        EXPECT_EQ ( loaded.gc_count, 0u );
+
+        // The nodes reference themselves, only a full collection frees them.
+        javascript.Eval ( "garbage = null;" );
+        EXPECT_FALSE ( javascript.CollectGarbage ( std::chrono::steady_clock::now() - std::chrono::seconds{1} ) );
+        EXPECT_TRUE ( javascript.CollectGarbage ( std::chrono::steady_clock::now() + std::chrono::seconds{1} ) );
+        const ScriptStatistics collected = javascript.GetStatistics();
+        EXPECT_EQ ( collected.gc_count, 1u );
+        EXPECT_LT ( collected.heap_used, loaded.heap_used );
+        EXPECT_EQ ( collected.gc_longest_pause, collected.gc_pause_time );
+    }
+}
@@ -0,0 +1,105 @@
+/*!
+@file
+@author Rodrigo Hernandez
+@copy 2020
+*/
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include "gtest/gtest.h"
+#include "aeongui/AeonGUI.h"
+#include "aeongui/Document.h"
+#include "aeongui/JsV8Worker.h"
+#include "dom/Element.h"
+
+using namespace ::testing;
+namespace AeonGUI
+{
+    class JsV8WorkerTest : public Test
+    {
+    protected:
+        static void SetUpTestSuite()
+        {
+            static char name[] = "core-tests";
+            static char* argv[] = {name, nullptr};
+            Initialize ( 1, argv );
+        }
+        static void TearDownTestSuite()
+        {
+            Finalize();
+        }
+        void SetUp() override
+        {
+            mFilename = TempDir() + "aeongui-jsv8worker-test.svg";
+            std::ofstream file ( mFilename );
+            file << "<svg xmlns=\"http://www.w3.org/2000/svg\"><g id=\"group\"/></svg>";
+        }
+        void TearDown() override
+        {
+            std::remove ( mFilename.c_str() );
+        }
+        /*  What Window::Draw does for scripts, repeated for as long as
+            Window::NeedsFrame would keep the host from sleeping. */
+        static void DrawWhileNeeded ( V8Worker& aWorker, Document& aDocument )
+        {
+            while ( aWorker.HasPendingCommands() || aDocument.HasPendingAttributes() )
+            {
+                aWorker.ProcessCommands();
+                aDocument.ApplyPendingAttributes();
+            }
+        }
+        static std::string GetString ( Element* aElement, const char* aName )
+        {
+            AttributeType value = aElement->GetAttribute ( aName );
+            return std::holds_alternative<std::string> ( value ) ? std::get<std::string> ( value ) : std::string{};
+        }
+        std::string mFilename;
+    };
+
+    TEST_F ( JsV8WorkerTest, ReadAfterFirstDrawIsServed )
+    {
+        Document document{mFilename};
+        V8Worker worker{nullptr, &document};
+        worker.Eval ( "document.getElementById('group').setAttribute('class', 'first');" );
+        DrawWhileNeeded ( worker, document );
+        Element* group = document.getElementById ( "group" );
+        ASSERT_NE ( group, nullptr );
+        EXPECT_EQ ( GetString ( group, "class" ), "first" );
+
+        // The worker may not have reached the read yet, the host must not go idle regardless.
+        worker.Eval ( "var group = document.getElementById('group');"
+                      "group.setAttribute('title', group.getAttribute('class'));" );
+        EXPECT_TRUE ( worker.HasPendingCommands() );
+        DrawWhileNeeded ( worker, document );
+        EXPECT_EQ ( GetString ( group, "title" ), "first" );
+        EXPECT_FALSE ( worker.HasPendingCommands() );
+    }
+
+    TEST_F ( JsV8WorkerTest, ScriptErrorsAreReported )
+    {
+        Document document{mFilename};
+        V8Worker worker{nullptr, &document};
+        internal::CaptureStderr();
+        worker.Eval ( "throw new Error('thrown on purpose');" );
+        worker.Eval ( "this is not javascript" );
+        // The engine keeps going after both.
+        worker.Eval ( "document.getElementById('group').setAttribute('class', 'after');" );
+        DrawWhileNeeded ( worker, document );
+        const std::string errors = internal::GetCapturedStderr();
+        EXPECT_NE ( errors.find ( "thrown on purpose" ), std::string::npos );
+        EXPECT_NE ( errors.find ( "SyntaxError" ), std::string::npos );
+        EXPECT_EQ ( GetString ( document.getElementById ( "group" ), "class" ), "after" );
+    }
+
+    TEST_F ( JsV8WorkerTest, EndlessScriptDoesNotHoldUpDestruction )
+    {
+        Document document{mFilename};
+        {
+            V8Worker worker{nullptr, &document};
+            worker.Eval ( "for (;;) {}" );
+            worker.Eval ( "document.getElementById('group').setAttribute('class', 'never');" );
+        }
+        document.ApplyPendingAttributes();
+        EXPECT_EQ ( GetString ( document.getElementById ( "group" ), "class" ), "" );
+    }
+}
@@ -0,0 +1,67 @@
+/*!
+@file
+@author Rodrigo Hernandez
+@copy 2020
+*/
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "gtest/gtest.h"
+#include "aeongui/MappedFile.h"
+
+using namespace ::testing;
+namespace AeonGUI
+{
+    static std::string WriteTemporaryFile ( const char* aName, const void* aData, size_t aSize )
+    {
+        std::string path = ::testing::TempDir() + aName;
+        FILE* file = fopen ( path.c_str(), "wb" );
+        EXPECT_NE ( file, nullptr );
+        if ( file != nullptr )
+        {
+            fwrite ( aData, 1, aSize, file );
+            fclose ( file );
+        }
+        return path;
+    }
+
+    TEST ( MappedFileTest, MapsWholeFile )
+    {
+        const char contents[] = "Mapped file contents.";
+        std::string path = WriteTemporaryFile ( "MappedFileTest.bin", contents, sizeof ( contents ) );
+        MappedFile file;
+        ASSERT_TRUE ( file.Open ( path.c_str() ) );
+        ASSERT_EQ ( file.GetSize(), sizeof ( contents ) );
+        EXPECT_EQ ( memcmp ( file.GetData(), contents, sizeof ( contents ) ), 0 );
+        file.Close();
+        EXPECT_EQ ( file.GetData(), nullptr );
+        EXPECT_EQ ( file.GetSize(), 0u );
+        remove ( path.c_str() );
+    }
+
+    TEST ( MappedFileTest, ReopenReplacesMapping )
+    {
+        const char first[] = "first";
+        const char second[] = "second file";
+        std::string first_path = WriteTemporaryFile ( "MappedFileTest1.bin", first, sizeof ( first ) );
+        std::string second_path = WriteTemporaryFile ( "MappedFileTest2.bin", second, sizeof ( second ) );
+        MappedFile file;
+        ASSERT_TRUE ( file.Open ( first_path.c_str() ) );
+        ASSERT_TRUE ( file.Open ( second_path.c_str() ) );
+        ASSERT_EQ ( file.GetSize(), sizeof ( second ) );
+        EXPECT_EQ ( memcmp ( file.GetData(), second, sizeof ( second ) ), 0 );
+        remove ( first_path.c_str() );
+        remove ( second_path.c_str() );
+    }
+
+    TEST ( MappedFileTest, MissingAndEmptyFilesFail )
+    {
+        MappedFile file;
+        EXPECT_FALSE ( file.Open ( ( ::testing::TempDir() + "MappedFileTestMissing.bin" ).c_str() ) );
+        EXPECT_EQ ( file.GetData(), nullptr );
+        std::string path = WriteTemporaryFile ( "MappedFileTestEmpty.bin", "", 0 );
+        EXPECT_FALSE ( file.Open ( path.c_str() ) );
+        EXPECT_EQ ( file.GetSize(), 0u );
+        remove ( path.c_str() );
+    }
+}
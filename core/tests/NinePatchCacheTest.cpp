@@ -0,0 +1,155 @@
+/*!
+@file
+@author Rodrigo Hernandez
+@copy 2020
+*/
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include "gtest/gtest.h"
+#include "NinePatchCache.h"
+
+using namespace ::testing;
+namespace AeonGUI
+{
+    static void MakeFlatImage ( Image& aImage, uint32_t aSize, uint8_t aValue )
+    {
+        std::vector<uint8_t> pixels ( aSize * aSize * 4, aValue );
+        aImage.Load ( aSize, aSize, Image::BGRA, Image::BYTE, pixels.data() );
+    }
+
+    TEST ( NinePatchCacheTest, SecondRequestHits )
+    {
+        Image image;
+        MakeFlatImage ( image, 4, 0x20 );
+        NinePatchCache cache;
+        NinePatchCache::Handle first = cache.Get ( image, 8, 8 );
+        NinePatchCache::Handle second = cache.Get ( image, 8, 8 );
+        EXPECT_EQ ( first.get(), second.get() );
+        EXPECT_EQ ( cache.GetMisses(), 1u );
+        EXPECT_EQ ( cache.GetHits(), 1u );
+        EXPECT_EQ ( first->width, 8u );
+        EXPECT_EQ ( first->pixels[63].bgra, 0x20202020u );
+    }
+
+    TEST ( NinePatchCacheTest, OtherSizesAndScalesMiss )
+    {
+        Image image;
+        MakeFlatImage ( image, 4, 0x20 );
+        NinePatchCache cache;
+        cache.Get ( image, 8, 8 );
+        cache.Get ( image, 8, 9 );
+        cache.Get ( image, 8, 8, 2.0 );
+        EXPECT_EQ ( cache.GetMisses(), 3u );
+        EXPECT_EQ ( cache.GetHits(), 0u );
+    }
+
+    TEST ( NinePatchCacheTest, ReloadingTheImageInvalidates )
+    {
+        Image image;
+        MakeFlatImage ( image, 4, 0x20 );
+        NinePatchCache cache;
+        cache.Get ( image, 8, 8 );
+        MakeFlatImage ( image, 4, 0x60 );
+        NinePatchCache::Handle bitmap = cache.Get ( image, 8, 8 );
+        EXPECT_EQ ( cache.GetMisses(), 2u );
+        EXPECT_EQ ( bitmap->pixels[0].bgra, 0x60606060u );
+    }
+
+    TEST ( NinePatchCacheTest, NewImageAtTheSameAddressMisses )
+    {
+        std::optional<Image> image;
+        NinePatchCache cache;
+        image.emplace();
+        MakeFlatImage ( *image, 4, 0x20 );
+        cache.Get ( *image, 8, 8 );
+        image.reset();
+        image.emplace();
+        MakeFlatImage ( *image, 4, 0x60 );
+        NinePatchCache::Handle bitmap = cache.Get ( *image, 8, 8 );
+        EXPECT_EQ ( cache.GetMisses(), 2u );
+        EXPECT_EQ ( bitmap->pixels[0].bgra, 0x60606060u );
+    }
+
+    TEST ( NinePatchCacheTest, ForgetAndCapacityDropResults )
+    {
+        Image a, b;
+        MakeFlatImage ( a, 4, 0x20 );
+        MakeFlatImage ( b, 4, 0x60 );
+        NinePatchCache cache ( 1 );
+        cache.Get ( a, 8, 8 );
+        cache.Forget ( a );
+        cache.Get ( a, 8, 8 );
+        EXPECT_EQ ( cache.GetMisses(), 2u );
+        cache.Get ( b, 8, 8 );
+        cache.Get ( a, 8, 8 );
+        EXPECT_EQ ( cache.GetMisses(), 4u );
+        EXPECT_EQ ( cache.GetHits(), 0u );
+    }
+
+    TEST ( NinePatchCacheTest, ShrinkingStartsFromTheMipChain )
+    {
+        // No opaque black on the border, so no 9 patch frame is detected.
+        std::vector<Color> pixels ( 64 * 64 );
+        for ( uint32_t y = 0; y < 64; ++y )
+        {
+            for ( uint32_t x = 0; x < 64; ++x )
+            {
+                pixels[y * 64 + x] = Color{255, static_cast<uint8_t> ( x * 4 + 1 ), static_cast<uint8_t> ( y * 4 ), static_cast<uint8_t> ( ( x ^ y ) * 8 ) };
+            }
+        }
+        Image image;
+        image.Load ( 64, 64, Image::BGRA, Image::BYTE, pixels.data() );
+        ASSERT_EQ ( image.GetWidth(), 64u );
+        ASSERT_EQ ( image.GetMipLevelForScale ( 0.125f ), 3u );
+        uint32_t level_width;
+        uint32_t level_height;
+        const Color* level = image.GetMipLevel ( 3, level_width, level_height );
+        ASSERT_EQ ( level_width, 8u );
+        ASSERT_EQ ( level_height, 8u );
+        // The 8x8 result is the third level passed through unchanged.
+        NinePatchCache cache;
+        NinePatchCache::Handle bitmap = cache.Get ( image, 8, 8 );
+        for ( size_t i = 0; i < 64; ++i )
+        {
+            EXPECT_EQ ( bitmap->pixels[i].bgra, level[i].bgra ) << i;
+        }
+        // A size between two levels is resampled down from the larger one.
+        NinePatchCache::Handle between = cache.Get ( image, 12, 12 );
+        EXPECT_EQ ( between->width, 12u );
+        EXPECT_EQ ( between->pixels.size(), 144u );
+    }
+
+    TEST ( NinePatchCacheTest, CornersKeepTheirSize )
+    {
+        // 5x5 with a guide frame, the 3x3 content stretches only through its middle row and column.
+        const Color white{0, 255, 255, 255};
+        const Color black{255, 0, 0, 0};
+        const Color corner{255, 200, 0, 0};
+        const Color middle{255, 0, 0, 200};
+        std::vector<Color> pixels ( 25, white );
+        pixels[2] = black;
+        pixels[10] = black;
+        for ( uint32_t y = 1; y < 4; ++y )
+        {
+            for ( uint32_t x = 1; x < 4; ++x )
+            {
+                pixels[y * 5 + x] = ( x == 2 || y == 2 ) ? middle : corner;
+            }
+        }
+        Image image;
+        image.Load ( 5, 5, Image::BGRA, Image::BYTE, pixels.data() );
+        ASSERT_EQ ( image.GetWidth(), 3 );
+        NinePatchCache cache;
+        NinePatchCache::Handle bitmap = cache.Get ( image, 10, 10 );
+        EXPECT_EQ ( bitmap->pixels[0].bgra, corner.bgra );
+        EXPECT_EQ ( bitmap->pixels[9].bgra, corner.bgra );
+        EXPECT_EQ ( bitmap->pixels[99].bgra, corner.bgra );
+        EXPECT_EQ ( bitmap->pixels[1].bgra, middle.bgra );
+        EXPECT_EQ ( bitmap->pixels[55].bgra, middle.bgra );
+        // A second size reuses the corners of the first.
+        NinePatchCache::Handle larger = cache.Get ( image, 12, 6 );
+        EXPECT_EQ ( larger->pixels[0].bgra, corner.bgra );
+        EXPECT_EQ ( larger->pixels[71].bgra, corner.bgra );
+    }
+}
@@ -0,0 +1,127 @@
+/*!
+@file
+@author Rodrigo Hernandez
+@copy 2020
+*/
+#include <cstdint>
+#include <vector>
+#include "gtest/gtest.h"
+#include "aeongui/PixelConversion.h"
+#include "aeongui/CpuFeatures.h"
+
+using namespace ::testing;
+namespace AeonGUI
+{
+    static std::vector<uint8_t> MakeSource ( size_t aSize )
+    {
+        std::vector<uint8_t> source ( aSize );
+        for ( size_t i = 0; i < aSize; ++i )
+        {
+            source[i] = static_cast<uint8_t> ( ( i * 37 ) + 11 );
+        }
+        return source;
+    }
+
+    // Odd counts exercise both the vector loops and the scalar tails.
+    TEST ( PixelConversionTest, RowsMatchComponentOrder )
+    {
+        for ( size_t count : {1u, 3u, 4u, 5u, 7u, 15u, 16u, 17u, 33u, 67u} )
+        {
+            std::vector<uint8_t> rgb = MakeSource ( count * 3 );
+            std::vector<uint8_t> rgba = MakeSource ( count * 4 );
+            std::vector<Color> destination ( count );
+
+            ConvertPixelRow ( PixelFormat::RGB, rgb.data(), destination.data(), count );
+            for ( size_t i = 0; i < count; ++i )
+            {
+                EXPECT_EQ ( destination[i].r, rgb[i * 3 + 0] );
+                EXPECT_EQ ( destination[i].g, rgb[i * 3 + 1] );
+                EXPECT_EQ ( destination[i].b, rgb[i * 3 + 2] );
+                EXPECT_EQ ( destination[i].a, 255 );
+            }
+
+            ConvertPixelRow ( PixelFormat::BGR, rgb.data(), destination.data(), count );
+            for ( size_t i = 0; i < count; ++i )
+            {
+                EXPECT_EQ ( destination[i].b, rgb[i * 3 + 0] );
+                EXPECT_EQ ( destination[i].g, rgb[i * 3 + 1] );
+                EXPECT_EQ ( destination[i].r, rgb[i * 3 + 2] );
+                EXPECT_EQ ( destination[i].a, 255 );
+            }
+
+            ConvertPixelRow ( PixelFormat::RGBA, rgba.data(), destination.data(), count );
+            for ( size_t i = 0; i < count; ++i )
+            {
+                EXPECT_EQ ( destination[i].r, rgba[i * 4 + 0] );
+                EXPECT_EQ ( destination[i].g, rgba[i * 4 + 1] );
+                EXPECT_EQ ( destination[i].b, rgba[i * 4 + 2] );
+                EXPECT_EQ ( destination[i].a, rgba[i * 4 + 3] );
+            }
+
+            ConvertPixelRow ( PixelFormat::BGRA, rgba.data(), destination.data(), count );
+            for ( size_t i = 0; i < count; ++i )
+            {
+                EXPECT_EQ ( destination[i].b, rgba[i * 4 + 0] );
+                EXPECT_EQ ( destination[i].g, rgba[i * 4 + 1] );
+                EXPECT_EQ ( destination[i].r, rgba[i * 4 + 2] );
+                EXPECT_EQ ( destination[i].a, rgba[i * 4 + 3] );
+            }
+        }
+    }
+
+    // Converting the inside of a 9 patch frame, as Image::Load does.
+    TEST ( PixelConversionTest, PitchedSubRectangle )
+    {
+        const uint32_t width = 21;
+        const uint32_t height = 5;
+        std::vector<uint8_t> source = MakeSource ( width * height * 3 );
+        std::vector<Color> destination ( ( width - 2 ) * ( height - 2 ) );
+        ConvertPixels ( PixelFormat::RGB, source.data() + ( ( width + 1 ) * 3 ), width * 3,
+                        destination.data(), ( width - 2 ) * sizeof ( Color ), width - 2, height - 2 );
+        for ( uint32_t y = 0; y < height - 2; ++y )
+        {
+            for ( uint32_t x = 0; x < width - 2; ++x )
+            {
+                const uint8_t* pixel = source.data() + ( ( ( y + 1 ) * width + ( x + 1 ) ) * 3 );
+                const Color& color = destination[y * ( width - 2 ) + x];
+                EXPECT_EQ ( color.r, pixel[0] );
+                EXPECT_EQ ( color.g, pixel[1] );
+                EXPECT_EQ ( color.b, pixel[2] );
+                EXPECT_EQ ( color.a, 255 );
+            }
+        }
+    }
+
+    /*  The tests above only see the kernel dispatched on the test machine,
+        this runs every kernel the machine supports against the scalar one. */
+    TEST ( PixelConversionTest, KernelsMatchScalar )
+    {
+        size_t kernels_run{0};
+        for ( uint32_t features : {static_cast<uint32_t> ( CPU_SSSE3 ), static_cast<uint32_t> ( CPU_AVX2 ), static_cast<uint32_t> ( CPU_NEON ) } )
+        {
+            for ( PixelFormat format : {PixelFormat::RGB, PixelFormat::BGR, PixelFormat::RGBA, PixelFormat::BGRA} )
+            {
+                for ( size_t count : {1u, 5u, 9u, 10u, 16u, 17u, 31u, 64u, 67u} )
+                {
+                    std::vector<uint8_t> source = MakeSource ( count * 4 );
+                    std::vector<Color> expected ( count );
+                    std::vector<Color> actual ( count );
+                    ASSERT_TRUE ( ConvertPixelRowWith ( 0, format, source.data(), expected.data(), count ) );
+                    if ( !ConvertPixelRowWith ( features, format, source.data(), actual.data(), count ) )
+                    {
+                        break;
+                    }
+                    ++kernels_run;
+                    for ( size_t i = 0; i < count; ++i )
+                    {
+                        EXPECT_EQ ( actual[i].bgra, expected[i].bgra ) << "features " << features << " format " << static_cast<int> ( format ) << " count " << count << " pixel " << i;
+                    }
+                }
+            }
+        }
+        if ( kernels_run == 0 )
+        {
+            GTEST_SKIP() << "No vector kernels supported, only the scalar path was checked.";
+        }
+    }
+}
@@ -0,0 +1,109 @@
+/*!
+@file
+@author Rodrigo Hernandez
+@copy 2020
+*/
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "gtest/gtest.h"
+#include "aeongui/Resampler.h"
+
+using namespace ::testing;
+namespace AeonGUI
+{
+    static const ResampleFilter Filters[] = {ResampleFilter::BOX, ResampleFilter::BILINEAR, ResampleFilter::BICUBIC, ResampleFilter::LANCZOS3};
+
+    static std::vector<Color> MakeGradient ( uint32_t aWidth, uint32_t aHeight )
+    {
+        std::vector<Color> pixels ( aWidth * aHeight );
+        for ( uint32_t y = 0; y < aHeight; ++y )
+        {
+            for ( uint32_t x = 0; x < aWidth; ++x )
+            {
+                pixels[y * aWidth + x] = Color{255, static_cast<uint8_t> ( x * 7 ), static_cast<uint8_t> ( y * 5 ), static_cast<uint8_t> ( x ^ y ) };
+            }
+        }
+        return pixels;
+    }
+
+    TEST ( ResamplerTest, SameSizeIsACopy )
+    {
+        const std::vector<Color> source = MakeGradient ( 19, 11 );
+        for ( ResampleFilter filter : Filters )
+        {
+            std::vector<Color> destination ( source.size() );
+            Resampler{19, 11, 19, 11, filter}.Resample ( source.data(), 19 * sizeof ( Color ), destination.data(), 19 * sizeof ( Color ) );
+            for ( size_t i = 0; i < source.size(); ++i )
+            {
+                EXPECT_EQ ( destination[i].bgra, source[i].bgra );
+            }
+        }
+    }
+
+    TEST ( ResamplerTest, FlatColorStaysFlat )
+    {
+        const std::vector<Color> source ( 23 * 17, Color{0x80402010} );
+        for ( ResampleFilter filter : Filters )
+        {
+            for ( uint32_t size : {5u, 16u, 50u} )
+            {
+                std::vector<Color> destination ( size * size );
+                Resampler{23, 17, size, size, filter}.Resample ( source.data(), 23 * sizeof ( Color ), destination.data(), size * sizeof ( Color ), 3 );
+                for ( auto& i : destination )
+                {
+                    EXPECT_EQ ( i.bgra, 0x80402010u );
+                }
+            }
+        }
+    }
+
+    TEST ( ResamplerTest, BoxHalvingAverages )
+    {
+        // Columns alternate between 0 and 200, so every 2x2 block averages to 100.
+        std::vector<Color> source ( 16 * 8 );
+        for ( size_t i = 0; i < source.size(); ++i )
+        {
+            source[i] = ( i % 2 ) ? Color{0xc8c8c8c8} : Color{0};
+        }
+        std::vector<Color> destination ( 8 * 4 );
+        Resampler{16, 8, 8, 4, ResampleFilter::BOX}.Resample ( source.data(), 16 * sizeof ( Color ), destination.data(), 8 * sizeof ( Color ) );
+        for ( auto& i : destination )
+        {
+            EXPECT_EQ ( i.bgra, 0x64646464u );
+        }
+    }
+
+    TEST ( ResamplerTest, HalveBitmapMatchesReference )
+    {
+        const uint32_t sizes[][2] = {{37, 21}, {16, 16}, {1, 9}, {9, 1}, {1, 1}};
+        for ( auto& size : sizes )
+        {
+            const uint32_t width = size[0];
+            const uint32_t height = size[1];
+            std::vector<Color> source = MakeGradient ( width, height );
+            for ( size_t i = 0; i < source.size(); ++i )
+            {
+                source[i].a = static_cast<uint8_t> ( i * 13 );
+            }
+            const uint32_t half_width = std::max ( width / 2, 1u );
+            const uint32_t half_height = std::max ( height / 2, 1u );
+            std::vector<Color> destination ( half_width * half_height );
+            HalveBitmap ( source.data(), width * sizeof ( Color ), width, height, destination.data(), half_width * sizeof ( Color ) );
+            for ( uint32_t y = 0; y < half_height; ++y )
+            {
+                for ( uint32_t x = 0; x < half_width; ++x )
+                {
+                    const uint32_t x0 = std::min ( x * 2, width - 1 ), x1 = std::min ( x * 2 + 1, width - 1 );
+                    const uint32_t y0 = std::min ( y * 2, height - 1 ), y1 = std::min ( y * 2 + 1, height - 1 );
+                    const Color* quad[4] = {&source[y0 * width + x0], &source[y0 * width + x1], &source[y1 * width + x0], &source[y1 * width + x1]};
+                    const Color& result = destination[y * half_width + x];
+                    EXPECT_EQ ( result.b, ( quad[0]->b + quad[1]->b + quad[2]->b + quad[3]->b + 2 ) / 4 );
+                    EXPECT_EQ ( result.g, ( quad[0]->g + quad[1]->g + quad[2]->g + quad[3]->g + 2 ) / 4 );
+                    EXPECT_EQ ( result.r, ( quad[0]->r + quad[1]->r + quad[2]->r + quad[3]->r + 2 ) / 4 );
+                    EXPECT_EQ ( result.a, ( quad[0]->a + quad[1]->a + quad[2]->a + quad[3]->a + 2 ) / 4 );
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,72 @@
+/*!
+@file
+@author Rodrigo Hernandez
+@copy 2020
+*/
+#include <vector>
+#include "gtest/gtest.h"
+#include "aeongui/ShelfPacker.h"
+
+using namespace ::testing;
+namespace AeonGUI
+{
+    static bool Overlap ( const Rect& a, const Rect& b )
+    {
+        return a.GetX() < static_cast<int32_t> ( b.GetX() + b.GetWidth() ) &&
+               b.GetX() < static_cast<int32_t> ( a.GetX() + a.GetWidth() ) &&
+               a.GetY() < static_cast<int32_t> ( b.GetY() + b.GetHeight() ) &&
+               b.GetY() < static_cast<int32_t> ( a.GetY() + a.GetHeight() );
+    }
+
+    TEST ( ShelfPackerTest, PlacedRectanglesStayInsideAndApart )
+    {
+        ShelfPacker packer{64, 64, 1};
+        std::vector<Rect> placed;
+        for ( uint32_t i = 0; i < 100; ++i )
+        {
+            Rect rect;
+            if ( !packer.Insert ( 3 + ( i * 7 ) % 9, 4 + ( i * 5 ) % 7, rect ) )
+            {
+                continue;
+            }
+            EXPECT_LE ( rect.GetX() + rect.GetWidth(), 64u );
+            EXPECT_LE ( rect.GetY() + rect.GetHeight(), 64u );
+            for ( auto& other : placed )
+            {
+                EXPECT_FALSE ( Overlap ( rect, other ) );
+            }
+            placed.push_back ( rect );
+        }
+        EXPECT_FALSE ( placed.empty() );
+    }
+
+    TEST ( ShelfPackerTest, RemovedSpaceIsReused )
+    {
+        ShelfPacker packer{32, 8, 0};
+        Rect rects[4];
+        for ( auto& i : rects )
+        {
+            ASSERT_TRUE ( packer.Insert ( 8, 8, i ) );
+        }
+        Rect rect;
+        EXPECT_FALSE ( packer.Insert ( 8, 8, rect ) );
+        packer.Remove ( rects[1] );
+        packer.Remove ( rects[2] );
+        ASSERT_TRUE ( packer.Insert ( 16, 8, rect ) );
+        EXPECT_EQ ( rect.GetX(), 8 );
+        EXPECT_EQ ( rect.GetY(), 0 );
+        EXPECT_DOUBLE_EQ ( packer.GetOccupancy(), 1.0 );
+    }
+
+    TEST ( ShelfPackerTest, EmptyTopShelfIsReshaped )
+    {
+        ShelfPacker packer{16, 16, 0};
+        Rect short_rect;
+        Rect tall_rect;
+        ASSERT_TRUE ( packer.Insert ( 16, 4, short_rect ) );
+        EXPECT_FALSE ( packer.Insert ( 16, 16, tall_rect ) );
+        packer.Remove ( short_rect );
+        EXPECT_TRUE ( packer.Insert ( 16, 16, tall_rect ) );
+        EXPECT_DOUBLE_EQ ( packer.GetOccupancy(), 1.0 );
+    }
+}
@@ -0,0 +1,158 @@
+/*!
+@file
+@author Rodrigo Hernandez
+@copy 2020
+*/
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "aeongui/Document.h"
+#include "aeongui/Canvas.h"
+#include "aeongui/GlyphRun.h"
+#include "dom/Element.h"
+
+using namespace ::testing;
+namespace AeonGUI
+{
+    /*  Records the glyph runs drawn instead of rasterizing them. */
+    class GlyphRunRecorder : public Canvas
+    {
+    public:
+        void ResizeViewport ( uint32_t, uint32_t ) override {}
+        const uint8_t* GetPixels() const override
+        {
+            return nullptr;
+        }
+        size_t GetWidth() const override
+        {
+            return 0;
+        }
+        size_t GetHeight() const override
+        {
+            return 0;
+        }
+        size_t GetStride() const override
+        {
+            return 0;
+        }
+        void Clear() override
+        {
+            runs.clear();
+            advances.clear();
+        }
+        void SetFillColor ( const ColorAttr& aColor ) override
+        {
+            mFill = aColor;
+        }
+        const ColorAttr& GetFillColor() const override
+        {
+            return mFill;
+        }
+        void SetStrokeColor ( const ColorAttr& aColor ) override
+        {
+            mStroke = aColor;
+        }
+        const ColorAttr& GetStrokeColor() const override
+        {
+            return mStroke;
+        }
+        void SetStrokeWidth ( double ) override {}
+        double GetStrokeWidth () const override
+        {
+            return 1.0;
+        }
+        void SetStrokeOpacity ( double ) override {}
+        double GetStrokeOpacity () const override
+        {
+            return 1.0;
+        }
+        void SetFillOpacity ( double ) override {}
+        double GetFillOpacity () const override
+        {
+            return 1.0;
+        }
+        void SetOpacity ( double ) override {}
+        double GetOpacity () const override
+        {
+            return 1.0;
+        }
+        void Draw ( const Path& ) override {}
+        void Draw ( const GlyphRun& aGlyphRun ) override
+        {
+            runs.push_back ( &aGlyphRun );
+            advances.push_back ( aGlyphRun.GetAdvance() );
+        }
+        std::vector<const GlyphRun*> runs{};
+        std::vector<double> advances{};
+    private:
+        ColorAttr mFill{};
+        ColorAttr mStroke{};
+    };
+
+    class TextLayoutTest : public Test
+    {
+    protected:
+        void SetUp() override
+        {
+            mFilename = TempDir() + "aeongui-text-layout-test.svg";
+            std::ofstream file ( mFilename );
+            file << "<svg xmlns=\"http://www.w3.org/2000/svg\" id=\"root\">"
+                 "<g id=\"group\" font-size=\"10\">"
+                 "<text id=\"text\" x=\"0\" y=\"20\">Hello <tspan id=\"span\">world</tspan></text>"
+                 "</g>"
+                 "</svg>";
+        }
+        void TearDown() override
+        {
+            std::remove ( mFilename.c_str() );
+        }
+        std::string mFilename;
+    };
+
+    TEST_F ( TextLayoutTest, RunsAreReusedBetweenDraws )
+    {
+        Document document{mFilename};
+        GlyphRunRecorder canvas;
+        document.Draw ( canvas );
+        ASSERT_EQ ( canvas.runs.size(), 2u );
+        const std::vector<const GlyphRun*> first = canvas.runs;
+        canvas.Clear();
+        document.Draw ( canvas );
+        EXPECT_EQ ( canvas.runs, first );
+    }
+
+    TEST_F ( TextLayoutTest, AncestorFontSizeChangeReshapes )
+    {
+        Document document{mFilename};
+        GlyphRunRecorder canvas;
+        document.Draw ( canvas );
+        ASSERT_EQ ( canvas.advances.size(), 2u );
+        const std::vector<double> small = canvas.advances;
+        EXPECT_GT ( small[0], 0.0 );
+        document.QueueAttribute ( document.getElementById ( "group" ), "font-size", "40" );
+        document.ApplyPendingAttributes();
+        canvas.Clear();
+        document.Draw ( canvas );
+        ASSERT_EQ ( canvas.advances.size(), 2u );
+        EXPECT_GT ( canvas.advances[0], small[0] );
+        EXPECT_GT ( canvas.advances[1], small[1] );
+    }
+
+    TEST_F ( TextLayoutTest, SpanFontSizeChangeReshapesOnlyWhatInherits )
+    {
+        Document document{mFilename};
+        GlyphRunRecorder canvas;
+        document.Draw ( canvas );
+        ASSERT_EQ ( canvas.advances.size(), 2u );
+        const std::vector<double> before = canvas.advances;
+        document.QueueAttribute ( document.getElementById ( "span" ), "font-size", "40" );
+        document.ApplyPendingAttributes();
+        canvas.Clear();
+        document.Draw ( canvas );
+        ASSERT_EQ ( canvas.advances.size(), 2u );
+        EXPECT_EQ ( canvas.advances[0], before[0] );
+        EXPECT_GT ( canvas.advances[1], before[1] );
+    }
+}
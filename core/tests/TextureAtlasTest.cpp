@@ -0,0 +1,119 @@
+/*!
+@file
+@author Rodrigo Hernandez
+@copy 2020
+*/
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "TextureAtlas.h"
+
+using namespace ::testing;
+namespace AeonGUI
+{
+    static void MakeImage ( Image& aImage, uint32_t aWidth, uint32_t aHeight, uint8_t aValue )
+    {
+        std::vector<uint8_t> pixels ( aWidth * aHeight * 4, aValue );
+        aImage.Load ( aWidth, aHeight, Image::BGRA, Image::BYTE, pixels.data() );
+    }
+
+    static bool RegionHolds ( const TextureAtlas& aAtlas, TextureAtlas::Handle aHandle, uint8_t aValue )
+    {
+        const Rect& rect = aAtlas.GetRegion ( aHandle );
+        for ( uint32_t y = 0; y < rect.GetHeight(); ++y )
+        {
+            for ( uint32_t x = 0; x < rect.GetWidth(); ++x )
+            {
+                if ( aAtlas.GetBitmap() [ ( rect.GetY() + y ) * aAtlas.GetWidth() + rect.GetX() + x].b != aValue )
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    TEST ( TextureAtlasTest, AddCopiesImagesIntoTheirRegions )
+    {
+        TextureAtlas atlas{32, 32, 1};
+        Image a, b;
+        MakeImage ( a, 8, 4, 10 );
+        MakeImage ( b, 5, 9, 20 );
+        TextureAtlas::Handle handle_a = atlas.Add ( a );
+        TextureAtlas::Handle handle_b = atlas.Add ( b );
+        ASSERT_NE ( handle_a, TextureAtlas::InvalidHandle );
+        ASSERT_NE ( handle_b, TextureAtlas::InvalidHandle );
+        EXPECT_EQ ( atlas.GetRegion ( handle_a ).GetWidth(), 8u );
+        EXPECT_EQ ( atlas.GetRegion ( handle_b ).GetHeight(), 9u );
+        EXPECT_TRUE ( RegionHolds ( atlas, handle_a, 10 ) );
+        EXPECT_TRUE ( RegionHolds ( atlas, handle_b, 20 ) );
+    }
+
+    TEST ( TextureAtlasTest, ImagesMayFillTheWholeAtlas )
+    {
+        TextureAtlas atlas{16, 16, 1};
+        Image image;
+        MakeImage ( image, 16, 16, 30 );
+        EXPECT_NE ( atlas.Add ( image ), TextureAtlas::InvalidHandle );
+    }
+
+    TEST ( TextureAtlasTest, CompactReclaimsRemovedRegions )
+    {
+        TextureAtlas atlas{16, 16, 0};
+        Image half, quarter;
+        MakeImage ( half, 16, 8, 40 );
+        MakeImage ( quarter, 16, 4, 50 );
+        TextureAtlas::Handle first = atlas.Add ( half );
+        TextureAtlas::Handle second = atlas.Add ( quarter );
+        ASSERT_NE ( first, TextureAtlas::InvalidHandle );
+        ASSERT_NE ( second, TextureAtlas::InvalidHandle );
+        EXPECT_EQ ( atlas.Add ( half ), TextureAtlas::InvalidHandle );
+        atlas.Remove ( first );
+        ASSERT_TRUE ( atlas.Compact() );
+        EXPECT_EQ ( atlas.GetRegion ( second ).GetY(), 0 );
+        EXPECT_TRUE ( RegionHolds ( atlas, second, 50 ) );
+        TextureAtlas::Handle third = atlas.Add ( half );
+        ASSERT_NE ( third, TextureAtlas::InvalidHandle );
+        EXPECT_TRUE ( RegionHolds ( atlas, third, 40 ) );
+    }
+
+    TEST ( TextureAtlasTest, SaveAndLoadRoundTrip )
+    {
+        const std::string path = ::testing::TempDir() + "TextureAtlasTest.atlas";
+        TextureAtlas atlas{32, 32, 1};
+        Image image;
+        MakeImage ( image, 6, 7, 60 );
+        TextureAtlas::Handle handle = atlas.Add ( image );
+        ASSERT_TRUE ( atlas.Save ( path.c_str() ) );
+        TextureAtlas loaded{1, 1, 0};
+        ASSERT_TRUE ( loaded.Load ( path.c_str() ) );
+        EXPECT_EQ ( loaded.GetWidth(), 32u );
+        EXPECT_EQ ( loaded.GetRegion ( handle ).GetX(), atlas.GetRegion ( handle ).GetX() );
+        EXPECT_TRUE ( RegionHolds ( loaded, handle, 60 ) );
+        remove ( path.c_str() );
+    }
+
+    TEST ( TextureAtlasTest, LoadRejectsRegionsOutsideTheAtlas )
+    {
+        const std::string path = ::testing::TempDir() + "TextureAtlasTestBad.atlas";
+        TextureAtlas atlas{16, 16, 1};
+        Image image;
+        MakeImage ( image, 4, 4, 70 );
+        ASSERT_NE ( atlas.Add ( image ), TextureAtlas::InvalidHandle );
+        ASSERT_TRUE ( atlas.Save ( path.c_str() ) );
+        {
+            // Move the only region's x, right after the 28 byte header, past the right edge.
+            std::fstream file ( path, std::ios_base::in | std::ios_base::out | std::ios_base::binary );
+            const int32_t x = 13;
+            file.seekp ( 28 );
+            file.write ( reinterpret_cast<const char*> ( &x ), sizeof ( x ) );
+        }
+        TextureAtlas loaded{8, 8, 0};
+        EXPECT_FALSE ( loaded.Load ( path.c_str() ) );
+        EXPECT_EQ ( loaded.GetWidth(), 8u );
+        remove ( path.c_str() );
+    }
+}
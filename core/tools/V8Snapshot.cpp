@@ -0,0 +1,120 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+/*  Build step tool, bakes the AeonGUI global environment and any JavaScript
+    files given on the command line into a V8 startup snapshot
+    and writes it out as a C++ source file to be compiled into the library.
+    Usage: aeongui-v8-snapshot <output.cpp> [script.js ...] */
+
+#include <cstdlib>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <memory>
+#include "libplatform/libplatform.h"
+#include "v8.h"
+#include "JsV8Globals.h"
+
+static bool RunScript ( v8::Isolate* aIsolate, v8::Local<v8::Context> aContext, const char* aFilename )
+{
+    std::ifstream file ( aFilename, std::ios::binary );
+    if ( !file )
+    {
+        std::cerr << "Unable to open " << aFilename << std::endl;
+        return false;
+    }
+    std::stringstream code;
+    code << file.rdbuf();
+    v8::TryCatch try_catch ( aIsolate );
+    v8::ScriptOrigin origin ( aIsolate, v8::String::NewFromUtf8 ( aIsolate, aFilename ).ToLocalChecked() );
+    v8::Local<v8::Script> script;
+    if ( !v8::Script::Compile ( aContext, v8::String::NewFromUtf8 ( aIsolate, code.str().data(), v8::NewStringType::kNormal, static_cast<int> ( code.str().size() ) ).ToLocalChecked(), &origin ).ToLocal ( &script ) ||
+         script->Run ( aContext ).IsEmpty() )
+    {
+        v8::String::Utf8Value error ( aIsolate, try_catch.Exception() );
+        std::cerr << aFilename << ": " << *error << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main ( int argc, char *argv[] )
+{
+    if ( argc < 2 )
+    {
+        std::cerr << "Usage: " << argv[0] << " <output.cpp> [script.js ...]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    v8::V8::InitializeICU();
+    v8::V8::InitializeExternalStartupData ( argv[0] );
+    std::unique_ptr<v8::Platform> platform = v8::platform::NewDefaultPlatform();
+    v8::V8::InitializePlatform ( platform.get() );
+    v8::V8::Initialize();
+
+    bool success{true};
+    v8::StartupData blob{};
+    {
+        v8::SnapshotCreator creator ( AeonGUI::V8ExternalReferences );
+        v8::Isolate* isolate = creator.GetIsolate();
+        {
+            v8::HandleScope handle_scope ( isolate );
+            creator.SetDefaultContext ( v8::Context::New ( isolate ) );
+            v8::Local<v8::Context> context = v8::Context::New ( isolate, nullptr, AeonGUI::CreateV8GlobalTemplate ( isolate ) );
+            {
+                v8::Context::Scope context_scope ( context );
+                AeonGUI::InstallV8Globals ( isolate, context );
+                for ( int i = 2; success && i < argc; ++i )
+                {
+                    success = RunScript ( isolate, context, argv[i] );
+                }
+            }
+            if ( creator.AddContext ( context ) != AeonGUI::V8SnapshotContextIndex )
+            {
+                std::cerr << "Unexpected snapshot context index." << std::endl;
+                success = false;
+            }
+        }
+        // Keep compiled functions so shipped scripts are not compiled again on every isolate.
+        blob = creator.CreateBlob ( v8::SnapshotCreator::FunctionCodeHandling::kKeep );
+    }
+
+    if ( success && blob.data != nullptr )
+    {
+        std::ofstream output ( argv[1] );
+        output << "// Generated by aeongui-v8-snapshot, do not edit.\n"
+               << "namespace AeonGUI\n{\n"
+               << "    extern const char V8StartupSnapshotData[];\n"
+               << "    extern const int V8StartupSnapshotSize;\n"
+               << "    alignas ( 16 ) const char V8StartupSnapshotData[] =\n    {";
+        for ( int i = 0; i < blob.raw_size; ++i )
+        {
+            output << ( ( i % 16 ) ? " " : "\n        " ) << static_cast<int> ( blob.data[i] ) << ",";
+        }
+        output << "\n    };\n"
+               << "    const int V8StartupSnapshotSize = sizeof ( V8StartupSnapshotData );\n"
+               << "}\n";
+        success = output.good();
+    }
+    else
+    {
+        success = false;
+    }
+    delete[] blob.data;
+
+    v8::V8::Dispose();
+    v8::V8::DisposePlatform();
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
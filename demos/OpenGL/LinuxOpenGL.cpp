@@ -455,6 +455,16 @@ bool GLWindow::Create ( Display* dpy )
     float delta;
     while ( running )
     {
+        // Nothing to animate or redraw, sleep until the next event.
+        if ( !mWindow.NeedsFrame() )
+        {
+            // Let scripts collect garbage before going to sleep, unless input is already waiting.
+            if ( XPending ( display ) == 0 )
+            {
+                mWindow.CollectGarbage ( std::chrono::steady_clock::now() + std::chrono::milliseconds{4} );
+            }
+            XPeekEvent ( display, &xEvent );
+        }
         while ( ( XPending ( display ) > 0 ) && running )
         {
             XNextEvent ( display, &xEvent );
@@ -513,17 +523,20 @@ bool GLWindow::Create ( Display* dpy )
         glUseProgram ( mProgram );
         glBindVertexArray ( mVAO );
         glDisable ( GL_DEPTH_TEST );
-        mWindow.Draw();
         glBindTexture ( GL_TEXTURE_2D, mScreenTexture );
-        glTexImage2D ( GL_TEXTURE_2D,
-                       0,
-                       GL_RGBA,
-                       static_cast<GLsizei> ( mWindow.GetWidth() ),
-                       static_cast<GLsizei> ( mWindow.GetHeight() ),
-                       0,
-                       GL_BGRA,
-                       GL_UNSIGNED_INT_8_8_8_8_REV,
-                       mWindow.GetPixels() );
+        if ( mWindow.NeedsFrame() )
+        {
+            mWindow.Draw();
+            glTexImage2D ( GL_TEXTURE_2D,
+                           0,
+                           GL_RGBA,
+                           static_cast<GLsizei> ( mWindow.GetWidth() ),
+                           static_cast<GLsizei> ( mWindow.GetHeight() ),
+                           0,
+                           GL_BGRA,
+                           GL_UNSIGNED_INT_8_8_8_8_REV,
+                           mWindow.GetPixels() );
+        }
         glDrawArrays ( GL_TRIANGLE_FAN, 0, 4 );
 
         glXSwapBuffers ( display, window );
@@ -25,6 +25,7 @@ limitations under the License.
 #include <sstream>
 #include <cassert>
 #include <cstdint>
+#include <chrono>
 #include <crtdbg.h>
 #include "aeongui/AeonGUI.h"
 #include "aeongui/Window.h"
@@ -82,9 +83,12 @@ public:
     LRESULT OnMouseButtonUp ( uint8_t button, int32_t x, int32_t y );
     static LRESULT CALLBACK WindowProc ( HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam );
     static void Register ( HINSTANCE hInstance );
+    bool NeedsFrame() const;
     void RenderLoop();
+    void WaitForMessages();
 private:
     static ATOM atom;
+    void Present();
     void Initialize ( HINSTANCE hInstance, LONG aWidth, LONG aHeight );
     void Finalize();
     HWND hWnd{};
@@ -372,10 +376,6 @@ void Window::RenderLoop()
     {
         delta = 1.0f / 30.0f;
     }
-    glClear ( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
-    glUseProgram ( mProgram );
-    glBindVertexArray ( mVAO );
-    glDisable ( GL_DEPTH_TEST );
     mWindow.Draw();
     glBindTexture ( GL_TEXTURE_2D, mScreenTexture );
     glTexImage2D ( GL_TEXTURE_2D,
@@ -387,9 +387,36 @@ void Window::RenderLoop()
                    GL_BGRA,
                    GL_UNSIGNED_INT_8_8_8_8_REV,
                    mWindow.GetPixels() );
+    Present();
+    last_time = this_time;
+}
+
+bool Window::NeedsFrame() const
+{
+    return mWindow.NeedsFrame();
+}
+
+/*  Nothing to animate or redraw, sleep until the next message.
+    The screen texture still holds the last frame, WM_PAINT presents it again when the window is exposed. */
+void Window::WaitForMessages()
+{
+    // Let scripts collect garbage before going to sleep, unless input is already waiting.
+    if ( HIWORD ( GetQueueStatus ( QS_ALLINPUT ) ) == 0 )
+    {
+        mWindow.CollectGarbage ( std::chrono::steady_clock::now() + std::chrono::milliseconds{4} );
+    }
+    WaitMessage();
+}
+
+void Window::Present()
+{
+    glClear ( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
+    glUseProgram ( mProgram );
+    glBindVertexArray ( mVAO );
+    glDisable ( GL_DEPTH_TEST );
+    glBindTexture ( GL_TEXTURE_2D, mScreenTexture );
     glDrawArrays ( GL_TRIANGLE_FAN, 0, 4 );
     SwapBuffers ( hDC );
-    last_time = this_time;
 }
 
 void Window::Register ( HINSTANCE hInstance )
@@ -497,6 +524,7 @@ LRESULT Window::OnPaint()
     if ( GetUpdateRect ( hWnd, &rect, FALSE ) )
     {
         BeginPaint ( hWnd, &paint );
+        Present();
         EndPaint ( hWnd, &paint );
     }
     return 0;
@@ -586,10 +614,14 @@ int main ( int argc, char *argv[] )
                     DispatchMessage ( &msg );
                 }
             }
-            else
+            else if ( window.NeedsFrame() )
             {
                 window.RenderLoop();
             }
+            else
+            {
+                window.WaitForMessages();
+            }
         }
     }
     assert ( msg.message == WM_QUIT );
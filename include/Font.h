@@ -23,6 +23,7 @@ limitations under the License.
 
 namespace AeonGUI
 {
+    class DistanceFieldAtlas;
     /*! \brief Raster Font class.
         \note This class has to change to accomodate for multiple font formats.
     */
@@ -103,6 +104,13 @@ namespace AeonGUI
             \return pointer to glyph structure or NULL if not found.*/
         Glyph* GetGlyph ( wchar_t charcode );
 
+        /*! \brief Adds every glyph in the font to a distance field atlas.
+            The glyph map is used as high resolution coverage, fonts baked at a multiple
+            of the atlas base size give the most accurate fields.
+            \param atlas Atlas to add the glyphs to.
+            \return false if a glyph did not fit in the atlas.*/
+        bool AddToDistanceField ( DistanceFieldAtlas& atlas ) const;
+
         /*! \brief Get glyph bitmap.
             \return pointer to glyph bitmap buffer.*/
         const uint8_t* GetGlyphMap();
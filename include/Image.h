@@ -18,9 +18,10 @@ limitations under the License.
 #include <stddef.h>
 #include <assert.h>
 #include <string.h>
+#include <atomic>
 #include "aeongui/Platform.h"
-#include "Integer.h"
-#include "Color.h"
+#include <cstdint>
+#include "aeongui/Color.h"
 
 namespace AeonGUI
 {
@@ -86,7 +87,7 @@ namespace AeonGUI
         \return true on success, false otherwise.
         \sa Image::Load
         */
-        bool LoadFromMemory ( uint32_t buffer_size, void* buffer );
+        bool LoadFromMemory ( uint32_t buffer_size, const void* buffer );
 
         /*! \brief Unloads and releases image data from memory.*/
         void Unload (  );
@@ -114,6 +115,40 @@ namespace AeonGUI
         */
         const Color* GetBitmap() const;
 
+        /*!
+        \brief Retrieve a number identifying the current image contents.
+        The number changes every time the image is loaded or unloaded and is never handed out twice in a process,
+        so unlike the object address it can key caches of data derived from the image.
+        \return Generation of the image contents.
+        */
+        uint64_t GetGeneration() const;
+
+        /*!
+        \brief Retrieve a level of the image mip chain.
+        Level 0 is the bitmap itself, each following level halves the previous one with a 2x2 box filter
+        down to a single pixel. Levels above 0 are built on the first request and kept in one contiguous buffer.
+        \param level Requested level, clamped to the last one.
+        \param level_width [out] Width of the returned level.
+        \param level_height [out] Height of the returned level.
+        \return Pointer to the level pixels or NULL if no image is loaded.
+        */
+        const Color* GetMipLevel ( uint32_t level, uint32_t& level_width, uint32_t& level_height ) const;
+
+        /*!
+        \brief Retrieve the number of levels in the full mip chain, including level 0.
+        \return Level count, zero if no image is loaded.
+        */
+        uint32_t GetMipLevelCount() const;
+
+        /*!
+        \brief Pick the mip level to sample when drawing the image scaled down.
+        The returned level is the smallest one that is still at least as large as the drawn size,
+        so minification never skips source pixels by more than a factor of two.
+        \param scale Drawn size divided by image size.
+        \return Level index for GetMipLevel, 0 for scales of 1 or more.
+        */
+        uint32_t GetMipLevelForScale ( float scale ) const;
+
         /*!
         \brief Retrieve Starting X coordinate for patch 9 stretch area.
         \return The starting X coordinate for patch 9 stretching.
@@ -205,6 +240,15 @@ namespace AeonGUI
         int32_t GetYCoordForHeight ( Alignment valign, uint32_t height, uint32_t drawheight = 0 ) const;
 
     private:
+        /*!
+        \brief Finds the patch 9 guides in the outer frame of raw image data.
+        \param bpp Bytes per pixel of the data, 3 or 4.
+        \param alpha Whether the fourth byte of each pixel is alpha and must match the guide colors.
+        \return true if the image has a patch 9 frame that should be cropped.
+        */
+        bool FindPatch9Frame ( uint32_t image_width, uint32_t image_height, uint32_t bpp, bool alpha, const uint8_t* data );
+        /*! \brief Removes the one pixel guide frame from the loaded bitmap in place. */
+        void CropPatch9Frame();
         uint32_t width;
         uint32_t height;
         uint32_t stretchxstart;     ///< Patch 9 start stretch coordinate.
@@ -216,6 +260,8 @@ namespace AeonGUI
         uint32_t padystart;         ///< Patch 9 start fill coordinate.
         uint32_t padyend;    ///< Patch 9 end fill coordinate.
         Color* bitmap;
+        mutable std::atomic<Color*> mipmaps; ///< Mip levels 1 and up, built on demand.
+        uint64_t generation; ///< Changes with every load and unload.
     };
 }
 #endif
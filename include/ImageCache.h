@@ -0,0 +1,77 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGUI_IMAGECACHE_H
+#define AEONGUI_IMAGECACHE_H
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <memory>
+#include "aeongui/Platform.h"
+#include "Image.h"
+
+namespace AeonGUI
+{
+    /*! \brief Shared cache of decoded images keyed by file path or resource name.
+        Images are handed out as shared immutable handles. Entries nobody holds
+        a handle to are evicted least recently used first whenever the byte budget is exceeded,
+        which includes the moment the last handle to an entry is released.
+        Handles keep their image alive even if they outlive the cache.
+    */
+    class DLL ImageCache
+    {
+    public:
+        using Handle = std::shared_ptr<const Image>;
+        /// Cache counters, bytes and entries reflect the current contents.
+        struct Statistics
+        {
+            size_t hits{};
+            size_t misses{};
+            size_t evictions{};
+            size_t bytes{};
+            size_t entries{};
+        };
+        /*!
+        \brief Constructs a cache.
+        \param aBudget Maximum number of bitmap bytes kept for unreferenced images.
+        */
+        ImageCache ( size_t aBudget = 16 * 1024 * 1024 );
+        ~ImageCache();
+        ImageCache ( const ImageCache& ) = delete;
+        ImageCache& operator= ( const ImageCache& ) = delete;
+        /*!
+        \brief Returns the image for a file, loading it on a miss.
+        \return Shared handle or an empty handle if the file could not be loaded.
+        */
+        Handle GetFromFile ( const std::string& aPath );
+        /*!
+        \brief Returns the image for an embedded resource such as the glyphs in core/resources, decoding it on a miss.
+        \param aName Resource name, resource names live in their own key space and never collide with paths.
+        \return Shared handle or an empty handle if the data could not be loaded.
+        */
+        Handle GetFromResource ( const std::string& aName, uint32_t aWidth, uint32_t aHeight, Image::Format aFormat, const void* aData );
+        /// Changes the byte budget, evicting right away if the cache is now over it.
+        void SetBudget ( size_t aBudget );
+        size_t GetBudget() const;
+        /// Drops every unreferenced entry regardless of budget.
+        void Purge();
+        Statistics GetStatistics() const;
+    private:
+        /// Cache contents live apart from the cache so released handles can find them without outliving them.
+        struct State;
+        std::shared_ptr<State> mState;
+    };
+}
+#endif
@@ -0,0 +1,99 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGUI_NINEPATCHCACHE_H
+#define AEONGUI_NINEPATCHCACHE_H
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <list>
+#include <vector>
+#include <unordered_map>
+#include "aeongui/Platform.h"
+#include "aeongui/Resampler.h"
+#include "Image.h"
+
+namespace AeonGUI
+{
+    /*! \brief Composes 9 patch images at a given size and keeps the results.
+        Results are keyed by image generation, size and scale in a bounded LRU, so reloading
+        an image, or a new image taking the address of a destroyed one, never hits stale results. When an image
+        is requested at a new size, the corners of an existing result at the same
+        scale are reused and only the edges and center are resampled.
+    */
+    class DLL NinePatchCache
+    {
+    public:
+        /// A composed bitmap, rows are tightly packed.
+        struct Bitmap
+        {
+            uint32_t width{};
+            uint32_t height{};
+            std::vector<Color> pixels{};
+        };
+        using Handle = std::shared_ptr<const Bitmap>;
+        /*!
+        \brief Constructs a cache.
+        \param aCapacity Maximum number of composed bitmaps kept.
+        \param aFilter Filter used to stretch edges and center.
+        */
+        NinePatchCache ( size_t aCapacity = 64, ResampleFilter aFilter = ResampleFilter::BILINEAR );
+        ~NinePatchCache();
+        /*!
+        \brief Returns the image composed at a size, rendering it on a miss.
+        Images without a 9 patch frame are scaled as a whole, starting from their mip chain when shrunk by half or more.
+        \param aScale Scale applied to the fixed corners, such as the UI scale factor.
+        */
+        Handle Get ( const Image& aImage, uint32_t aWidth, uint32_t aHeight, double aScale = 1.0 );
+        /// Drops every result composed from the current contents of an image, stale results otherwise age out of the LRU.
+        void Forget ( const Image& aImage );
+        void Clear();
+        size_t GetHits() const;
+        size_t GetMisses() const;
+    private:
+        struct Key
+        {
+            uint64_t generation;
+            uint32_t width;
+            uint32_t height;
+            double scale;
+            bool operator== ( const Key& aKey ) const
+            {
+                return generation == aKey.generation && width == aKey.width && height == aKey.height && scale == aKey.scale;
+            }
+        };
+        struct KeyHash
+        {
+            size_t operator() ( const Key& aKey ) const;
+        };
+        struct Entry
+        {
+            Handle bitmap;
+            std::list<Key>::iterator lru;
+        };
+        Handle Render ( const Image& aImage, uint32_t aWidth, uint32_t aHeight, double aScale ) const;
+        const Bitmap* FindSibling ( const Image& aImage, double aScale ) const;
+        mutable std::mutex mMutex{};
+        std::unordered_map<Key, Entry, KeyHash> mEntries{};
+        /// Keys in use order, most recently used first.
+        std::list<Key> mLru{};
+        size_t mCapacity{};
+        ResampleFilter mFilter{};
+        size_t mHits{};
+        size_t mMisses{};
+    };
+}
+#endif
@@ -0,0 +1,88 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGUI_TEXTUREATLAS_H
+#define AEONGUI_TEXTUREATLAS_H
+#include <cstdint>
+#include <vector>
+#include "aeongui/Platform.h"
+#include "aeongui/Rect.h"
+#include "aeongui/AtlasPacker.h"
+#include "Image.h"
+
+namespace AeonGUI
+{
+    /*! \brief Packs many small images into a single bitmap.
+        Images are copied into sub rectangles of one shared bitmap so they can
+        be composited from a single source. Handles stay valid across compaction.
+    */
+    class DLL TextureAtlas
+    {
+    public:
+        using Handle = uint32_t;
+        static constexpr Handle InvalidHandle = UINT32_MAX;
+        /*!
+        \brief Constructs an empty atlas.
+        \param aWidth Atlas bitmap width.
+        \param aHeight Atlas bitmap height.
+        \param aPadding Transparent pixels kept between images to avoid bleeding when filtering.
+        */
+        TextureAtlas ( uint32_t aWidth = 1024, uint32_t aHeight = 1024, uint32_t aPadding = 1 );
+        ~TextureAtlas();
+        /*!
+        \brief Copies an image into the atlas.
+        \return Handle to the image region or InvalidHandle if there is no room left.
+        */
+        Handle Add ( const Image& aImage );
+        /// Releases the region of an image, its space is reclaimed on Compact.
+        void Remove ( Handle aHandle );
+        /// Region of the atlas bitmap holding the image for the handle.
+        const Rect& GetRegion ( Handle aHandle ) const;
+        /*!
+        \brief Repacks the remaining images, tallest first, to reclaim space left by removed ones.
+        \return false if the images could not be repacked, in which case the atlas is left untouched.
+        */
+        bool Compact();
+        uint32_t GetWidth() const;
+        uint32_t GetHeight() const;
+        const Color* GetBitmap() const;
+        /// Fraction of the atlas area in use, including space held by removed images until compaction.
+        double GetOccupancy() const;
+        /*!
+        \brief Writes the bitmap and region table into a single file.
+        \return true on success, false otherwise.
+        */
+        bool Save ( const char* aFilename ) const;
+        /*!
+        \brief Loads an atlas written by Save, the file is mapped and read in one pass.
+        \return true on success, false otherwise.
+        */
+        bool Load ( const char* aFilename );
+    private:
+        struct Region
+        {
+            Rect rect;
+            uint32_t used;
+        };
+        void Blit ( const Color* aSource, uint32_t aSourceWidth, const Rect& aSourceRect, int32_t aX, int32_t aY );
+        AtlasPacker mPacker;
+        std::vector<Color> mBitmap{};
+        std::vector<Region> mRegions{};
+        std::vector<Handle> mFreeHandles{};
+        /// Set after Load, the packer knows nothing of the loaded regions until they are repacked.
+        bool mNeedsRepack{};
+    };
+}
+#endif
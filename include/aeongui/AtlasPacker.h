@@ -0,0 +1,68 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGUI_ATLASPACKER_H
+#define AEONGUI_ATLASPACKER_H
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "aeongui/Platform.h"
+#include "aeongui/Rect.h"
+
+namespace AeonGUI
+{
+    /*! \brief Skyline bottom-left rectangle packer.
+        Keeps the top edge of the packed area as a list of horizontal segments
+        and places each rectangle where its top ends up lowest.
+    */
+    class AtlasPacker
+    {
+    public:
+        /*! \brief Constructs an empty packer.
+            \param aWidth Width of the area to pack into.
+            \param aHeight Height of the area to pack into.
+            \param aPadding Empty pixels kept between rectangles, rectangles may touch the area edges.
+        */
+        DLL AtlasPacker ( uint32_t aWidth, uint32_t aHeight, uint32_t aPadding = 1 );
+        /*! \brief Finds room for a rectangle.
+            \param aWidth Rectangle width, without padding.
+            \param aHeight Rectangle height, without padding.
+            \param aRect [out] Placed rectangle, without padding.
+            \return false if the rectangle does not fit.
+        */
+        DLL bool Insert ( uint32_t aWidth, uint32_t aHeight, Rect& aRect );
+        /// Forgets all placed rectangles.
+        DLL void Reset();
+        DLL uint32_t GetWidth() const;
+        DLL uint32_t GetHeight() const;
+        DLL uint32_t GetPadding() const;
+        /// Fraction of the area covered by placed rectangles, padding included.
+        DLL double GetOccupancy() const;
+    private:
+        struct Segment
+        {
+            uint32_t x;
+            uint32_t y;
+            uint32_t width;
+        };
+        bool Fit ( size_t aIndex, uint32_t aWidth, uint32_t aHeight, uint32_t& aY ) const;
+        uint32_t mWidth{};
+        uint32_t mHeight{};
+        uint32_t mPadding{};
+        uint64_t mUsedArea{};
+        std::vector<Segment> mSkyline{};
+    };
+}
+#endif
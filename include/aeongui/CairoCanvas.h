@@ -37,6 +37,7 @@ namespace AeonGUI
         size_t GetStride() const final;
         void Clear() final;
         void Draw ( const Path& ) final;
+        void Draw ( const GlyphRun& ) final;
         void SetFillColor ( const ColorAttr& aColor ) final;
         const ColorAttr& GetFillColor() const final;
         void SetStrokeColor ( const ColorAttr& aColor ) final;
@@ -51,6 +52,7 @@ namespace AeonGUI
         double GetOpacity () const final;
         DLL ~CairoCanvas() final;
     private:
+        void FillAndStroke();
         cairo_surface_t* mCairoSurface{};
         cairo_t* mCairoContext{};
         ColorAttr mFillColor{};
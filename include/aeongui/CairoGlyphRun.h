@@ -0,0 +1,44 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGUI_CAIROGLYPHRUN_H
+#define AEONGUI_CAIROGLYPHRUN_H
+#include <vector>
+#include <cairo.h>
+#include "aeongui/GlyphRun.h"
+
+namespace AeonGUI
+{
+    /** Cairo glyph run, glyph ids and positions are computed once on Construct
+     *  so drawing only hands the cached array to cairo_show_glyphs. */
+    class CairoGlyphRun : public GlyphRun
+    {
+    public:
+        CairoGlyphRun();
+        CairoGlyphRun ( const CairoGlyphRun& ) = delete;
+        CairoGlyphRun& operator= ( const CairoGlyphRun& ) = delete;
+        void Construct ( const std::string& aText, const std::string& aFontFamily, double aFontSize, bool aBold, double aX, double aY ) final;
+        double GetAdvance() const final;
+        ~CairoGlyphRun() final;
+        cairo_scaled_font_t* GetScaledFont() const;
+        const std::vector<cairo_glyph_t>& GetGlyphs() const;
+    private:
+        void Release();
+        cairo_scaled_font_t* mScaledFont{};
+        std::vector<cairo_glyph_t> mGlyphs{};
+        double mAdvance{};
+    };
+}
+#endif
@@ -0,0 +1,40 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGUI_CAIROGRADIENT_H
+#define AEONGUI_CAIROGRADIENT_H
+#include <cairo.h>
+#include "aeongui/Gradient.h"
+
+namespace AeonGUI
+{
+    /** Cairo gradient paint server,
+     *  the cairo pattern is built once on Construct and reused on every draw. */
+    class CairoGradient : public Gradient
+    {
+    public:
+        CairoGradient();
+        void ConstructLinear ( double x1, double y1, double x2, double y2, const std::vector<ColorStop>& aStops, Units aUnits, Spread aSpread ) final;
+        void ConstructRadial ( double cx, double cy, double r, double fx, double fy, const std::vector<ColorStop>& aStops, Units aUnits, Spread aSpread ) final;
+        Units GetUnits() const final;
+        ~CairoGradient() final;
+        cairo_pattern_t* GetCairoPattern() const;
+    private:
+        void SetColorStops ( const std::vector<ColorStop>& aStops, Spread aSpread );
+        cairo_pattern_t* mPattern{};
+        Units mUnits{OBJECT_BOUNDING_BOX};
+    };
+}
+#endif
@@ -25,6 +25,7 @@ limitations under the License.
 namespace AeonGUI
 {
     class Path;
+    class GlyphRun;
     class Canvas
     {
     public:
@@ -47,6 +48,7 @@ namespace AeonGUI
         virtual void SetOpacity ( double aWidth ) = 0;
         virtual double GetOpacity () const = 0;
         virtual void Draw ( const Path& ) = 0;
+        virtual void Draw ( const GlyphRun& ) = 0;
         DLL virtual ~Canvas() = 0;
     };
 }
@@ -17,7 +17,8 @@ limitations under the License.
 #define AEONGUI_COLOR_H
 #include <string>
 #include <cstdint>
-#include <regex>
+#include <string_view>
+#include <functional>
 #include <variant>
 #include "aeongui/Platform.h"
 namespace AeonGUI
@@ -182,13 +183,15 @@ namespace AeonGUI
     */
     union Color
     {
-        DLL static const std::regex ColorRegex;
         DLL Color();
         /*! \brief 32 bit Unsigned integer constructor.
             \param value 32 bit color value.
         */
         DLL explicit Color ( uint32_t value );
 
+        /*! \brief String constructor, surrounding whitespace is ignored.
+            \param value Hex color or CSS3 color keyword, anything else yields a zero color.
+        */
         DLL Color ( const std::string& value );
         /*! \brief 4 8 bit Unsigned integer component constructor.
             \param A Alpha color value.
@@ -204,6 +207,18 @@ namespace AeonGUI
             \param src Incomming source color.*/
         DLL void Blend ( Color src );
 
+        /*! \brief Parses a color value without allocating.
+            Accepts #RGB, #RRGGBB, #AARRGGBB and the CSS3 color keywords,
+            keywords are resolved through a compile time perfect hash table.
+            \param aValue String to parse, it must not have surrounding whitespace.
+            \param aColor Receives the color, it is left untouched if aValue is not a color.
+            \return true if aValue is a color, false otherwise.*/
+        DLL static bool Parse ( std::string_view aValue, Color& aColor );
+
+        /*! \brief Calls aEnumerator with each keyword Parse accepts.
+            \param aEnumerator Returns false to stop the enumeration.*/
+        DLL static void EnumerateKeywords ( const std::function<bool ( std::string_view ) >& aEnumerator );
+
         DLL double R() const;
         DLL double G() const;
         DLL double B() const;
@@ -225,9 +240,11 @@ namespace AeonGUI
 #endif
         };
     };
+    class Gradient;
     /// Alias monostate to none.
     using none = std::monostate;
-    /// A special color type that distinguishes when no color is set.
-    using ColorAttr = std::variant<none, Color>;
+    /** A special color type that distinguishes when no color is set,
+     *  it may also hold a gradient paint server resolved from a url(#id) reference. */
+    using ColorAttr = std::variant<none, Color, const Gradient*>;
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,84 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGUI_COMMANDQUEUE_H
+#define AEONGUI_COMMANDQUEUE_H
+#include <atomic>
+#include <optional>
+#include <utility>
+
+namespace AeonGUI
+{
+    /** Unbounded lock free queue for any number of producer threads and a single consumer thread.
+     *
+     *  Push never blocks or spins, it is an allocation, an exchange and a store.
+     *  Pop and Empty must only be called from the consumer thread.
+     *  A push that is still in progress may not be visible to Pop yet,
+     *  the consumer will see it on its next call. */
+    template<class T> class CommandQueue
+    {
+    public:
+        CommandQueue() = default;
+        CommandQueue ( const CommandQueue& ) = delete;
+        CommandQueue& operator= ( const CommandQueue& ) = delete;
+        ~CommandQueue()
+        {
+            while ( Pop() )
+            {
+            }
+            if ( mTail != &mStub )
+            {
+                delete mTail;
+            }
+        }
+        void Push ( T&& aValue )
+        {
+            Node* node = new Node{std::move ( aValue ) };
+            Node* previous = mHead.exchange ( node, std::memory_order_acq_rel );
+            previous->next.store ( node, std::memory_order_release );
+        }
+        std::optional<T> Pop()
+        {
+            Node* next = mTail->next.load ( std::memory_order_acquire );
+            if ( next == nullptr )
+            {
+                return std::nullopt;
+            }
+            // The popped node becomes the new dummy tail.
+            std::optional<T> value{std::move ( next->value ) };
+            next->value.reset();
+            if ( mTail != &mStub )
+            {
+                delete mTail;
+            }
+            mTail = next;
+            return value;
+        }
+        bool Empty() const
+        {
+            return mTail->next.load ( std::memory_order_acquire ) == nullptr;
+        }
+    private:
+        struct Node
+        {
+            std::optional<T> value{};
+            std::atomic<Node*> next{};
+        };
+        Node mStub{};
+        std::atomic<Node*> mHead{&mStub};
+        Node* mTail{&mStub};
+    };
+}
+#endif
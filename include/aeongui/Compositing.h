@@ -0,0 +1,61 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGUI_COMPOSITING_H
+#define AEONGUI_COMPOSITING_H
+#include <cstdint>
+#include <cstddef>
+#include "aeongui/Platform.h"
+#include "aeongui/Color.h"
+
+namespace AeonGUI
+{
+    /// How the color components of a source buffer relate to its alpha.
+    enum class AlphaMode
+    {
+        /// Components are independent of alpha, as produced by image loaders.
+        STRAIGHT,
+        /// Components are already multiplied by alpha, as produced by cairo.
+        PREMULTIPLIED
+    };
+
+    /*! \brief Source-over blends a row of pixels into a destination row.
+        Straight sources compute D = S * a + D * (1 - a) for color and a + D.a * (1 - a) for alpha,
+        premultiplied sources compute D = S + D * (1 - a) for every component.
+        Uses SSE2, AVX2 or NEON kernels when the running processor supports them,
+        results are bit exact with the scalar path.
+        \param aSource Source pixels.
+        \param aDestination Destination pixels, blended in place.
+        \param aCount Number of pixels.
+        \param aMode Alpha mode of the source pixels.
+        \param aOpacity Constant opacity the source is modulated with.
+    */
+    DLL void BlendRow ( const Color* aSource, Color* aDestination, size_t aCount, AlphaMode aMode, uint8_t aOpacity = 255 );
+
+    /*! \brief Source-over blends a rectangle of pixels.
+        \param aSourcePitch Distance in bytes between source rows.
+        \param aDestinationPitch Distance in bytes between destination rows.
+        \sa BlendRow
+    */
+    DLL void Blend ( const Color* aSource, size_t aSourcePitch, Color* aDestination, size_t aDestinationPitch,
+                     uint32_t aWidth, uint32_t aHeight, AlphaMode aMode, uint8_t aOpacity = 255 );
+
+    /*! \brief Source-over blends a solid color into a rectangle, opaque colors are stored directly.
+        \param aDestinationPitch Distance in bytes between destination rows.
+        \sa BlendRow
+    */
+    DLL void Fill ( Color aColor, Color* aDestination, size_t aDestinationPitch, uint32_t aWidth, uint32_t aHeight, AlphaMode aMode );
+}
+#endif
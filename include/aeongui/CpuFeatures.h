@@ -0,0 +1,54 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGUI_CPUFEATURES_H
+#define AEONGUI_CPUFEATURES_H
+#include <cstdint>
+#include "aeongui/Platform.h"
+
+/*  Vector kernels are compiled per function with the target attribute
+    so the library itself does not require any instruction set beyond the
+    compiler default, the right kernel is picked at runtime. */
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define AEONGUI_X86 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define AEONGUI_NEON 1
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define AEONGUI_TARGET(x) __attribute__((target(x)))
+#else
+#define AEONGUI_TARGET(x)
+#endif
+
+namespace AeonGUI
+{
+    enum CpuFeature : uint32_t
+    {
+        CPU_SSE2 = 1 << 0,
+        CPU_SSSE3 = 1 << 1,
+        CPU_SSE41 = 1 << 2,
+        CPU_AVX2 = 1 << 3,
+        CPU_NEON = 1 << 4,
+    };
+    /** Returns a bit mask of CpuFeature values supported by the running processor,
+     *  detection is done once on first call. */
+    DLL uint32_t GetCpuFeatures();
+    inline bool HasCpuFeature ( CpuFeature aFeature )
+    {
+        return ( GetCpuFeatures() & aFeature ) == aFeature;
+    }
+}
+#endif
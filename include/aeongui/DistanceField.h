@@ -0,0 +1,109 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGUI_DISTANCEFIELD_H
+#define AEONGUI_DISTANCEFIELD_H
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "aeongui/Platform.h"
+#include "aeongui/Color.h"
+#include "aeongui/Rect.h"
+#include "aeongui/AtlasPacker.h"
+
+namespace AeonGUI
+{
+    /*! \brief Converts a coverage bitmap into a signed distance field.
+        Coverage is thresholded at half and run through an exact Euclidean distance transform,
+        each field texel takes the distance at the center of the coverage block it covers.
+        Field values encode the distance to the outline, 128 on the edge, 255 at aSpread field texels inside
+        and 0 at aSpread field texels outside.
+        \param aCoverage 8 bit coverage, aFieldWidth * aOversample by aFieldHeight * aOversample texels.
+        \param aCoveragePitch Distance in bytes between coverage rows.
+        \param aField [out] 8 bit distance field.
+        \param aFieldPitch Distance in bytes between field rows.
+        \param aOversample Coverage texels per field texel along each axis.
+        \param aSpread Distance in field texels mapped to the full value range on each side of the edge.
+    */
+    DLL void GenerateDistanceField ( const uint8_t* aCoverage, size_t aCoveragePitch,
+                                     uint8_t* aField, size_t aFieldPitch, uint32_t aFieldWidth, uint32_t aFieldHeight,
+                                     uint32_t aOversample, float aSpread );
+
+    /*! \brief Glyph atlas holding one distance field per glyph.
+        Fields are generated once at a base size and sampled at any size when drawing,
+        so a single atlas serves every text size, zoom level and DPI.
+    */
+    class DistanceFieldAtlas
+    {
+    public:
+        /// Glyph placement, in base size pixels.
+        struct Glyph
+        {
+            Rect region{};      ///< Field inside the atlas, spread border included.
+            float left{};       ///< Offset from the pen position to the left edge of the field.
+            float top{};        ///< Offset from the baseline up to the top edge of the field.
+            float advance{};    ///< Horizontal pen advance.
+        };
+        /*! \brief Constructs an empty atlas.
+            \param aBaseSize Pixel size fields are generated at, sizes up to a few times larger stay sharp.
+            \param aSpread Distance field spread in base size pixels, also the border around each glyph.
+        */
+        DLL DistanceFieldAtlas ( uint32_t aWidth, uint32_t aHeight, uint32_t aBaseSize, uint32_t aSpread = 4 );
+        /*! \brief Generates and stores the field for a glyph.
+            \param aCodepoint Unicode code point the glyph is looked up by.
+            \param aCoverage 8 bit glyph coverage rendered at aBaseSize * aOversample pixels.
+            \param aPitch Distance in bytes between coverage rows.
+            \param aWidth Coverage width.
+            \param aHeight Coverage height.
+            \param aLeft Offset from the pen position to the left of the coverage, in coverage pixels.
+            \param aTop Offset from the baseline up to the top of the coverage, in coverage pixels.
+            \param aAdvance Horizontal pen advance in coverage pixels.
+            \param aOversample Ratio between the coverage resolution and the base size, higher is more precise.
+            \return false if the glyph does not fit in the atlas.
+        */
+        DLL bool Add ( uint32_t aCodepoint, const uint8_t* aCoverage, size_t aPitch, uint32_t aWidth, uint32_t aHeight,
+                       int32_t aLeft, int32_t aTop, float aAdvance, uint32_t aOversample );
+        DLL const Glyph* GetGlyph ( uint32_t aCodepoint ) const;
+        /*! \brief Draws a line of text.
+            Fields are sampled bilinearly and turned into coverage with a one pixel wide ramp
+            on the outline, then blended with the straight alpha compositing kernels.
+            \param aText UTF-32 text, code points without a glyph are skipped.
+            \param aX Pen start position.
+            \param aY Baseline position.
+            \param aSize Text size in pixels.
+            \param aDestinationPitch Distance in bytes between destination rows.
+            \return Pen position after the last glyph.
+        */
+        DLL float DrawText ( std::u32string_view aText, float aX, float aY, float aSize, Color aColor,
+                             Color* aDestination, size_t aDestinationPitch, uint32_t aDestinationWidth, uint32_t aDestinationHeight ) const;
+        /// 8 bit distance field atlas, GetWidth bytes per row.
+        DLL const uint8_t* GetBitmap() const;
+        DLL uint32_t GetWidth() const;
+        DLL uint32_t GetHeight() const;
+        DLL uint32_t GetBaseSize() const;
+        DLL uint32_t GetSpread() const;
+    private:
+        void DrawGlyph ( const Glyph& aGlyph, float aX, float aY, float aScale, Color aColor,
+                         Color* aDestination, size_t aDestinationPitch, uint32_t aDestinationWidth, uint32_t aDestinationHeight ) const;
+        AtlasPacker mPacker;
+        uint32_t mBaseSize{};
+        uint32_t mSpread{};
+        std::vector<uint8_t> mBitmap{};
+        std::unordered_map<uint32_t, Glyph> mGlyphs{};
+    };
+}
+#endif
@@ -19,6 +19,9 @@ limitations under the License.
 #include <vector>
 #include <memory>
 #include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include "aeongui/Platform.h"
 #include "aeongui/Canvas.h"
 #include "aeongui/JavaScript.h"
@@ -26,20 +29,74 @@ limitations under the License.
 
 namespace AeonGUI
 {
+    class Element;
     class Document
     {
     public:
         DLL Document();
         DLL Document ( const std::string& aFilename );
         DLL ~Document();
+        Document ( const Document& ) = delete;
+        Document& operator= ( const Document& ) = delete;
         DLL void Draw ( Canvas& aCanvas ) const;
         DLL void Load ( JavaScript& aJavascript );
         DLL void Unload ( JavaScript& aJavascript );
         /**DOM Properties and Methods @{*/
         DLL Node* documentElement();
+        DLL Element* getElementById ( const std::string& aElementId ) const;
+        /** Creates an element that belongs to no tree until it is added to one,
+         *  elements never added to the tree are deleted along with the document.
+         *  @return nullptr for namespaces other than SVG. */
+        DLL Element* createElementNS ( const std::string& aNamespace, const std::string& aQualifiedName );
         /**@}*/
+        /** Queues an attribute write on an element of this document,
+         *  queued writes are applied together by ApplyPendingAttributes. */
+        DLL void QueueAttribute ( Element* aElement, const std::string& aName, const std::string& aValue );
+        /** Finds the last value queued for an attribute.
+         *  @return nullptr if no write to the attribute is pending. */
+        DLL const std::string* GetPendingAttribute ( const Element* aElement, const std::string& aName ) const;
+        /** Applies every queued attribute write,
+         *  each changed element is notified once no matter how many of its attributes changed. */
+        DLL void ApplyPendingAttributes();
+        /** @return true if attribute writes are waiting for ApplyPendingAttributes. */
+        DLL bool HasPendingAttributes() const;
     private:
+        friend class Node;
+        friend class Element;
+        void AddToIndex ( Element* aElement );
+        void RemoveFromIndex ( Element* aElement );
+        void DropPendingAttributes ( const Element* aElement );
+        void ForgetCreatedElement ( Element* aElement );
+        struct PendingAttribute
+        {
+            Element* element;
+            std::string name;
+            std::string value;
+        };
+        struct PendingKey
+        {
+            const Element* element;
+            std::string name;
+            bool operator== ( const PendingKey& aKey ) const
+            {
+                return element == aKey.element && name == aKey.name;
+            }
+        };
+        struct PendingKeyHash
+        {
+            size_t operator() ( const PendingKey& aKey ) const
+            {
+                return std::hash<const Element*> {} ( aKey.element ) ^ ( std::hash<std::string> {} ( aKey.name ) << 1 );
+            }
+        };
         Node* mDocumentElement{};
+        std::unordered_map<std::string, std::vector<Element*>> mIdIndex{};
+        /// One write per element and attribute, in the order they were first queued.
+        std::vector<PendingAttribute> mPendingAttributes{};
+        /// Position of each write in mPendingAttributes.
+        std::unordered_map<PendingKey, size_t, PendingKeyHash> mPendingIndex{};
+        /// Elements from createElementNS that have not been added to the tree.
+        std::unordered_set<Element*> mCreatedElements{};
     };
 }
 #endif
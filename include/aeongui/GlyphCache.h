@@ -0,0 +1,133 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGUI_GLYPHCACHE_H
+#define AEONGUI_GLYPHCACHE_H
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "aeongui/Platform.h"
+#include "aeongui/Rect.h"
+#include "aeongui/ShelfPacker.h"
+
+typedef struct FT_FaceRec_* FT_Face;
+
+namespace AeonGUI
+{
+    /*! \brief Dynamic glyph atlas filled through FreeType on first use.
+        Glyphs are keyed by face, pixel size, glyph index and quantized subpixel offset,
+        and packed into an 8 bit coverage atlas. When the atlas is full the least recently
+        used glyphs are evicted, except those used since the last BeginFrame, so large
+        character sets only cost memory for the glyphs actually on screen.
+        FreeType faces are not thread safe, neither is the cache.
+    */
+    class GlyphCache
+    {
+    public:
+        /// A rasterized glyph.
+        struct Glyph
+        {
+            Rect region{};      ///< Glyph coverage inside the atlas, empty for blank glyphs.
+            int32_t left{};     ///< Offset from the pen position to the left edge of the coverage.
+            int32_t top{};      ///< Offset from the baseline up to the top edge of the coverage.
+            float advance{};    ///< Horizontal pen advance in pixels.
+        };
+        /*! \brief Constructs an empty cache.
+            \param aWidth Atlas width.
+            \param aHeight Atlas height.
+            \param aSubpixelSteps Number of horizontal subpixel positions rasterized per glyph.
+        */
+        DLL GlyphCache ( uint32_t aWidth = 1024, uint32_t aHeight = 1024, uint32_t aSubpixelSteps = 4 );
+        DLL ~GlyphCache();
+        GlyphCache ( const GlyphCache& ) = delete;
+        GlyphCache& operator= ( const GlyphCache& ) = delete;
+        /*! \brief Finds or rasterizes a glyph.
+            The returned pointer stays valid at least until the next call to BeginFrame.
+            \param aFace FreeType face, its pixel size is changed by the call.
+            \param aPixelSize Nominal glyph height in pixels.
+            \param aGlyphIndex Glyph index in the face, see FT_Get_Char_Index.
+            \param aSubpixelOffset Fractional horizontal pen position in [0,1).
+            \return The glyph, or nullptr if it could not be rasterized or the atlas is full of glyphs used this frame.
+        */
+        DLL const Glyph* Get ( FT_Face aFace, uint32_t aPixelSize, uint32_t aGlyphIndex, float aSubpixelOffset = 0.0f );
+        /*! \brief Maps a code point to a glyph index through the face's selected charmap.
+            Lookups are memoized per face: the Basic Multilingual Plane is kept in 256 entry pages,
+            allocated the first time a code point in them is requested, so Latin-1 text reads a single
+            table, and code points past it go through a hash map.
+            \param aFace FreeType face.
+            \param aCodePoint Unicode code point.
+            \return Glyph index for Get, 0 if the face has no glyph for the code point.
+        */
+        DLL uint32_t GetGlyphIndex ( FT_Face aFace, char32_t aCodePoint );
+        /*! \brief Starts a new frame, glyphs used before this call become candidates for eviction. */
+        DLL void BeginFrame();
+        /*! \brief Drops every cached glyph and glyph index, for example when a face is destroyed. */
+        DLL void Clear();
+        /// 8 bit coverage atlas, GetWidth bytes per row.
+        DLL const uint8_t* GetBitmap() const;
+        DLL uint32_t GetWidth() const;
+        DLL uint32_t GetHeight() const;
+        DLL size_t GetGlyphCount() const;
+        DLL size_t GetHits() const;
+        DLL size_t GetMisses() const;
+        DLL size_t GetEvictions() const;
+    private:
+        struct Key
+        {
+            FT_Face face;
+            uint32_t size;
+            uint32_t index;
+            uint32_t subpixel;
+            bool operator== ( const Key& aKey ) const
+            {
+                return face == aKey.face && size == aKey.size && index == aKey.index && subpixel == aKey.subpixel;
+            }
+        };
+        struct KeyHash
+        {
+            size_t operator() ( const Key& aKey ) const;
+        };
+        struct Entry
+        {
+            Key key;
+            Glyph glyph;
+            uint64_t frame;
+        };
+        /// Memoized code point to glyph index table of one face.
+        struct CharMap
+        {
+            std::array<std::unique_ptr<uint32_t[]>, 256> pages{};
+            std::unordered_map<char32_t, uint32_t> astral{};
+        };
+        bool Rasterize ( const Key& aKey, Glyph& aGlyph );
+        void Evict();
+        std::vector<uint8_t> mBitmap{};
+        ShelfPacker mPacker;
+        uint32_t mSubpixelSteps{};
+        uint64_t mFrame{};
+        /// Most recently used first.
+        std::list<Entry> mEntries{};
+        std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> mIndex{};
+        std::unordered_map<FT_Face, CharMap> mCharMaps{};
+        size_t mHits{};
+        size_t mMisses{};
+        size_t mEvictions{};
+    };
+}
+#endif
@@ -0,0 +1,41 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGUI_GLYPHRUN_H
+#define AEONGUI_GLYPHRUN_H
+#include <string>
+#include "aeongui/Platform.h"
+
+namespace AeonGUI
+{
+    /** Base class for cached glyph runs,
+     *  a run is shaped text laid out from a pen position with a single font and size. */
+    class GlyphRun
+    {
+    public:
+        /** Shapes UTF-8 text into glyph ids and positions.
+         *  @param aText UTF-8 text to shape.
+         *  @param aFontFamily Font family name.
+         *  @param aFontSize Font size in user units.
+         *  @param aBold Whether to use the bold weight of the family.
+         *  @param aX Pen x position for the first glyph.
+         *  @param aY Baseline y position. */
+        virtual void Construct ( const std::string& aText, const std::string& aFontFamily, double aFontSize, bool aBold, double aX, double aY ) = 0;
+        /** @return Horizontal pen advance of the whole run. */
+        virtual double GetAdvance() const = 0;
+        DLL virtual ~GlyphRun() = 0;
+    };
+}
+#endif
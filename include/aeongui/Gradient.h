@@ -0,0 +1,61 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGUI_GRADIENT_H
+#define AEONGUI_GRADIENT_H
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "aeongui/Platform.h"
+#include "aeongui/Color.h"
+
+namespace AeonGUI
+{
+    /** A single gradient color stop, offset is normalized to [0,1]
+     *  and stop-opacity is already folded into the color alpha. */
+    struct ColorStop
+    {
+        double offset;
+        Color color;
+        bool operator== ( const ColorStop& aColorStop ) const
+        {
+            return offset == aColorStop.offset && color.bgra == aColorStop.color.bgra;
+        }
+    };
+
+    /** Base class for cached gradient paint server data. */
+    class Gradient
+    {
+    public:
+        /// Coordinate system for the gradient vector (gradientUnits).
+        enum Units
+        {
+            OBJECT_BOUNDING_BOX,
+            USER_SPACE_ON_USE
+        };
+        /// What happens past the gradient vector ends (spreadMethod).
+        enum Spread
+        {
+            PAD,
+            REFLECT,
+            REPEAT
+        };
+        virtual void ConstructLinear ( double x1, double y1, double x2, double y2, const std::vector<ColorStop>& aStops, Units aUnits, Spread aSpread ) = 0;
+        virtual void ConstructRadial ( double cx, double cy, double r, double fx, double fy, const std::vector<ColorStop>& aStops, Units aUnits, Spread aSpread ) = 0;
+        virtual Units GetUnits() const = 0;
+        DLL virtual ~Gradient() = 0;
+    };
+}
+#endif
@@ -17,12 +17,74 @@ limitations under the License.
 #define AEONGUI_JAVASCRIPT_H
 #include "aeongui/Platform.h"
 #include <string>
+#include <chrono>
+#include <cstddef>
 namespace AeonGUI
 {
+    /** Script engine counters, times are totals since the engine was created.
+     *  Heap and collector figures come from the engine's heap, with V8 that is an isolate
+     *  shared by every window on the same thread, so they include the other windows' scripts. */
+    struct ScriptStatistics
+    {
+        std::chrono::nanoseconds compile_time{};    ///< Turning source into code, cache loads included.
+        std::chrono::nanoseconds execute_time{};    ///< Running scripts and animation frame callbacks, collections included.
+        size_t heap_used{};                         ///< Bytes of live script heap.
+        size_t heap_limit{};                        ///< Heap size the engine gives up at, zero if it has none.
+        size_t gc_count{};                          ///< Garbage collections so far.
+        std::chrono::nanoseconds gc_pause_time{};   ///< Time scripts were stopped for collections.
+        std::chrono::nanoseconds gc_longest_pause{};
+    };
+
     class JavaScript
     {
     public:
         virtual void Eval ( const std::string& aString ) = 0;
+        /** Evaluates document script source.
+         *  Documents carry the same scripts across sessions,
+         *  so engines may keep compiled code for them between runs. */
+        virtual void EvalScript ( const std::string& aString )
+        {
+            Eval ( aString );
+        }
+        /** @return true if scripts are waiting on requestAnimationFrame. */
+        virtual bool HasAnimationFrameCallbacks() const
+        {
+            return false;
+        }
+        /** Runs the callbacks scripts registered with requestAnimationFrame.
+         *  Callbacks registered while these run wait for the next frame.
+         *  @param aTimestamp Frame time in milliseconds, passed to every callback.
+         *  @param aDeadline Callbacks not started by this time are kept for the next frame.
+         *  @return false if the deadline cut the frame short. */
+        virtual bool RunAnimationFrameCallbacks ( double aTimestamp, std::chrono::steady_clock::time_point aDeadline )
+        {
+            return true;
+        }
+        /** Runs document calls made by scripts on another thread,
+         *  called on the document thread between frames. */
+        virtual void ProcessCommands()
+        {
+        }
+        /** @return true if scripts on another thread are waiting on ProcessCommands. */
+        virtual bool HasPendingCommands() const
+        {
+            return false;
+        }
+        /** @return The engine counters as of the last script that returned. */
+        virtual ScriptStatistics GetStatistics() const
+        {
+            return ScriptStatistics{};
+        }
+        /** Lets the engine collect garbage while the host has nothing to draw,
+         *  so collections land between frames instead of in the middle of one.
+         *  Engines on another thread wait for their collection until aDeadline at most.
+         *  @param aDeadline Time the host needs the thread back by.
+         *  @return true if there is no garbage left worth collecting now,
+         *  false as well if the collection did not finish by aDeadline. */
+        virtual bool CollectGarbage ( std::chrono::steady_clock::time_point aDeadline )
+        {
+            return true;
+        }
         DLL virtual ~JavaScript() = 0;
     };
 }
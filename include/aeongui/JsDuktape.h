@@ -0,0 +1,76 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGUI_JSDUKTAPE_H
+#define AEONGUI_JSDUKTAPE_H
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "aeongui/Platform.h"
+#include "aeongui/JavaScript.h"
+#include "duktape.h"
+
+namespace AeonGUI
+{
+    class Window;
+    class Document;
+    class Element;
+    class DOMBridge;
+
+    /** Duktape script engine for a single window.
+     *  A small interpreter for targets where V8's size and startup time don't fit,
+     *  it exposes the same window, console and document bindings.
+     *  Each instance owns a heap of its own and runs on the window thread. */
+    class JsDuktape : public JavaScript
+    {
+    public:
+        JsDuktape ( Window* aWindow, Document* aDocument );
+        ~JsDuktape() final;
+        void Eval ( const std::string& aString ) final;
+        bool HasAnimationFrameCallbacks() const final;
+        bool RunAnimationFrameCallbacks ( double aTimestamp, std::chrono::steady_clock::time_point aDeadline ) final;
+        /** Backs requestAnimationFrame, takes the function on top of the stack.
+         *  @return Handle for CancelAnimationFrame, never zero. */
+        uint32_t RequestAnimationFrame();
+        /** Backs cancelAnimationFrame, unknown handles are ignored. */
+        void CancelAnimationFrame ( uint32_t aHandle );
+        /** Pushes the script object for aElement, wrappers are created once and kept for the heap's lifetime.
+         *  Unlike V8, where unreachable wrappers are collected, every element a script ever touched
+         *  keeps a stash entry until the window goes away, so documents that create and drop many
+         *  elements from script grow the heap without bound. */
+        void PushObject ( Element* aElement );
+        DOMBridge* GetDOMBridge() const;
+        /** Heap use is counted by the engine's own allocator and there is no heap limit.
+         *  Duktape frees most garbage by reference counting and runs its cycle collector
+         *  without telling the host, so the collector figures cover CollectGarbage calls only. */
+        ScriptStatistics GetStatistics() const final;
+        /** Runs a full collection if the deadline has not passed yet,
+         *  Duktape collections can't be split so one always runs to completion. */
+        bool CollectGarbage ( std::chrono::steady_clock::time_point aDeadline ) final;
+    private:
+        /// Heap memory functions, each block carries its size so frees can be subtracted.
+        static void* Allocate ( void* aUserData, duk_size_t aSize );
+        static void* Reallocate ( void* aUserData, void* aPointer, duk_size_t aSize );
+        static void Free ( void* aUserData, void* aPointer );
+        std::unique_ptr<DOMBridge> mDOMBridge;
+        /// Ahead of the heap, which allocates through it on creation.
+        ScriptStatistics mStatistics{};
+        duk_context* mContext{};
+        /// Handles of the callbacks for the next frame in registration order, the functions live in the heap stash.
+        std::vector<uint32_t> mAnimationFrameHandles{};
+        uint32_t mNextAnimationFrameHandle{1};
+    };
+}
+#endif
@@ -15,6 +15,9 @@ limitations under the License.
 */
 #ifndef AEONGUI_V8_H
 #define AEONGUI_V8_H
+#include <vector>
+#include <memory>
+#include <unordered_map>
 #include "aeongui/Platform.h"
 #include "aeongui/JavaScript.h"
 #include "v8-platform.h"
@@ -22,29 +25,96 @@ limitations under the License.
 
 namespace AeonGUI
 {
-    class Node;
+    class Element;
     class Window;
     class Document;
+    class DOMBridge;
 
-    struct IsolateDeleter
+    /** Isolates are shared by every V8 instance created on the same thread,
+     *  the last instance to go away disposes it. */
+    using IsolatePtr = std::shared_ptr<v8::Isolate>;
+
+    /** Compiled code cache counters, shared by every V8 instance. */
+    struct V8CodeCacheStatistics
     {
-        void operator() ( std::unique_ptr<v8::Isolate>::pointer p )
-        {
-            p->Dispose();
-        }
+        size_t hits;       ///< Scripts compiled from a cached blob.
+        size_t misses;     ///< Scripts with no cached blob on disk.
+        size_t rejections; ///< Cached blobs V8 refused, the script was compiled from source.
     };
-    using IsolatePtr =  std::unique_ptr<v8::Isolate, IsolateDeleter>;
 
+    /** DOM wrapper counters, shared by every V8 instance.
+     *  A live count that keeps growing while created and collected stay apart points at leaked wrappers. */
+    struct V8WrapperStatistics
+    {
+        size_t live;      ///< Wrappers currently cached.
+        size_t created;   ///< Wrappers created so far.
+        size_t collected; ///< Wrappers released by the garbage collector.
+    };
+
+    /** V8 script engine for a single window.
+     *  Each instance runs its document in its own context on a shared isolate,
+     *  contexts keep separate globals and security tokens so documents can't reach each other. */
     class V8 : public JavaScript
     {
     public:
+        /** Creates an engine that works on aDocument directly. */
         V8 ( Window* aWindow, Document* aDocument );
+        /** Creates an engine whose scripts reach the document through aDOMBridge. */
+        V8 ( Window* aWindow, DOMBridge& aDOMBridge );
         ~V8() final;
         void Eval ( const std::string& aString ) final;
-        void CreateObject ( Node* aNode );
+        /** Compiles through the on disk code cache,
+         *  the cache directory is AEONGUI_CACHE_DIR or the user cache directory. */
+        void EvalScript ( const std::string& aString ) final;
+        DLL static V8CodeCacheStatistics GetCodeCacheStatistics();
+        /** Returns the script object for aElement, call with the engine context entered.
+         *  Wrappers are created on first use and cached until the garbage collector
+         *  finds scripts no longer hold them, so an element keeps its identity for as long as scripts can tell.
+         *  The element is never dereferenced, so scripts on a worker thread can wrap document thread elements. */
+        v8::Local<v8::Object> CreateObject ( Element* aElement );
+        DLL static V8WrapperStatistics GetWrapperStatistics();
+        bool HasAnimationFrameCallbacks() const final;
+        bool RunAnimationFrameCallbacks ( double aTimestamp, std::chrono::steady_clock::time_point aDeadline ) final;
+        /** Backs requestAnimationFrame.
+         *  @return Handle for CancelAnimationFrame, never zero. */
+        uint32_t RequestAnimationFrame ( v8::Local<v8::Function> aCallback );
+        /** Backs cancelAnimationFrame, unknown handles are ignored. */
+        void CancelAnimationFrame ( uint32_t aHandle );
+        DOMBridge* GetDOMBridge() const;
+        /** @return The isolate this engine shares with the other engines on its thread. */
+        v8::Isolate* GetIsolate() const;
+        /** Compile and execute times are this engine's own,
+         *  heap and collector figures belong to the isolate it shares with the other engines on its thread. */
+        ScriptStatistics GetStatistics() const final;
+        /** Hands the isolate the idle time as a V8 idle notification. */
+        bool CollectGarbage ( std::chrono::steady_clock::time_point aDeadline ) final;
     private:
+        void CreateContext ( Window* aWindow );
+        struct Wrapper
+        {
+            V8* engine;
+            const Element* element;
+            v8::Global<v8::Object> object;
+        };
+        static void OnWrapperCollected ( const v8::WeakCallbackInfo<Wrapper>& aInfo );
+        struct AnimationFrameCallback
+        {
+            uint32_t handle;
+            v8::Global<v8::Function> callback;
+        };
+        std::unique_ptr<DOMBridge> mOwnedDOMBridge{};
+        DOMBridge* mDOMBridge{};
         IsolatePtr mIsolate{};
         v8::Persistent<v8::Context> mGlobalContext{};
+        /// Callbacks for the next frame, in registration order.
+        std::vector<AnimationFrameCallback> mAnimationFrameCallbacks{};
+        /// Callbacks of the frame being run, cancelling one empties its callback.
+        std::vector<AnimationFrameCallback> mRunningAnimationFrameCallbacks{};
+        uint32_t mNextAnimationFrameHandle{1};
+        std::chrono::nanoseconds mCompileTime{};
+        std::chrono::nanoseconds mExecuteTime{};
+        /// Wrappers are heap allocated so weak callbacks can hold on to them.
+        std::unordered_map<const Element*, std::unique_ptr<Wrapper>> mWrappers{};
     };
 }
 #endif
@@ -0,0 +1,103 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGUI_JSV8WORKER_H
+#define AEONGUI_JSV8WORKER_H
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "aeongui/Platform.h"
+#include "aeongui/JavaScript.h"
+#include "aeongui/CommandQueue.h"
+
+namespace v8
+{
+    class Isolate;
+}
+
+namespace AeonGUI
+{
+    class V8;
+    class Window;
+    class Document;
+    class QueuedDOMBridge;
+
+    /** V8 script engine running on its own thread.
+     *
+     *  Scripts are evaluated and animation frame callbacks run on a worker thread with its own isolate,
+     *  calls made from the window thread post work to it and return at once.
+     *  Document calls from scripts come back through a lock free queue
+     *  that the window thread runs between frames with ProcessCommands,
+     *  reads block the script until then so script heavy documents no longer hold up drawing.
+     *  Destruction terminates the script currently running, if any, and drops the ones still queued. */
+    class V8Worker : public JavaScript
+    {
+    public:
+        V8Worker ( Window* aWindow, Document* aDocument );
+        ~V8Worker() final;
+        void Eval ( const std::string& aString ) final;
+        void EvalScript ( const std::string& aString ) final;
+        bool HasAnimationFrameCallbacks() const final;
+        /** Posts the frame to the worker and returns without waiting for it.
+         *  The budget left until aDeadline applies from the moment the worker starts the frame.
+         *  @return false if the previous frame is still running, in which case the new one is dropped,
+         *  or if the deadline cut the previous frame short. */
+        bool RunAnimationFrameCallbacks ( double aTimestamp, std::chrono::steady_clock::time_point aDeadline ) final;
+        void ProcessCommands() final;
+        /** @return true while document calls are queued or any posted script has yet to finish,
+         *  a running script may read the document at any moment and then waits on ProcessCommands. */
+        bool HasPendingCommands() const final;
+        /** @return The worker engine counters as of the last task it finished. */
+        ScriptStatistics GetStatistics() const final;
+        /** Posts the idle time to the worker unless a frame is running there,
+         *  and waits until aDeadline at most for the collection to finish.
+         *  @return The result of the collection, false if it was not run or did not finish in time. */
+        bool CollectGarbage ( std::chrono::steady_clock::time_point aDeadline ) final;
+    private:
+        using Task = std::function<void ( V8& ) >;
+        struct PostedTask
+        {
+            Task run;
+            /// Scripts may read the document while the task runs, see HasPendingCommands.
+            bool scripted;
+        };
+        void Wake();
+        void Post ( Task&& aTask, bool aScripted = true );
+        void Run ( Window* aWindow );
+        std::unique_ptr<QueuedDOMBridge> mDOMBridge;
+        CommandQueue<PostedTask> mTasks{};
+        /// Bumped on every post, the worker sleeps on it while the task queue is empty.
+        std::atomic<uint32_t> mTaskSignal{};
+        /// Scripted tasks posted and not finished yet, including the one running.
+        std::atomic<uint32_t> mOutstandingScripts{};
+        std::atomic<bool> mHasAnimationFrameCallbacks{};
+        std::atomic<bool> mFrameInFlight{};
+        std::atomic<bool> mFrameCutShort{};
+        std::atomic<bool> mStopping{};
+        std::atomic<bool> mFinished{};
+        /// Worker isolate while its engine is alive, the window thread only uses it to terminate scripts.
+        v8::Isolate* mIsolate{};
+        std::mutex mIsolateMutex{};
+        /// Copied out after every task so the window thread never touches the worker isolate.
+        ScriptStatistics mStatistics{};
+        mutable std::mutex mStatisticsMutex{};
+        /// Last member so the worker starts with everything else constructed.
+        std::thread mThread;
+    };
+}
+#endif
@@ -0,0 +1,50 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGUI_MAPPEDFILE_H
+#define AEONGUI_MAPPEDFILE_H
+#include <cstdint>
+#include <cstddef>
+#include "aeongui/Platform.h"
+
+namespace AeonGUI
+{
+    /** Read only memory mapping of a whole file.
+     *  Pages are brought in by the OS as they are touched,
+     *  so decoders can stream from the mapping without an intermediate copy. */
+    class MappedFile
+    {
+    public:
+        DLL MappedFile();
+        DLL ~MappedFile();
+        MappedFile ( const MappedFile& ) = delete;
+        MappedFile& operator= ( const MappedFile& ) = delete;
+        /** Maps a file, closing any previous mapping.
+         *  @param aFilename Path to the file to map.
+         *  @return true on success, false if the file could not be opened or is empty. */
+        DLL bool Open ( const char* aFilename );
+        DLL void Close();
+        DLL const uint8_t* GetData() const;
+        DLL size_t GetSize() const;
+    private:
+        const uint8_t* mData{};
+        size_t mSize{};
+#ifdef _WIN32
+        void* mFile{};
+        void* mMapping{};
+#endif
+    };
+}
+#endif
@@ -0,0 +1,62 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGUI_PIXELCONVERSION_H
+#define AEONGUI_PIXELCONVERSION_H
+#include <cstdint>
+#include <cstddef>
+#include "aeongui/Platform.h"
+#include "aeongui/Color.h"
+
+namespace AeonGUI
+{
+    /// Component order of packed 8 bit per component source pixels.
+    enum class PixelFormat
+    {
+        RGB,
+        BGR,
+        RGBA,
+        BGRA
+    };
+
+    /*! \brief Converts a row of packed pixels into the internal Color (BGRA) layout.
+        Uses SSSE3, AVX2 or NEON kernels when the running processor supports them.
+        \param aFormat Source pixel format.
+        \param aSource Pointer to the first source pixel.
+        \param aDestination Pointer to the first destination pixel.
+        \param aCount Number of pixels to convert.
+    */
+    DLL void ConvertPixelRow ( PixelFormat aFormat, const uint8_t* aSource, Color* aDestination, size_t aCount );
+
+    /*! \brief Converts a rectangle of packed pixels into the internal Color (BGRA) layout.
+        Pitches allow converting a sub rectangle, such as the inside of a 9 patch frame.
+        \param aFormat Source pixel format.
+        \param aSource Pointer to the first source pixel.
+        \param aSourcePitch Distance in bytes between source rows.
+        \param aDestination Pointer to the first destination pixel.
+        \param aDestinationPitch Distance in bytes between destination rows.
+        \param aWidth Number of pixels per row to convert.
+        \param aHeight Number of rows to convert.
+    */
+    DLL void ConvertPixels ( PixelFormat aFormat, const uint8_t* aSource, size_t aSourcePitch, Color* aDestination, size_t aDestinationPitch, uint32_t aWidth, uint32_t aHeight );
+
+    /*! \brief Converts a row with the kernels for a given instruction set instead of the detected one.
+        Lets tests run every kernel the processor supports against the scalar one on the same input.
+        \param aFeatures CPU_AVX2, CPU_SSSE3 or CPU_NEON, zero selects the scalar kernels.
+        \return false, converting nothing, if this build or the running processor lacks aFeatures.
+    */
+    DLL bool ConvertPixelRowWith ( uint32_t aFeatures, PixelFormat aFormat, const uint8_t* aSource, Color* aDestination, size_t aCount );
+}
+#endif
@@ -0,0 +1,88 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGUI_RESAMPLER_H
+#define AEONGUI_RESAMPLER_H
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "aeongui/Platform.h"
+#include "aeongui/Color.h"
+
+typedef struct _cairo_surface cairo_surface_t;
+
+namespace AeonGUI
+{
+    /// Reconstruction filters, in increasing order of cost and sharpness.
+    enum class ResampleFilter
+    {
+        BOX,
+        BILINEAR,
+        BICUBIC,
+        LANCZOS3
+    };
+
+    /*! \brief Separable image resampler.
+        Weight tables for both axes are computed once on construction,
+        so scaling many images between the same sizes only pays for the passes.
+        Components are filtered independently, premultiplied input avoids dark fringes
+        around transparent pixels.
+    */
+    class Resampler
+    {
+    public:
+        DLL Resampler ( uint32_t aSourceWidth, uint32_t aSourceHeight, uint32_t aDestinationWidth, uint32_t aDestinationHeight, ResampleFilter aFilter );
+        /*! \brief Scales a bitmap, such as the one returned by Image::GetBitmap.
+            \param aSourcePitch Distance in bytes between source rows.
+            \param aDestinationPitch Distance in bytes between destination rows.
+            \param aThreads Number of threads to split rows across, 0 uses one per hardware thread.
+        */
+        DLL void Resample ( const Color* aSource, size_t aSourcePitch, Color* aDestination, size_t aDestinationPitch, uint32_t aThreads = 1 ) const;
+        DLL uint32_t GetSourceWidth() const;
+        DLL uint32_t GetSourceHeight() const;
+        DLL uint32_t GetDestinationWidth() const;
+        DLL uint32_t GetDestinationHeight() const;
+    private:
+        /// Per output sample, the first input sample and its fixed point weights.
+        struct WeightTable
+        {
+            uint32_t taps{};
+            std::vector<uint32_t> first{};
+            std::vector<int16_t> weights{};
+        };
+        static WeightTable BuildWeightTable ( uint32_t aSourceSize, uint32_t aDestinationSize, ResampleFilter aFilter );
+        uint32_t mSourceWidth{};
+        uint32_t mSourceHeight{};
+        uint32_t mDestinationWidth{};
+        uint32_t mDestinationHeight{};
+        WeightTable mHorizontal{};
+        WeightTable mVertical{};
+    };
+
+    /*! \brief Returns a scaled copy of a cairo image surface.
+        Cairo ARGB32 surfaces are premultiplied BGRA, which is the layout Resampler expects.
+        \return A new surface the caller owns, or nullptr if the source is not an ARGB32 or RGB24 image surface.
+    */
+    DLL cairo_surface_t* ResampleSurface ( cairo_surface_t* aSurface, uint32_t aWidth, uint32_t aHeight, ResampleFilter aFilter, uint32_t aThreads = 1 );
+
+    /*! \brief Halves a bitmap with a 2x2 box filter, one step of a mip chain.
+        The destination is max(1, width / 2) by max(1, height / 2),
+        an odd last row or column is dropped and a single row or column is averaged with itself.
+        \param aSourcePitch Distance in bytes between source rows.
+        \param aDestinationPitch Distance in bytes between destination rows.
+    */
+    DLL void HalveBitmap ( const Color* aSource, size_t aSourcePitch, uint32_t aSourceWidth, uint32_t aSourceHeight, Color* aDestination, size_t aDestinationPitch );
+}
+#endif
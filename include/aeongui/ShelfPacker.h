@@ -0,0 +1,80 @@
+/*
+Copyright (C) 2020 Rodrigo Jose Hernandez Cordoba
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#ifndef AEONGUI_SHELFPACKER_H
+#define AEONGUI_SHELFPACKER_H
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "aeongui/Platform.h"
+#include "aeongui/Rect.h"
+
+namespace AeonGUI
+{
+    /*! \brief Shelf rectangle packer that supports removal.
+        Rectangles are placed left to right on horizontal shelves of similar height,
+        removed rectangles give their span back to the shelf so caches can evict
+        individual entries and reuse the space without repacking.
+        AtlasPacker packs tighter but its skyline can not give space back, so it is
+        meant for atlases built once, this packer for caches such as GlyphCache.
+    */
+    class ShelfPacker
+    {
+    public:
+        /*! \brief Constructs an empty packer.
+            \param aWidth Width of the area to pack into.
+            \param aHeight Height of the area to pack into.
+            \param aPadding Empty pixels kept to the right and below each rectangle.
+        */
+        DLL ShelfPacker ( uint32_t aWidth, uint32_t aHeight, uint32_t aPadding = 1 );
+        /*! \brief Finds room for a rectangle.
+            \param aWidth Rectangle width, without padding.
+            \param aHeight Rectangle height, without padding.
+            \param aRect [out] Placed rectangle, without padding.
+            \return false if the rectangle does not fit.
+        */
+        DLL bool Insert ( uint32_t aWidth, uint32_t aHeight, Rect& aRect );
+        /*! \brief Gives back the space of a rectangle returned by Insert. */
+        DLL void Remove ( const Rect& aRect );
+        /// Forgets all placed rectangles.
+        DLL void Reset();
+        DLL uint32_t GetWidth() const;
+        DLL uint32_t GetHeight() const;
+        DLL uint32_t GetPadding() const;
+        /// Fraction of the area covered by placed rectangles, padding included.
+        DLL double GetOccupancy() const;
+    private:
+        struct Span
+        {
+            uint32_t x;
+            uint32_t width;
+        };
+        struct Shelf
+        {
+            uint32_t y;
+            uint32_t height;
+            uint32_t used;
+            std::vector<Span> free;
+        };
+        bool Allocate ( Shelf& aShelf, uint32_t aWidth, uint32_t& aX );
+        uint32_t mWidth{};
+        uint32_t mHeight{};
+        uint32_t mPadding{};
+        uint32_t mTop{};
+        uint64_t mUsedArea{};
+        std::vector<Shelf> mShelves{};
+    };
+}
+#endif
@@ -20,30 +20,85 @@ limitations under the License.
 #include <memory>
 #include <algorithm>
 #include <string>
+#include <chrono>
 #include "aeongui/Document.h"
 #include "aeongui/Platform.h"
-///@todo Canvas and JavaScript implementations should be selectable.
+///@todo Canvas implementations should be selectable.
 #include "aeongui/CairoCanvas.h"
-#include "aeongui/JsV8.h"
+#include "aeongui/JavaScript.h"
 
 namespace AeonGUI
 {
+    /// Engine a window runs its document scripts on.
+    enum class ScriptEngine
+    {
+        Default, ///< V8 if the library is built with it, Duktape otherwise.
+        V8,      ///< Requires USE_V8.
+        Duktape  ///< Requires USE_DUKTAPE, runs on the window thread only.
+    };
+
+    /// Where a window runs its document scripts.
+    enum class ScriptThread
+    {
+        Shared,   ///< On the window thread, on the isolate shared by its windows.
+        Dedicated ///< On a worker thread of its own, see V8Worker.
+    };
+
+    /// Cost of the last frame a window drew.
+    struct FrameStatistics
+    {
+        std::chrono::nanoseconds script_time{};   ///< Running animation frame callbacks.
+        std::chrono::nanoseconds draw_time{};     ///< Applying document changes and painting.
+        /// Collections that finished during the frame, zero unless script statistics are sampled.
+        size_t gc_count{};
+        std::chrono::nanoseconds gc_pause_time{}; ///< Time those collections stopped scripts.
+        ScriptStatistics script{};                ///< Engine totals at the end of the frame, if sampled.
+    };
+
     class Window
     {
     public:
         DLL Window ();
-        DLL Window ( const std::string aFilename, uint32_t aWidth, uint32_t aHeight );
+        /** @throw std::runtime_error if the requested script engine or thread is not available in this build. */
+        DLL Window ( const std::string aFilename, uint32_t aWidth, uint32_t aHeight,
+                     ScriptThread aScriptThread = ScriptThread::Shared, ScriptEngine aScriptEngine = ScriptEngine::Default );
         DLL ~Window ();
         DLL void ResizeViewport ( uint32_t aWidth, uint32_t aHeight );
         DLL const uint8_t* GetPixels() const;
         DLL size_t GetWidth() const;
         DLL size_t GetHeight() const;
         DLL size_t GetStride() const;
+        /** Runs due requestAnimationFrame callbacks, applies pending changes and redraws. */
         DLL void Draw();
+        /** @return true if the next Draw would change the pixels or a script thread is still busy,
+         *  hosts may stop drawing and wait for input while it is false. */
+        DLL bool NeedsFrame() const;
+        /** Sets how long animation frame callbacks may run each frame,
+         *  callbacks not started in time are deferred to the next frame. */
+        DLL void SetAnimationFrameBudget ( std::chrono::microseconds aBudget );
+        /** @return Number of frames whose callbacks went over budget. */
+        DLL size_t GetAnimationFrameOverruns() const;
+        /** Makes Draw read the script engine counters at the end of every frame.
+         *  Off by default, reading V8 heap figures is cheap but not free. */
+        DLL void SetScriptStatisticsSampling ( bool aEnabled );
+        /** With a dedicated script thread, script figures lag behind by the frames still running there. */
+        DLL const FrameStatistics& GetFrameStatistics() const;
+        /** Gives the script engine idle time to collect garbage,
+         *  hosts call it between frames, when NeedsFrame is false or a frame finished early.
+         *  Collections run here are left out of the next frame's statistics.
+         *  @return true if there is no garbage left worth collecting now. */
+        DLL bool CollectGarbage ( std::chrono::steady_clock::time_point aDeadline );
     private:
         Document mDocument{};
-        V8 mJavaScript{this, &mDocument};
+        std::unique_ptr<JavaScript> mJavaScript{};
         CairoCanvas mCanvas{};
+        /// Origin of the timestamps passed to animation frame callbacks.
+        std::chrono::steady_clock::time_point mTimeOrigin{std::chrono::steady_clock::now() };
+        std::chrono::microseconds mAnimationFrameBudget{8000};
+        size_t mAnimationFrameOverruns{};
+        FrameStatistics mFrameStatistics{};
+        bool mSampleScriptStatistics{};
+        bool mDirty{true};
     };
 }
 #endif